@@ -0,0 +1,98 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <memory>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "ouzel.h"
+#include "BenchmarkEngine.h"
+
+using namespace ouzel;
+
+static std::shared_ptr<scene::Animator> createAnimator(uint32_t index)
+{
+    // long enough to keep running for the whole benchmark
+    const float length = 1000000.0f;
+
+    switch (index % 4)
+    {
+        case 0: return std::make_shared<scene::Move>(length, Vector2(100.0f, 100.0f), true);
+        case 1: return std::make_shared<scene::Rotate>(length, TAU, true);
+        case 2: return std::make_shared<scene::Scale>(length, Vector2(2.0f, 2.0f), false);
+        default: return std::make_shared<scene::Fade>(length, 0.0f, false);
+    }
+}
+
+// one update of all running animators (a mix of move, rotate, scale and fade), the argument is the number of animators
+static void animatorUpdate(benchmark::State& state)
+{
+    BenchmarkEngine engine;
+    Settings settings;
+    settings.driver = graphics::Renderer::Driver::NONE;
+    engine.init(settings, []() {});
+
+    std::vector<scene::NodePtr> nodes;
+    std::vector<std::shared_ptr<scene::Animator>> animators;
+
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        scene::NodePtr node = std::make_shared<scene::Node>();
+        std::shared_ptr<scene::Animator> animator = createAnimator(static_cast<uint32_t>(i));
+        animator->start(node);
+
+        nodes.push_back(node);
+        animators.push_back(animator);
+    }
+
+    for (auto _ : state)
+    {
+        engine.runUpdateCallbacks(1.0f / 60.0f);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(animatorUpdate)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+// stopping and starting every animator once, the argument is the number of animators
+static void animatorStartStop(benchmark::State& state)
+{
+    BenchmarkEngine engine;
+    Settings settings;
+    settings.driver = graphics::Renderer::Driver::NONE;
+    engine.init(settings, []() {});
+
+    std::vector<scene::NodePtr> nodes;
+    std::vector<std::shared_ptr<scene::Animator>> animators;
+
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        scene::NodePtr node = std::make_shared<scene::Node>();
+        std::shared_ptr<scene::Animator> animator = createAnimator(static_cast<uint32_t>(i));
+        animator->start(node);
+
+        nodes.push_back(node);
+        animators.push_back(animator);
+    }
+
+    for (auto _ : state)
+    {
+        // removed from the middle of the array in a different order than added
+        for (size_t i = 0; i < animators.size(); i += 2)
+        {
+            animators[i]->stop();
+        }
+
+        for (size_t i = 1; i < animators.size(); i += 2)
+        {
+            animators[i]->stop();
+        }
+
+        for (const std::shared_ptr<scene::Animator>& animator : animators)
+        {
+            animator->resume();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(animatorStartStop)->Arg(1000)->Arg(100000)->Unit(benchmark::kMicrosecond);
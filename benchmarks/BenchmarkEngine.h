@@ -0,0 +1,13 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include "core/Engine.h"
+
+// exposes the update step of the engine, which is otherwise only called by the update thread
+class BenchmarkEngine: public ouzel::Engine
+{
+public:
+    using ouzel::Engine::runUpdateCallbacks;
+};
@@ -0,0 +1,132 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "ouzel.h"
+
+using namespace ouzel;
+
+static const int64_t EVENTS_PER_UPDATE = 64;
+
+// dispatch of key events to all keyboard handlers, the argument is the number of handlers
+static void eventDispatch(benchmark::State& state)
+{
+    Engine engine;
+    Settings settings;
+    settings.driver = graphics::Renderer::Driver::NONE;
+    engine.init(settings, []() {});
+
+    const EventDispatcherPtr& eventDispatcher = engine.getEventDispatcher();
+
+    std::vector<std::unique_ptr<EventHandler>> eventHandlers;
+    uint64_t handledCount = 0;
+
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        std::unique_ptr<EventHandler> eventHandler(new EventHandler());
+        eventHandler->keyboardHandler = [&handledCount](Event::Type, const KeyboardEvent&) {
+            ++handledCount;
+            return true;
+        };
+
+        eventDispatcher->addEventHandler(*eventHandler);
+        eventHandlers.push_back(std::move(eventHandler));
+    }
+
+    Event event;
+    event.type = Event::Type::KEY_DOWN;
+    event.keyboardEvent.key = input::KeyboardKey::SPACE;
+
+    for (auto _ : state)
+    {
+        for (int64_t i = 0; i < EVENTS_PER_UPDATE; ++i)
+        {
+            eventDispatcher->dispatchEvent(event);
+        }
+
+        eventDispatcher->update();
+    }
+
+    benchmark::DoNotOptimize(handledCount);
+
+    for (const std::unique_ptr<EventHandler>& eventHandler : eventHandlers)
+    {
+        eventDispatcher->removeEventHandler(*eventHandler);
+    }
+
+    state.SetItemsProcessed(state.iterations() * EVENTS_PER_UPDATE);
+    state.counters["handlerCalls"] = benchmark::Counter(static_cast<double>(state.iterations() * EVENTS_PER_UPDATE * state.range(0)),
+                                                        benchmark::Counter::kIsRate);
+}
+BENCHMARK(eventDispatch)->Arg(0)->Arg(1)->Arg(16)->Arg(256)->Arg(4096);
+
+// producer threads dispatching key events while the game thread keeps updating, the argument is the number of producers
+static void eventDispatchContention(benchmark::State& state)
+{
+    static const uint64_t EVENTS_PER_PRODUCER = 16384;
+
+    Engine engine;
+    Settings settings;
+    settings.driver = graphics::Renderer::Driver::NONE;
+    engine.init(settings, []() {});
+
+    const EventDispatcherPtr& eventDispatcher = engine.getEventDispatcher();
+
+    uint64_t handledCount = 0;
+
+    EventHandler eventHandler;
+    eventHandler.keyboardHandler = [&handledCount](Event::Type, const KeyboardEvent&) {
+        ++handledCount;
+        return true;
+    };
+
+    eventDispatcher->addEventHandler(eventHandler);
+
+    uint64_t producerCount = static_cast<uint64_t>(state.range(0));
+    uint64_t overflowCount = eventDispatcher->getOverflowCount();
+
+    for (auto _ : state)
+    {
+        handledCount = 0;
+        std::atomic<bool> start(false);
+        std::vector<std::thread> producers;
+
+        for (uint64_t i = 0; i < producerCount; ++i)
+        {
+            producers.push_back(std::thread([&eventDispatcher, &start]() {
+                Event event;
+                event.type = Event::Type::KEY_DOWN;
+                event.keyboardEvent.key = input::KeyboardKey::SPACE;
+
+                while (!start) std::this_thread::yield();
+
+                for (uint64_t j = 0; j < EVENTS_PER_PRODUCER; ++j)
+                {
+                    eventDispatcher->dispatchEvent(event);
+                }
+            }));
+        }
+
+        start = true;
+
+        while (handledCount < producerCount * EVENTS_PER_PRODUCER)
+        {
+            eventDispatcher->update();
+        }
+
+        for (std::thread& producer : producers)
+        {
+            producer.join();
+        }
+    }
+
+    eventDispatcher->removeEventHandler(eventHandler);
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * producerCount * EVENTS_PER_PRODUCER));
+    state.counters["overflowed"] = static_cast<double>(eventDispatcher->getOverflowCount() - overflowCount) / state.iterations();
+}
+BENCHMARK(eventDispatchContention)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
@@ -0,0 +1,45 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <benchmark/benchmark.h>
+#include "ouzel.h"
+
+using namespace ouzel;
+
+// draw command generation of one layer, the first argument is the number of threads and the second one the number of nodes
+static void layerDraw(benchmark::State& state)
+{
+    Engine engine;
+    Settings settings;
+    settings.driver = graphics::Renderer::Driver::NONE;
+    settings.threadCount = static_cast<uint32_t>(state.range(0));
+    engine.init(settings, []() {});
+
+    // the empty renderer doesn't load shaders, the debug drawables don't draw anything without one
+    engine.getCache()->setShader(graphics::SHADER_COLOR, engine.getRenderer()->createShader());
+
+    scene::ScenePtr scene = std::make_shared<scene::Scene>();
+    scene::LayerPtr layer = std::make_shared<scene::Layer>();
+    scene->addLayer(layer);
+    layer->setCamera(std::make_shared<scene::Camera>());
+
+    for (int64_t i = 0; i < state.range(1); ++i)
+    {
+        scene::DebugDrawablePtr drawable = std::make_shared<scene::DebugDrawable>();
+        drawable->rectangle(Rectangle(0.0f, 0.0f, 10.0f, 10.0f), graphics::Color(255, 255, 255, 255), true);
+
+        scene::NodePtr node = std::make_shared<scene::Node>();
+        node->addDrawable(drawable);
+        node->setPosition(Vector2(static_cast<float>(i % 80) * 10.0f - 400.0f, static_cast<float>(i / 80 % 60) * 10.0f - 300.0f));
+        layer->addChild(node);
+    }
+
+    for (auto _ : state)
+    {
+        layer->draw();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+BENCHMARK(layerDraw)->ArgsProduct({{1, 2, 4, 8}, {1000, 10000}})->UseRealTime()->Unit(benchmark::kMicrosecond);
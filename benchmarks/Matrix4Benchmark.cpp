@@ -0,0 +1,225 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "math/MathUtils.h"
+#include "math/Matrix4.h"
+#include "math/Vector2.h"
+#include "math/Vector4.h"
+
+using namespace ouzel;
+
+// the scalar code of Matrix4, which is compiled out when SIMD is supported
+static bool scalarInvert(const Matrix4& matrix, Matrix4& dst)
+{
+    const float* m = matrix.m;
+
+    float a0 = m[0] * m[5] - m[1] * m[4];
+    float a1 = m[0] * m[6] - m[2] * m[4];
+    float a2 = m[0] * m[7] - m[3] * m[4];
+    float a3 = m[1] * m[6] - m[2] * m[5];
+    float a4 = m[1] * m[7] - m[3] * m[5];
+    float a5 = m[2] * m[7] - m[3] * m[6];
+    float b0 = m[8] * m[13] - m[9] * m[12];
+    float b1 = m[8] * m[14] - m[10] * m[12];
+    float b2 = m[8] * m[15] - m[11] * m[12];
+    float b3 = m[9] * m[14] - m[10] * m[13];
+    float b4 = m[9] * m[15] - m[11] * m[13];
+    float b5 = m[10] * m[15] - m[11] * m[14];
+
+    float det = a0 * b5 - a1 * b4 + a2 * b3 + a3 * b2 - a4 * b1 + a5 * b0;
+
+    if (fabs(det) <= TOLERANCE)
+    {
+        return false;
+    }
+
+    float invDet = 1.0f / det;
+
+    dst.m[0]  = (m[5] * b5 - m[6] * b4 + m[7] * b3) * invDet;
+    dst.m[1]  = (-m[1] * b5 + m[2] * b4 - m[3] * b3) * invDet;
+    dst.m[2]  = (m[13] * a5 - m[14] * a4 + m[15] * a3) * invDet;
+    dst.m[3]  = (-m[9] * a5 + m[10] * a4 - m[11] * a3) * invDet;
+    dst.m[4]  = (-m[4] * b5 + m[6] * b2 - m[7] * b1) * invDet;
+    dst.m[5]  = (m[0] * b5 - m[2] * b2 + m[3] * b1) * invDet;
+    dst.m[6]  = (-m[12] * a5 + m[14] * a2 - m[15] * a1) * invDet;
+    dst.m[7]  = (m[8] * a5 - m[10] * a2 + m[11] * a1) * invDet;
+    dst.m[8]  = (m[4] * b4 - m[5] * b2 + m[7] * b0) * invDet;
+    dst.m[9]  = (-m[0] * b4 + m[1] * b2 - m[3] * b0) * invDet;
+    dst.m[10] = (m[12] * a4 - m[13] * a2 + m[15] * a0) * invDet;
+    dst.m[11] = (-m[8] * a4 + m[9] * a2 - m[11] * a0) * invDet;
+    dst.m[12] = (-m[4] * b3 + m[5] * b1 - m[6] * b0) * invDet;
+    dst.m[13] = (m[0] * b3 - m[1] * b1 + m[2] * b0) * invDet;
+    dst.m[14] = (-m[12] * a3 + m[13] * a1 - m[14] * a0) * invDet;
+    dst.m[15] = (m[8] * a3 - m[9] * a1 + m[10] * a0) * invDet;
+
+    return true;
+}
+
+static void scalarTransformPoints(const Matrix4& matrix, const Vector2* points, Vector2* dst, uint32_t count)
+{
+    const float* m = matrix.m;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        float x = points[i].x;
+        float y = points[i].y;
+
+        dst[i].x = x * m[0] + y * m[4] + m[12];
+        dst[i].y = x * m[1] + y * m[5] + m[13];
+    }
+}
+
+static std::vector<Matrix4> randomMatrices(size_t count)
+{
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+    std::vector<Matrix4> result(count);
+
+    for (Matrix4& matrix : result)
+    {
+        for (float& value : matrix.m)
+        {
+            value = distribution(generator);
+        }
+    }
+
+    return result;
+}
+
+static std::vector<Vector2> randomPoints(size_t count)
+{
+    std::mt19937 generator(2);
+    std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+    std::vector<Vector2> result(count);
+
+    for (Vector2& point : result)
+    {
+        point.x = distribution(generator);
+        point.y = distribution(generator);
+    }
+
+    return result;
+}
+
+static void matrixInvert(benchmark::State& state)
+{
+    std::vector<Matrix4> matrices = randomMatrices(1024);
+    Matrix4 result;
+    size_t i = 0;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(matrices[i++ & 1023].invert(result));
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void matrixInvertScalar(benchmark::State& state)
+{
+    std::vector<Matrix4> matrices = randomMatrices(1024);
+    Matrix4 result;
+    size_t i = 0;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(scalarInvert(matrices[i++ & 1023], result));
+        benchmark::DoNotOptimize(result);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void matrixTransformPoints(benchmark::State& state)
+{
+    Matrix4 matrix = randomMatrices(1)[0];
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    std::vector<Vector2> points = randomPoints(count);
+    std::vector<Vector2> result(count);
+    benchmark::DoNotOptimize(result.data());
+
+    for (auto _ : state)
+    {
+        matrix.transformPoints(points.data(), result.data(), count);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+static void matrixTransformPointsScalar(benchmark::State& state)
+{
+    Matrix4 matrix = randomMatrices(1)[0];
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    std::vector<Vector2> points = randomPoints(count);
+    std::vector<Vector2> result(count);
+    benchmark::DoNotOptimize(result.data());
+
+    for (auto _ : state)
+    {
+        scalarTransformPoints(matrix, points.data(), result.data(), count);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// one point at a time, the way the bounding boxes were transformed before the batch methods
+static void matrixTransformPointsSingle(benchmark::State& state)
+{
+    Matrix4 matrix = randomMatrices(1)[0];
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    std::vector<Vector2> points = randomPoints(count);
+    std::vector<Vector2> result(count);
+    benchmark::DoNotOptimize(result.data());
+
+    for (auto _ : state)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            Vector3 point(points[i]);
+            matrix.transformPoint(point);
+            result[i] = Vector2(point.x, point.y);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+// transformVector(Vector4) per point, which is the NEON code on ARM (and SSE or scalar code elsewhere)
+static void matrixTransformPointsVector4(benchmark::State& state)
+{
+    Matrix4 matrix = randomMatrices(1)[0];
+    uint32_t count = static_cast<uint32_t>(state.range(0));
+    std::vector<Vector2> points = randomPoints(count);
+    std::vector<Vector2> result(count);
+    benchmark::DoNotOptimize(result.data());
+
+    for (auto _ : state)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            Vector4 point(points[i].x, points[i].y, 0.0f, 1.0f);
+            matrix.transformVector(point);
+            result[i] = Vector2(point.x, point.y);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+BENCHMARK(matrixInvert);
+BENCHMARK(matrixInvertScalar);
+BENCHMARK(matrixTransformPoints)->Arg(4)->Arg(1024);
+BENCHMARK(matrixTransformPointsScalar)->Arg(4)->Arg(1024);
+BENCHMARK(matrixTransformPointsSingle)->Arg(4)->Arg(1024);
+BENCHMARK(matrixTransformPointsVector4)->Arg(4)->Arg(1024);
@@ -0,0 +1,81 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <cmath>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "ouzel.h"
+
+using namespace ouzel;
+
+static const uint32_t FRAMES_PER_PROCESS = 1024;
+
+static void putUInt32(std::vector<uint8_t>& data, uint32_t value)
+{
+    for (uint32_t i = 0; i < 4; ++i) data.push_back(static_cast<uint8_t>(value >> (i * 8)));
+}
+
+static void putUInt16(std::vector<uint8_t>& data, uint16_t value)
+{
+    data.push_back(static_cast<uint8_t>(value));
+    data.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+// 16-bit PCM WAVE file with a sine wave
+static audio::SoundDataPtr createSoundData(uint16_t channels, uint32_t sampleRate, uint32_t frameCount)
+{
+    std::vector<uint8_t> data = { 'R', 'I', 'F', 'F' };
+    putUInt32(data, 36 + frameCount * channels * 2);
+    data.insert(data.end(), { 'W', 'A', 'V', 'E', 'f', 'm', 't', ' ' });
+    putUInt32(data, 16);
+    putUInt16(data, 1);
+    putUInt16(data, channels);
+    putUInt32(data, sampleRate);
+    putUInt32(data, sampleRate * channels * 2);
+    putUInt16(data, channels * 2);
+    putUInt16(data, 16);
+    data.insert(data.end(), { 'd', 'a', 't', 'a' });
+    putUInt32(data, frameCount * channels * 2);
+
+    for (uint32_t i = 0; i < frameCount * channels; ++i)
+    {
+        putUInt16(data, static_cast<uint16_t>(static_cast<int16_t>(10000.0f * sinf(i * 0.05f))));
+    }
+
+    audio::SoundDataPtr soundData = sharedEngine->getAudio()->createSoundData();
+    soundData->initFromBuffer(data);
+
+    return soundData;
+}
+
+// offline mixing of repeating mono and stereo voices with different pitches and pans, the argument is the number of voices
+static void mixerProcess(benchmark::State& state)
+{
+    Engine engine;
+    Settings settings;
+    settings.driver = graphics::Renderer::Driver::NONE;
+    engine.init(settings, []() {});
+
+    audio::SoundDataPtr mono = createSoundData(1, 22050, 22050 * 2);
+    audio::SoundDataPtr stereo = createSoundData(2, 44100, 44100 * 2);
+
+    uint32_t voiceCount = static_cast<uint32_t>(state.range(0));
+    audio::Mixer mixer(44100, voiceCount);
+
+    for (uint32_t i = 0; i < voiceCount; ++i)
+    {
+        mixer.play((i % 2) ? mono : stereo, true, 0.5f, (i % 3) ? 1.0f : 1.1f, -0.5f + (i % 5) * 0.25f);
+    }
+
+    std::vector<int16_t> output(FRAMES_PER_PROCESS * 2);
+
+    for (auto _ : state)
+    {
+        mixer.process(output.data(), FRAMES_PER_PROCESS);
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * FRAMES_PER_PROCESS);
+    state.counters["activeVoices"] = mixer.getActiveVoiceCount();
+}
+BENCHMARK(mixerProcess)->RangeMultiplier(2)->Range(16, 512);
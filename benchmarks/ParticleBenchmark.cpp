@@ -0,0 +1,240 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "ouzel.h"
+
+using namespace ouzel;
+
+// one update of all particle systems on the calling thread, the argument is the total number of particles
+static void particleUpdate(benchmark::State& state)
+{
+    Engine engine;
+    Settings settings;
+    settings.driver = graphics::Renderer::Driver::NONE;
+    engine.init(settings, []() {});
+
+    // the empty renderer doesn't load shaders or textures
+    engine.getCache()->setShader(graphics::SHADER_TEXTURE, engine.getRenderer()->createShader());
+    engine.getCache()->setTexture("particle.png", engine.getRenderer()->createTexture());
+
+    uint32_t totalCount = static_cast<uint32_t>(state.range(0));
+    uint32_t systemCount = (totalCount + 9999) / 10000;
+
+    scene::ParticleDefinitionPtr particleDefinition = std::make_shared<scene::ParticleDefinition>();
+    particleDefinition->maxParticles = totalCount / systemCount;
+    particleDefinition->particleLifespan = 10.0f;
+    particleDefinition->particleLifespanVariance = 0.0f;
+    particleDefinition->emissionRate = static_cast<float>(particleDefinition->maxParticles) / particleDefinition->particleLifespan;
+    particleDefinition->angleVariance = 180.0f;
+    particleDefinition->rotatePerSecondVariance = 90.0f;
+    particleDefinition->finishParticleSize = 16.0f;
+    particleDefinition->finishColorAlpha = 1.0f;
+    particleDefinition->textureFilename = "particle.png";
+
+    scene::ScenePtr scene = std::make_shared<scene::Scene>();
+    scene::LayerPtr layer = std::make_shared<scene::Layer>();
+    scene->addLayer(layer);
+    layer->setCamera(std::make_shared<scene::Camera>());
+
+    std::vector<scene::ParticleSystemPtr> particleSystems;
+
+    for (uint32_t i = 0; i < systemCount; ++i)
+    {
+        scene::ParticleSystemPtr particleSystem = std::make_shared<scene::ParticleSystem>(particleDefinition);
+        particleSystem->setRandomSeed(i + 1);
+        particleSystems.push_back(particleSystem);
+
+        scene::NodePtr node = std::make_shared<scene::Node>();
+        node->addDrawable(particleSystem);
+        layer->addChild(node);
+    }
+
+    // the emitter position is taken from the node the system was drawn with
+    layer->draw();
+
+    // emit until the systems are full, the particles live longer than the benchmark runs
+    for (uint32_t step = 0; step < 600; ++step)
+    {
+        for (const scene::ParticleSystemPtr& particleSystem : particleSystems)
+        {
+            particleSystem->update(1.0f / 60.0f);
+        }
+    }
+
+    for (auto _ : state)
+    {
+        for (const scene::ParticleSystemPtr& particleSystem : particleSystems)
+        {
+            particleSystem->update(1.0f / 60.0f);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * totalCount);
+}
+
+// the array of structures particle of the implementation before the structure of arrays update kernels
+struct Particle
+{
+    float life = 0.0f;
+
+    Vector2 position;
+
+    float colorRed = 0.0f;
+    float colorGreen = 0.0f;
+    float colorBlue = 0.0f;
+    float colorAlpha = 0.0f;
+
+    float deltaColorRed = 0.0f;
+    float deltaColorGreen = 0.0f;
+    float deltaColorBlue = 0.0f;
+    float deltaColorAlpha = 0.0f;
+
+    float angle = 0.0f;
+    float speed = 0.0f;
+
+    float size = 0.0f;
+    float deltaSize = 0.0f;
+
+    float rotation = 0.0f;
+    float deltaRotation = 0.0f;
+
+    float radialAcceleration = 0.0f;
+    float tangentialAcceleration = 0.0f;
+    Vector2 direction;
+    float radius = 0.0f;
+    float degreesPerSecond = 0.0f;
+    float deltaRadius = 0.0f;
+};
+
+// the previous gravity emitter update and vertex generation with cosf and sinf per particle
+static void updateParticlesArrayOfStructs(std::vector<Particle>& particles, uint32_t& particleCount,
+                                          std::vector<graphics::VertexPCT>& vertices,
+                                          const scene::ParticleDefinition& particleDefinition, float delta)
+{
+    float yCoordFlipped = particleDefinition.yCoordFlipped ? -1.0f : 1.0f;
+
+    for (uint32_t counter = particleCount; counter > 0; --counter)
+    {
+        size_t i = counter - 1;
+        particles[i].life -= delta;
+
+        if (particles[i].life >= 0.0f)
+        {
+            Vector2 tmp, radial, tangential;
+
+            if (particles[i].position.x == 0.0f || particles[i].position.y == 0.0f)
+            {
+                radial = particles[i].position;
+                radial.normalize();
+            }
+            tangential = radial;
+            radial.x *= particles[i].radialAcceleration;
+            radial.y *= particles[i].radialAcceleration;
+
+            std::swap(tangential.x, tangential.y);
+            tangential.x *= -particles[i].tangentialAcceleration;
+            tangential.y *= particles[i].tangentialAcceleration;
+
+            tmp.x = (radial.x + tangential.x + particleDefinition.gravity.x) * delta;
+            tmp.y = (radial.y + tangential.y + particleDefinition.gravity.y) * delta;
+
+            particles[i].direction.x += tmp.x;
+            particles[i].direction.y += tmp.y;
+
+            particles[i].position.x += particles[i].direction.x * delta * yCoordFlipped;
+            particles[i].position.y += particles[i].direction.y * delta * yCoordFlipped;
+
+            particles[i].colorRed += particles[i].deltaColorRed * delta;
+            particles[i].colorGreen += particles[i].deltaColorGreen * delta;
+            particles[i].colorBlue += particles[i].deltaColorBlue * delta;
+            particles[i].colorAlpha += particles[i].deltaColorAlpha * delta;
+
+            particles[i].size += particles[i].deltaSize * delta;
+            particles[i].size = std::max(0.0f, particles[i].size);
+
+            particles[i].rotation += particles[i].deltaRotation * delta;
+        }
+        else
+        {
+            particles[i] = particles[particleCount - 1];
+            --particleCount;
+        }
+    }
+
+    for (uint32_t i = 0; i < particleCount; ++i)
+    {
+        float size_2 = particles[i].size / 2.0f;
+        Vector2 v1(-size_2, -size_2);
+        Vector2 v2(size_2, size_2);
+
+        float r = -degToRad(particles[i].rotation);
+        float cr = cosf(r);
+        float sr = sinf(r);
+        Vector2 a(v1.x * cr - v1.y * sr, v1.x * sr + v1.y * cr);
+        Vector2 b(v2.x * cr - v1.y * sr, v2.x * sr + v1.y * cr);
+        Vector2 c(v2.x * cr - v2.y * sr, v2.x * sr + v2.y * cr);
+        Vector2 d(v1.x * cr - v2.y * sr, v1.x * sr + v2.y * cr);
+
+        graphics::Color color(static_cast<uint8_t>(particles[i].colorRed * 255),
+                              static_cast<uint8_t>(particles[i].colorGreen * 255),
+                              static_cast<uint8_t>(particles[i].colorBlue * 255),
+                              static_cast<uint8_t>(particles[i].colorAlpha * 255));
+
+        vertices[i * 4 + 0].position = a + particles[i].position;
+        vertices[i * 4 + 0].color = color;
+        vertices[i * 4 + 1].position = b + particles[i].position;
+        vertices[i * 4 + 1].color = color;
+        vertices[i * 4 + 2].position = d + particles[i].position;
+        vertices[i * 4 + 2].color = color;
+        vertices[i * 4 + 3].position = c + particles[i].position;
+        vertices[i * 4 + 3].color = color;
+    }
+}
+
+// the same particle count updated with the previous implementation, without the mesh buffer upload
+static void particleUpdateArrayOfStructs(benchmark::State& state)
+{
+    scene::ParticleDefinition particleDefinition;
+    particleDefinition.particleLifespan = 10.0f;
+    particleDefinition.finishParticleSize = 16.0f;
+    particleDefinition.finishColorAlpha = 1.0f;
+
+    uint32_t totalCount = static_cast<uint32_t>(state.range(0));
+    uint32_t particleCount = totalCount;
+    std::vector<Particle> particles(particleCount);
+    std::vector<graphics::VertexPCT> vertices(particleCount * 4);
+
+    Random random(1);
+
+    for (Particle& particle : particles)
+    {
+        particle.life = random.nextFloat(0.0f, particleDefinition.particleLifespan);
+        particle.position = Vector2(random.nextFloat(-100.0f, 100.0f), random.nextFloat(-100.0f, 100.0f));
+        particle.size = random.nextFloat(0.0f, 16.0f);
+        particle.deltaSize = (particleDefinition.finishParticleSize - particle.size) / particle.life;
+        particle.colorAlpha = random.nextFloat();
+        particle.deltaColorAlpha = (particleDefinition.finishColorAlpha - particle.colorAlpha) / particle.life;
+        particle.rotation = random.nextFloat(-180.0f, 180.0f);
+        particle.deltaRotation = random.nextFloat(-90.0f, 90.0f);
+        particle.direction = Vector2(random.nextFloat(-1.0f, 1.0f), random.nextFloat(-1.0f, 1.0f));
+    }
+
+    for (auto _ : state)
+    {
+        updateParticlesArrayOfStructs(particles, particleCount, vertices, particleDefinition, 1.0f / 60.0f);
+        benchmark::DoNotOptimize(vertices.data());
+
+        // revive the dead particles to keep the count steady like the emitter does
+        for (; particleCount < totalCount; ++particleCount)
+            particles[particleCount].life = particleDefinition.particleLifespan;
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(particleUpdate)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(particleUpdateArrayOfStructs)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
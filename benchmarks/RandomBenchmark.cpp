@@ -0,0 +1,77 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <mutex>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "utils/Random.h"
+#include "utils/Utils.h"
+
+using namespace ouzel;
+
+// the previous randomf, one shared generator that the particle emission had to lock
+static std::mt19937 oldEngine(1);
+static std::mutex oldMutex;
+
+static float oldRandomf(float min, float max)
+{
+    float diff = max - min;
+
+    float rand = static_cast<float>(oldEngine()) / oldEngine.max();
+
+    return rand * diff + min;
+}
+
+static void randomOldRandomf(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::lock_guard<std::mutex> lock(oldMutex);
+        benchmark::DoNotOptimize(oldRandomf(-1.0f, 1.0f));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(randomOldRandomf)->ThreadRange(1, 4)->UseRealTime();
+
+static void randomRandomf(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(randomf(-1.0f, 1.0f));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(randomRandomf)->ThreadRange(1, 4)->UseRealTime();
+
+static void randomNextFloat(benchmark::State& state)
+{
+    Random random(1);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(random.nextFloat(-1.0f, 1.0f));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(randomNextFloat);
+
+// the batch fill used by the particle emission, the argument is the number of values per call
+static void randomFillSigned(benchmark::State& state)
+{
+    Random random(1);
+    std::vector<float> values(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        random.fillSigned(values.data(), static_cast<uint32_t>(values.size()));
+        benchmark::DoNotOptimize(values.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(randomFillSigned)->Arg(16)->Arg(1024);
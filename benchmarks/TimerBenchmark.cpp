@@ -0,0 +1,134 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <memory>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "ouzel.h"
+#include "BenchmarkEngine.h"
+
+using namespace ouzel;
+
+// the timers don't expire while the benchmark runs
+static float getDelay(int64_t index)
+{
+    return 100000.0f + static_cast<float>(index % 1000) * 1000.0f;
+}
+
+// timer counting its time every frame, the way delays were done before the timer manager
+class CountingTimer
+{
+public:
+    CountingTimer(float delay): remaining(delay)
+    {
+        updateCallback.callback = [this](float delta) {
+            remaining -= delta;
+
+            if (remaining <= 0.0f)
+            {
+                sharedEngine->unscheduleUpdate(updateCallback);
+            }
+        };
+    }
+
+    ~CountingTimer()
+    {
+        sharedEngine->unscheduleUpdate(updateCallback);
+    }
+
+    float remaining;
+    UpdateCallback updateCallback;
+};
+
+// one frame with the given number of pending timers
+static void timerTick(benchmark::State& state)
+{
+    BenchmarkEngine engine;
+    Settings settings;
+    settings.driver = graphics::Renderer::Driver::NONE;
+    engine.init(settings, []() {});
+
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        engine.getTimerManager()->addTimer(getDelay(i), []() {});
+    }
+
+    for (auto _ : state)
+    {
+        engine.runUpdateCallbacks(1.0f / 60.0f);
+    }
+}
+BENCHMARK(timerTick)->Arg(1000)->Arg(100000)->Arg(1000000);
+
+static void timerTickUpdateCallbacks(benchmark::State& state)
+{
+    BenchmarkEngine engine;
+    Settings settings;
+    settings.driver = graphics::Renderer::Driver::NONE;
+    engine.init(settings, []() {});
+
+    std::vector<std::unique_ptr<CountingTimer>> timers;
+
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        timers.push_back(std::unique_ptr<CountingTimer>(new CountingTimer(getDelay(i))));
+        engine.scheduleUpdate(timers.back()->updateCallback);
+    }
+
+    for (auto _ : state)
+    {
+        engine.runUpdateCallbacks(1.0f / 60.0f);
+    }
+}
+BENCHMARK(timerTickUpdateCallbacks)->Arg(1000)->Arg(100000)->Arg(1000000);
+
+// adding and canceling one timer while the given number of timers is pending
+static void timerAddCancel(benchmark::State& state)
+{
+    BenchmarkEngine engine;
+    Settings settings;
+    settings.driver = graphics::Renderer::Driver::NONE;
+    engine.init(settings, []() {});
+
+    const TimerManagerPtr& timerManager = engine.getTimerManager();
+
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        timerManager->addTimer(getDelay(i), []() {});
+    }
+
+    int64_t index = 0;
+
+    for (auto _ : state)
+    {
+        TimerId timerId = timerManager->addTimer(getDelay(index++), []() {});
+        timerManager->cancelTimer(timerId);
+    }
+}
+BENCHMARK(timerAddCancel)->Arg(1000)->Arg(1000000);
+
+static void timerAddCancelUpdateCallbacks(benchmark::State& state)
+{
+    BenchmarkEngine engine;
+    Settings settings;
+    settings.driver = graphics::Renderer::Driver::NONE;
+    engine.init(settings, []() {});
+
+    std::vector<std::unique_ptr<CountingTimer>> timers;
+
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        timers.push_back(std::unique_ptr<CountingTimer>(new CountingTimer(getDelay(i))));
+        engine.scheduleUpdate(timers.back()->updateCallback);
+    }
+
+    int64_t index = 0;
+
+    for (auto _ : state)
+    {
+        CountingTimer timer(getDelay(index++));
+        engine.scheduleUpdate(timer.updateCallback);
+        engine.unscheduleUpdate(timer.updateCallback);
+    }
+}
+BENCHMARK(timerAddCancelUpdateCallbacks)->Arg(1000)->Arg(1000000);
@@ -14,6 +14,7 @@ LOCAL_SRC_FILES :=$(LOCAL_PATH)/../../ouzel/android/ApplicationAndroid.cpp \
     $(LOCAL_PATH)/../../ouzel/android/GamepadAndroid.cpp \
     $(LOCAL_PATH)/../../ouzel/android/InputAndroid.cpp \
     $(LOCAL_PATH)/../../ouzel/android/WindowAndroid.cpp \
+    $(LOCAL_PATH)/../../ouzel/animators/AnimationSystem.cpp \
     $(LOCAL_PATH)/../../ouzel/animators/Animator.cpp \
     $(LOCAL_PATH)/../../ouzel/animators/Ease.cpp \
     $(LOCAL_PATH)/../../ouzel/animators/Fade.cpp \
@@ -25,19 +26,25 @@ LOCAL_SRC_FILES :=$(LOCAL_PATH)/../../ouzel/android/ApplicationAndroid.cpp \
     $(LOCAL_PATH)/../../ouzel/animators/Sequence.cpp \
     $(LOCAL_PATH)/../../ouzel/animators/Shake.cpp \
     $(LOCAL_PATH)/../../ouzel/audio/Audio.cpp \
+    $(LOCAL_PATH)/../../ouzel/audio/Mixer.cpp \
     $(LOCAL_PATH)/../../ouzel/audio/Sound.cpp \
     $(LOCAL_PATH)/../../ouzel/audio/SoundData.cpp \
+    $(LOCAL_PATH)/../../ouzel/audio/SoundStream.cpp \
     $(LOCAL_PATH)/../../ouzel/core/Application.cpp \
     $(LOCAL_PATH)/../../ouzel/core/Cache.cpp \
     $(LOCAL_PATH)/../../ouzel/core/Engine.cpp \
+    $(LOCAL_PATH)/../../ouzel/core/TimerManager.cpp \
     $(LOCAL_PATH)/../../ouzel/core/Window.cpp \
+    $(LOCAL_PATH)/../../ouzel/core/WorkerPool.cpp \
     $(LOCAL_PATH)/../../ouzel/events/EventDispatcher.cpp \
+    $(LOCAL_PATH)/../../ouzel/events/EventRecorder.cpp \
     $(LOCAL_PATH)/../../ouzel/files/FileSystem.cpp \
     $(LOCAL_PATH)/../../ouzel/graphics/BlendState.cpp \
     $(LOCAL_PATH)/../../ouzel/graphics/Color.cpp \
     $(LOCAL_PATH)/../../ouzel/graphics/Image.cpp \
     $(LOCAL_PATH)/../../ouzel/graphics/MeshBuffer.cpp \
     $(LOCAL_PATH)/../../ouzel/graphics/Renderer.cpp \
+    $(LOCAL_PATH)/../../ouzel/graphics/RendererEmpty.cpp \
     $(LOCAL_PATH)/../../ouzel/graphics/RenderTarget.cpp \
     $(LOCAL_PATH)/../../ouzel/graphics/Shader.cpp \
     $(LOCAL_PATH)/../../ouzel/graphics/Texture.cpp \
@@ -48,6 +55,7 @@ LOCAL_SRC_FILES :=$(LOCAL_PATH)/../../ouzel/android/ApplicationAndroid.cpp \
     $(LOCAL_PATH)/../../ouzel/gui/ComboBox.cpp \
     $(LOCAL_PATH)/../../ouzel/gui/EditBox.cpp \
     $(LOCAL_PATH)/../../ouzel/gui/Label.cpp \
+    $(LOCAL_PATH)/../../ouzel/gui/LatencyLabel.cpp \
     $(LOCAL_PATH)/../../ouzel/gui/Menu.cpp \
     $(LOCAL_PATH)/../../ouzel/gui/Popup.cpp \
     $(LOCAL_PATH)/../../ouzel/gui/RadioButton.cpp \
@@ -76,8 +84,6 @@ LOCAL_SRC_FILES :=$(LOCAL_PATH)/../../ouzel/android/ApplicationAndroid.cpp \
     $(LOCAL_PATH)/../../ouzel/opengl/ShaderOGL.cpp \
     $(LOCAL_PATH)/../../ouzel/opengl/TextureOGL.cpp \
     $(LOCAL_PATH)/../../ouzel/opensl/AudioSL.cpp \
-    $(LOCAL_PATH)/../../ouzel/opensl/SoundSL.cpp \
-    $(LOCAL_PATH)/../../ouzel/opensl/SoundDataSL.cpp \
     $(LOCAL_PATH)/../../ouzel/scene/Camera.cpp \
     $(LOCAL_PATH)/../../ouzel/scene/DebugDrawable.cpp \
     $(LOCAL_PATH)/../../ouzel/scene/Drawable.cpp \
@@ -85,7 +91,9 @@ LOCAL_SRC_FILES :=$(LOCAL_PATH)/../../ouzel/android/ApplicationAndroid.cpp \
     $(LOCAL_PATH)/../../ouzel/scene/Node.cpp \
     $(LOCAL_PATH)/../../ouzel/scene/NodeContainer.cpp \
 	$(LOCAL_PATH)/../../ouzel/scene/ParticleDefinition.cpp \
+    $(LOCAL_PATH)/../../ouzel/scene/ParticleManager.cpp \
     $(LOCAL_PATH)/../../ouzel/scene/ParticleSystem.cpp \
+    $(LOCAL_PATH)/../../ouzel/scene/ParticleSystemPool.cpp \
     $(LOCAL_PATH)/../../ouzel/scene/Scene.cpp \
     $(LOCAL_PATH)/../../ouzel/scene/SceneManager.cpp \
     $(LOCAL_PATH)/../../ouzel/scene/Sprite.cpp \
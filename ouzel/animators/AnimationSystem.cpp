@@ -0,0 +1,250 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include "AnimationSystem.h"
+#include "Animator.h"
+#include "core/Engine.h"
+
+namespace ouzel
+{
+    namespace scene
+    {
+        AnimationSystem::AnimationSystem()
+        {
+            updateCallback.callback = std::bind(&AnimationSystem::update, this, std::placeholders::_1);
+            updateCallback.name = "AnimationSystem";
+        }
+
+        AnimationSystem::~AnimationSystem()
+        {
+            sharedEngine->unscheduleUpdate(updateCallback);
+        }
+
+        void AnimationSystem::addAnimator(Animator* animator)
+        {
+            if (animator->slot >= 0)
+            {
+                return;
+            }
+
+            animator->batched = (animator->tween != Animator::Tween::NONE && animator->updatePolicy == Node::UpdatePolicy::ALWAYS);
+
+            if (animator->batched)
+            {
+                TweenPool& pool = tweenPools[static_cast<uint32_t>(animator->tween) - 1];
+
+                animator->slot = static_cast<int32_t>(pool.animators.size());
+                pool.animators.push_back(animator);
+                pool.tweens.push_back(Tween());
+
+                refreshTween(animator);
+            }
+            else
+            {
+                animator->slot = static_cast<int32_t>(animators.size());
+                animators.push_back(animator);
+            }
+
+            if (animatorCount++ == 0)
+            {
+                sharedEngine->scheduleUpdate(updateCallback);
+            }
+        }
+
+        void AnimationSystem::removeAnimator(Animator* animator)
+        {
+            if (animator->slot < 0)
+            {
+                return;
+            }
+
+            size_t slot = static_cast<size_t>(animator->slot);
+
+            if (animator->batched)
+            {
+                TweenPool& pool = tweenPools[static_cast<uint32_t>(animator->tween) - 1];
+
+                if (updating)
+                {
+                    pool.animators[slot] = nullptr;
+                    needsCompaction = true;
+                }
+                else
+                {
+                    Animator* last = pool.animators.back();
+                    pool.animators[slot] = last;
+                    last->slot = static_cast<int32_t>(slot);
+                    pool.animators.pop_back();
+                    pool.tweens[slot] = pool.tweens.back();
+                    pool.tweens.pop_back();
+                }
+            }
+            else if (updating)
+            {
+                // the slots are compacted after the update
+                animators[slot] = nullptr;
+                needsCompaction = true;
+            }
+            else
+            {
+                Animator* last = animators.back();
+                animators[slot] = last;
+                last->slot = static_cast<int32_t>(slot);
+                animators.pop_back();
+            }
+
+            animator->slot = -1;
+            animator->batched = false;
+
+            if (--animatorCount == 0 && !updating)
+            {
+                sharedEngine->unscheduleUpdate(updateCallback);
+            }
+        }
+
+        void AnimationSystem::update(float delta)
+        {
+            updating = true;
+
+            // animators added during the update are updated in the next frame
+            size_t count = animators.size();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (Animator* animator = animators[i])
+                {
+                    animator->handleUpdate(delta);
+                }
+            }
+
+            for (uint32_t tween = 0; tween < TWEEN_COUNT; ++tween)
+            {
+                updateTweens(tween, delta);
+            }
+
+            updating = false;
+
+            if (needsCompaction)
+            {
+                compact();
+            }
+
+            if (animatorCount == 0)
+            {
+                sharedEngine->unscheduleUpdate(updateCallback);
+            }
+        }
+
+        void AnimationSystem::updateTweens(uint32_t tween, float delta)
+        {
+            TweenPool& pool = tweenPools[tween];
+
+            // animators added during the update are updated in the next frame
+            size_t count = pool.animators.size();
+
+            if (pool.values.size() < count)
+            {
+                pool.progresses.resize(count);
+                pool.values.resize(count);
+            }
+
+            // the removed slots are computed too, they are skipped when writing the values
+            for (size_t i = 0; i < count; ++i)
+            {
+                Tween& current = pool.tweens[i];
+                current.currentTime += delta;
+
+                float progress = 1.0f;
+
+                if (current.currentTime >= current.length)
+                {
+                    current.currentTime = current.length;
+                }
+                else
+                {
+                    progress = current.currentTime / current.length;
+                }
+
+                pool.progresses[i] = progress;
+                pool.values[i] = current.start + current.difference * progress;
+            }
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (Animator* animator = pool.animators[i])
+                {
+                    animator->currentTime = pool.tweens[i].currentTime;
+                    animator->progress = pool.progresses[i];
+
+                    if (NodePtr node = animator->node.lock())
+                    {
+                        switch (animator->tween)
+                        {
+                            case Animator::Tween::MOVE: node->setPosition(pool.values[i]); break;
+                            case Animator::Tween::ROTATE: node->setRotation(pool.values[i].x); break;
+                            case Animator::Tween::SCALE: node->setScale(pool.values[i]); break;
+                            case Animator::Tween::FADE: node->setOpacity(pool.values[i].x); break;
+                            default: break;
+                        }
+                    }
+                }
+            }
+
+            // the finish handlers can start and stop animators, so they are called after all the values are written
+            for (size_t i = 0; i < count; ++i)
+            {
+                Animator* animator = pool.animators[i];
+
+                if (animator && pool.progresses[i] >= 1.0f)
+                {
+                    animator->done = true;
+                    animator->running = false;
+                    removeAnimator(animator);
+                    if (animator->finishHandler) animator->finishHandler();
+                }
+            }
+        }
+
+        void AnimationSystem::refreshTween(Animator* animator)
+        {
+            TweenPool& pool = tweenPools[static_cast<uint32_t>(animator->tween) - 1];
+            Tween& current = pool.tweens[static_cast<size_t>(animator->slot)];
+
+            current.length = animator->length;
+            current.currentTime = animator->currentTime;
+            animator->getTween(current.start, current.difference);
+        }
+
+        void AnimationSystem::compact()
+        {
+            animators.erase(std::remove(animators.begin(), animators.end(), nullptr), animators.end());
+
+            for (size_t i = 0; i < animators.size(); ++i)
+            {
+                animators[i]->slot = static_cast<int32_t>(i);
+            }
+
+            for (TweenPool& pool : tweenPools)
+            {
+                size_t count = 0;
+
+                for (size_t i = 0; i < pool.animators.size(); ++i)
+                {
+                    if (Animator* animator = pool.animators[i])
+                    {
+                        animator->slot = static_cast<int32_t>(count);
+                        pool.animators[count] = animator;
+                        pool.tweens[count] = pool.tweens[i];
+                        ++count;
+                    }
+                }
+
+                pool.animators.resize(count);
+                pool.tweens.resize(count);
+            }
+
+            needsCompaction = false;
+        }
+    } // namespace scene
+} // namespace ouzel
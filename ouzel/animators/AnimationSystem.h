@@ -0,0 +1,74 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <vector>
+#include "utils/Noncopyable.h"
+#include "core/UpdateCallback.h"
+#include "math/Vector2.h"
+
+namespace ouzel
+{
+    class Engine;
+
+    namespace scene
+    {
+        class Animator;
+
+        /**
+         * Updates all running animators from one update callback instead of registering a callback per animator with the engine.
+         * Move, rotate, scale and fade animators that are updated every frame are kept in a pool per type and updated in one loop,
+         * the values are written to the nodes after the loop. Their update and updateProgress are not called for these frames.
+         * Other animators are updated with their own virtual update call.
+         * Adding and removing is O(1), removal during the update is deferred until the update has finished.
+         */
+        class AnimationSystem: public Noncopyable
+        {
+            friend Engine;
+            friend Animator;
+        public:
+            virtual ~AnimationSystem();
+
+            void addAnimator(Animator* animator);
+            void removeAnimator(Animator* animator);
+
+            uint32_t getAnimatorCount() const { return animatorCount; }
+
+        protected:
+            AnimationSystem();
+
+            // copy of the animator values, so that the update loop doesn't have to access the animators
+            struct Tween
+            {
+                float length;
+                float currentTime;
+                Vector2 start;
+                Vector2 difference;
+            };
+
+            struct TweenPool
+            {
+                std::vector<Animator*> animators;
+                std::vector<Tween> tweens;
+                std::vector<float> progresses; // results of the last update
+                std::vector<Vector2> values;
+            };
+
+            void update(float delta);
+            void updateTweens(uint32_t tween, float delta);
+            void refreshTween(Animator* animator);
+            void compact();
+
+            static const uint32_t TWEEN_COUNT = 4;
+            TweenPool tweenPools[TWEEN_COUNT];
+
+            std::vector<Animator*> animators;
+            uint32_t animatorCount = 0;
+            bool updating = false;
+            bool needsCompaction = false;
+
+            UpdateCallback updateCallback;
+        };
+    } // namespace scene
+} // namespace ouzel
@@ -4,6 +4,7 @@
 #include "Animator.h"
 #include "utils/Utils.h"
 #include "core/Engine.h"
+#include "AnimationSystem.h"
 
 namespace ouzel
 {
@@ -12,12 +13,11 @@ namespace ouzel
         Animator::Animator(float pLength):
             length(pLength)
         {
-            updateCallback.callback = std::bind(&Animator::update, this, std::placeholders::_1);
         }
 
         Animator::~Animator()
         {
-            sharedEngine->unscheduleUpdate(updateCallback);
+            sharedEngine->getAnimationSystem()->removeAnimator(this);
         }
 
         void Animator::update(float delta)
@@ -30,7 +30,7 @@ namespace ouzel
                     running = false;
                     progress = 1.0f;
                     currentTime = length;
-                    sharedEngine->unscheduleUpdate(updateCallback);
+                    sharedEngine->getAnimationSystem()->removeAnimator(this);
                     if (finishHandler) finishHandler();
                 }
                 else
@@ -43,6 +43,39 @@ namespace ouzel
             }
         }
 
+        void Animator::handleUpdate(float delta)
+        {
+            if (updatePolicy != Node::UpdatePolicy::ALWAYS)
+            {
+                NodePtr targetNode = node.lock();
+
+                if (targetNode && !targetNode->isOnScreen())
+                {
+                    if (updatePolicy == Node::UpdatePolicy::FAST_FORWARD)
+                    {
+                        skippedTime += delta;
+                    }
+
+                    return;
+                }
+            }
+
+            update(delta + skippedTime);
+            skippedTime = 0.0f;
+        }
+
+        void Animator::setUpdatePolicy(Node::UpdatePolicy newUpdatePolicy)
+        {
+            updatePolicy = newUpdatePolicy;
+
+            // only the animators updated every frame are batched, add again to move between the lists
+            if (slot >= 0)
+            {
+                sharedEngine->getAnimationSystem()->removeAnimator(this);
+                sharedEngine->getAnimationSystem()->addAnimator(this);
+            }
+        }
+
         void Animator::start(const NodePtr& targetNode)
         {
             if (!running)
@@ -50,7 +83,7 @@ namespace ouzel
                 running = true;
                 node = targetNode;
 
-                sharedEngine->scheduleUpdate(updateCallback);
+                sharedEngine->getAnimationSystem()->addAnimator(this);
             }
         }
 
@@ -59,7 +92,7 @@ namespace ouzel
             if (!running)
             {
                 running = true;
-                sharedEngine->scheduleUpdate(updateCallback);
+                sharedEngine->getAnimationSystem()->addAnimator(this);
             }
         }
 
@@ -68,7 +101,7 @@ namespace ouzel
             if (running)
             {
                 running = false;
-                sharedEngine->unscheduleUpdate(updateCallback);
+                sharedEngine->getAnimationSystem()->removeAnimator(this);
             }
 
             if (resetAnimation)
@@ -89,6 +122,7 @@ namespace ouzel
             progress = newProgress;
             currentTime = progress * length;
 
+            refreshTween();
             updateProgress();
         }
 
@@ -96,5 +130,13 @@ namespace ouzel
         {
         }
 
+        void Animator::refreshTween()
+        {
+            if (batched)
+            {
+                sharedEngine->getAnimationSystem()->refreshTween(this);
+            }
+        }
+
     } // namespace scene
 } // namespace ouzel
@@ -5,7 +5,7 @@
 
 #include <functional>
 #include "utils/Types.h"
-#include "core/UpdateCallback.h"
+#include "scene/Node.h"
 
 namespace ouzel
 {
@@ -13,6 +13,7 @@ namespace ouzel
     {
         class Animator
         {
+            friend AnimationSystem;
         public:
             Animator(float pLength);
             virtual ~Animator();
@@ -36,9 +37,27 @@ namespace ouzel
 
             void setFinishHandler(const std::function<void()>& handler) { finishHandler = handler; }
 
+            virtual void setUpdatePolicy(Node::UpdatePolicy newUpdatePolicy);
+            Node::UpdatePolicy getUpdatePolicy() const { return updatePolicy; }
+
         protected:
+            // the node property that a tween interpolates
+            enum class Tween
+            {
+                NONE,
+                MOVE,
+                ROTATE,
+                SCALE,
+                FADE
+            };
+
+            void handleUpdate(float delta);
             virtual void updateProgress();
 
+            // start and difference of the interpolated value, the rotation and the opacity use only x
+            virtual void getTween(Vector2&, Vector2&) const {}
+            void refreshTween(); // called when the values of a batched tween change
+
             float length = 0.0f;
             float currentTime = 0.0f;
             float progress = 0.0f;
@@ -47,7 +66,12 @@ namespace ouzel
 
             NodeWeakPtr node;
 
-            UpdateCallback updateCallback;
+            Node::UpdatePolicy updatePolicy = Node::UpdatePolicy::ALWAYS;
+            float skippedTime = 0.0f;
+
+            Tween tween = Tween::NONE;
+            bool batched = false; // updated by the tween pool of the animation system instead of update
+            int32_t slot = -1; // position in the animation system
 
             std::function<void()> finishHandler;
         };
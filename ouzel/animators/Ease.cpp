@@ -336,5 +336,15 @@ namespace ouzel
 
             animator->setProgress(progress);
         }
+
+        void Ease::setUpdatePolicy(Node::UpdatePolicy newUpdatePolicy)
+        {
+            Animator::setUpdatePolicy(newUpdatePolicy);
+
+            if (animator)
+            {
+                animator->setUpdatePolicy(newUpdatePolicy);
+            }
+        }
     } // namespace scene
 } // namespace ouzel
@@ -11,7 +11,7 @@ namespace ouzel
         Fade::Fade(float pLength, float pOpacity, bool pRelative):
             Animator(pLength), opacity(pOpacity), relative(pRelative)
         {
-
+            tween = Tween::FADE;
         }
 
         void Fade::start(const NodePtr& targetNode)
@@ -25,6 +25,8 @@ namespace ouzel
 
                 diff = targetOpacity - startOpacity;
             }
+
+            refreshTween();
         }
 
         void Fade::updateProgress()
@@ -36,5 +38,11 @@ namespace ouzel
                 targetNode->setOpacity(startOpacity + (diff * progress));
             }
         }
+
+        void Fade::getTween(Vector2& start, Vector2& difference) const
+        {
+            start = Vector2(startOpacity, 0.0f);
+            difference = Vector2(diff, 0.0f);
+        }
     } // namespace scene
 } // namespace ouzel
@@ -18,6 +18,7 @@ namespace ouzel
 
         protected:
             virtual void updateProgress() override;
+            virtual void getTween(Vector2& start, Vector2& difference) const override;
 
             float opacity;
             float startOpacity = 0.0f;
@@ -11,7 +11,7 @@ namespace ouzel
         Move::Move(float pLength, const Vector2& pPosition, bool pRelative):
             Animator(pLength), position(pPosition), relative(pRelative)
         {
-
+            tween = Tween::MOVE;
         }
 
         void Move::start(const NodePtr& targetNode)
@@ -25,6 +25,8 @@ namespace ouzel
 
                 diff = targetPosition - startPosition;
             }
+
+            refreshTween();
         }
 
         void Move::updateProgress()
@@ -36,5 +38,11 @@ namespace ouzel
                 targetNode->setPosition(startPosition + (diff * progress));
             }
         }
+
+        void Move::getTween(Vector2& start, Vector2& difference) const
+        {
+            start = startPosition;
+            difference = diff;
+        }
     } // namespace scene
 } // namespace ouzel
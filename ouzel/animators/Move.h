@@ -19,6 +19,7 @@ namespace ouzel
 
         protected:
             virtual void updateProgress() override;
+            virtual void getTween(Vector2& start, Vector2& difference) const override;
 
             Vector2 position;
             Vector2 startPosition;
@@ -57,5 +57,15 @@ namespace ouzel
                 }
             }
         }
+
+        void Parallel::setUpdatePolicy(Node::UpdatePolicy newUpdatePolicy)
+        {
+            Animator::setUpdatePolicy(newUpdatePolicy);
+
+            for (auto& animator : animators)
+            {
+                animator->setUpdatePolicy(newUpdatePolicy);
+            }
+        }
     } // namespace scene
 } // namespace ouzel
@@ -67,5 +67,15 @@ namespace ouzel
 
             currentCount = 0;
         }
+
+        void Repeat::setUpdatePolicy(Node::UpdatePolicy newUpdatePolicy)
+        {
+            Animator::setUpdatePolicy(newUpdatePolicy);
+
+            if (animator)
+            {
+                animator->setUpdatePolicy(newUpdatePolicy);
+            }
+        }
     } // namespace scene
 } // namespace ouzel
@@ -20,6 +20,8 @@ namespace ouzel
             virtual void start(const NodePtr& targetNode) override;
             virtual void reset() override;
 
+            virtual void setUpdatePolicy(Node::UpdatePolicy newUpdatePolicy) override;
+
         protected:
             AnimatorPtr animator;
             uint32_t count = 0;
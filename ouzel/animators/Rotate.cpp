@@ -11,7 +11,7 @@ namespace ouzel
         Rotate::Rotate(float pLength, float pRotation, bool pRelative):
             Animator(pLength), rotation(pRotation), relative(pRelative)
         {
-
+            tween = Tween::ROTATE;
         }
 
         void Rotate::start(const NodePtr& targetNode)
@@ -25,6 +25,8 @@ namespace ouzel
 
                 diff = targetRotation - startRotation;
             }
+
+            refreshTween();
         }
 
         void Rotate::updateProgress()
@@ -36,5 +38,11 @@ namespace ouzel
                 targetNode->setRotation(startRotation + (diff * progress));
             }
         }
+
+        void Rotate::getTween(Vector2& start, Vector2& difference) const
+        {
+            start = Vector2(startRotation, 0.0f);
+            difference = Vector2(diff, 0.0f);
+        }
     } // namespace scene
 } // namespace ouzel
@@ -11,7 +11,7 @@ namespace ouzel
         Scale::Scale(float pLength, const Vector2& pScale, bool pRelative):
             Animator(pLength), scale(pScale), relative(pRelative)
         {
-
+            tween = Tween::SCALE;
         }
 
         void Scale::start(const NodePtr& targetNode)
@@ -25,6 +25,8 @@ namespace ouzel
 
                 diff = targetScale - startScale;
             }
+
+            refreshTween();
         }
 
         void Scale::updateProgress()
@@ -36,5 +38,11 @@ namespace ouzel
                 targetNode->setScale(startScale + (diff * progress));
             }
         }
+
+        void Scale::getTween(Vector2& start, Vector2& difference) const
+        {
+            start = startScale;
+            difference = diff;
+        }
     } // namespace scene
 } // namespace ouzel
@@ -60,5 +60,15 @@ namespace ouzel
                 time += animator->getLength();
             }
         }
+
+        void Sequence::setUpdatePolicy(Node::UpdatePolicy newUpdatePolicy)
+        {
+            Animator::setUpdatePolicy(newUpdatePolicy);
+
+            for (auto& animator : animators)
+            {
+                animator->setUpdatePolicy(newUpdatePolicy);
+            }
+        }
     } // namespace scene
 } // namespace ouzel
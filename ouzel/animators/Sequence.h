@@ -19,6 +19,8 @@ namespace ouzel
             virtual void start(const NodePtr& node) override;
             virtual void reset() override;
 
+            virtual void setUpdatePolicy(Node::UpdatePolicy newUpdatePolicy) override;
+
         protected:
             virtual void updateProgress() override;
 
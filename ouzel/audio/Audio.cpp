@@ -4,6 +4,7 @@
 #include "Audio.h"
 #include "SoundData.h"
 #include "Sound.h"
+#include "SoundStream.h"
 
 namespace ouzel
 {
@@ -41,5 +42,11 @@ namespace ouzel
             SoundPtr sound(new Sound());
             return sound;
         }
+
+        SoundStreamPtr Audio::createSoundStream()
+        {
+            SoundStreamPtr soundStream(new SoundStream());
+            return soundStream;
+        }
     } // namespace audio
 } // namespace ouzel
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include "utils/Noncopyable.h"
 #include "utils/Types.h"
+#include "audio/Mixer.h"
 
 #ifdef OPENAL
 #undef OPENAL
@@ -15,7 +17,7 @@ namespace ouzel
 
     namespace audio
     {
-        class Audio
+        class Audio: public Noncopyable
         {
             friend Engine;
         public:
@@ -35,6 +37,10 @@ namespace ouzel
 
             virtual SoundDataPtr createSoundData();
             virtual SoundPtr createSound();
+            virtual SoundStreamPtr createSoundStream();
+
+            // all the sounds are mixed by the mixer and the backend outputs only its stream
+            Mixer& getMixer() { return mixer; }
 
             bool isReady() const { return ready; }
 
@@ -42,6 +48,7 @@ namespace ouzel
             Audio(Driver pDriver = Driver::NONE);
 
             Driver driver;
+            Mixer mixer;
 
             bool ready = false;
         };
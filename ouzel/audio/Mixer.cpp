@@ -0,0 +1,631 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include "Mixer.h"
+#include "SoundData.h"
+#include "SoundStream.h"
+#include "math/MathUtils.h"
+#include "math/SIMD.h"
+
+namespace ouzel
+{
+    namespace audio
+    {
+        const uint32_t Mixer::BLOCK_SIZE;
+
+        alignas(16) static const float RAMP[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+
+        Mixer::Mixer(uint32_t aSampleRate, uint32_t aMaxVoices):
+            sampleRate(aSampleRate), maxVoices(aMaxVoices),
+            masterVolume(1.0f), activeVoiceCount(0), stolenVoiceCount(0), rejectedVoiceCount(0)
+        {
+            // stolen voices fade out for a block next to the voices that replaced them
+            voices.reserve(maxVoices * 2);
+            releasedSoundData.reserve(maxVoices * 2);
+            releasedSoundStreams.reserve(maxVoices * 2);
+
+            // four 16-byte aligned block buffers
+            buffer.resize(BLOCK_SIZE * 4 + 3);
+            float* base = buffer.data();
+            base += (4 - (reinterpret_cast<uintptr_t>(base) / sizeof(float)) % 4) % 4;
+
+            accumulatorLeft = base;
+            accumulatorRight = base + BLOCK_SIZE;
+            sourceLeft = base + BLOCK_SIZE * 2;
+            sourceRight = base + BLOCK_SIZE * 3;
+        }
+
+        uint32_t Mixer::play(const SoundDataPtr& soundData, bool repeat, float volume, float pitch, float pan, int32_t priority)
+        {
+            if (!soundData || !soundData->isReady() || soundData->getFrameCount() == 0)
+            {
+                return 0;
+            }
+
+            Command command;
+            command.type = Command::Type::PLAY;
+            command.soundData = soundData;
+            command.repeat = repeat;
+            command.volume = volume;
+            command.pitch = pitch;
+            command.pan = pan;
+            command.priority = priority;
+
+            std::lock_guard<std::mutex> lock(commandMutex);
+
+            if (++lastVoiceId == 0) ++lastVoiceId; // 0 is not a valid id
+            command.voiceId = lastVoiceId;
+
+            commands.push_back(command);
+            playingVoiceIds.insert(command.voiceId);
+
+            return command.voiceId;
+        }
+
+        uint32_t Mixer::play(const SoundStreamPtr& soundStream, float volume, float pitch, float pan, int32_t priority)
+        {
+            if (!soundStream || !soundStream->isReady())
+            {
+                return 0;
+            }
+
+            Command command;
+            command.type = Command::Type::PLAY;
+            command.soundStream = soundStream;
+            command.repeat = false;
+            command.volume = volume;
+            command.pitch = pitch;
+            command.pan = pan;
+            command.priority = priority;
+
+            std::lock_guard<std::mutex> lock(commandMutex);
+
+            if (++lastVoiceId == 0) ++lastVoiceId; // 0 is not a valid id
+            command.voiceId = lastVoiceId;
+
+            commands.push_back(command);
+            playingVoiceIds.insert(command.voiceId);
+
+            return command.voiceId;
+        }
+
+        void Mixer::stop(uint32_t voiceId)
+        {
+            Command command;
+            command.type = Command::Type::STOP;
+            command.voiceId = voiceId;
+
+            std::lock_guard<std::mutex> lock(commandMutex);
+            commands.push_back(command);
+            playingVoiceIds.erase(voiceId);
+        }
+
+        void Mixer::pause(uint32_t voiceId)
+        {
+            Command command;
+            command.type = Command::Type::PAUSE;
+            command.voiceId = voiceId;
+            pushCommand(command);
+        }
+
+        void Mixer::resume(uint32_t voiceId)
+        {
+            Command command;
+            command.type = Command::Type::RESUME;
+            command.voiceId = voiceId;
+            pushCommand(command);
+        }
+
+        void Mixer::setParameters(uint32_t voiceId, float volume, float pitch, float pan)
+        {
+            Command command;
+            command.type = Command::Type::SET_PARAMETERS;
+            command.voiceId = voiceId;
+            command.volume = volume;
+            command.pitch = pitch;
+            command.pan = pan;
+            pushCommand(command);
+        }
+
+        bool Mixer::isPlaying(uint32_t voiceId) const
+        {
+            std::lock_guard<std::mutex> lock(commandMutex);
+            return playingVoiceIds.find(voiceId) != playingVoiceIds.end();
+        }
+
+        void Mixer::update()
+        {
+            std::vector<SoundDataPtr> soundData;
+            std::vector<SoundStreamPtr> soundStreams;
+
+            {
+                std::lock_guard<std::mutex> lock(commandMutex);
+                soundData.swap(finishedSoundData);
+                soundStreams.swap(finishedSoundStreams);
+            }
+
+            // the last references can be dropped here, outside of the lock
+        }
+
+        void Mixer::setMasterVolume(float newMasterVolume)
+        {
+            masterVolume = newMasterVolume;
+        }
+
+        void Mixer::pushCommand(const Command& command)
+        {
+            std::lock_guard<std::mutex> lock(commandMutex);
+            commands.push_back(command);
+        }
+
+        void Mixer::process(float* output, uint32_t frames)
+        {
+            executeCommands();
+
+            while (frames > 0)
+            {
+                uint32_t count = std::min(frames, BLOCK_SIZE);
+                mixBlock(count);
+
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    output[i * 2] = accumulatorLeft[i];
+                    output[i * 2 + 1] = accumulatorRight[i];
+                }
+
+                output += count * 2;
+                frames -= count;
+            }
+
+            publishFinishedVoices();
+        }
+
+        void Mixer::process(int16_t* output, uint32_t frames)
+        {
+            executeCommands();
+
+            const simd::Float4 minimum = simd::set(-1.0f);
+            const simd::Float4 maximum = simd::set(1.0f);
+
+            while (frames > 0)
+            {
+                uint32_t count = std::min(frames, BLOCK_SIZE);
+                mixBlock(count);
+
+                for (uint32_t i = 0; i < count; i += 4)
+                {
+                    simd::store(accumulatorLeft + i, simd::min(simd::max(simd::load(accumulatorLeft + i), minimum), maximum));
+                    simd::store(accumulatorRight + i, simd::min(simd::max(simd::load(accumulatorRight + i), minimum), maximum));
+                }
+
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    output[i * 2] = static_cast<int16_t>(accumulatorLeft[i] * 32767.0f);
+                    output[i * 2 + 1] = static_cast<int16_t>(accumulatorRight[i] * 32767.0f);
+                }
+
+                output += count * 2;
+                frames -= count;
+            }
+
+            publishFinishedVoices();
+        }
+
+        void Mixer::executeCommands()
+        {
+            {
+                std::lock_guard<std::mutex> lock(commandMutex);
+                processedCommands.swap(commands);
+                currentMasterVolume = masterVolume;
+            }
+
+            for (Command& command : processedCommands)
+            {
+                if (command.type == Command::Type::PLAY)
+                {
+                    startVoice(command);
+                    continue;
+                }
+
+                auto i = std::find_if(voices.begin(), voices.end(), [&command](const Voice& voice) {
+                    return voice.id == command.voiceId;
+                });
+
+                if (i == voices.end())
+                {
+                    continue;
+                }
+
+                switch (command.type)
+                {
+                    case Command::Type::STOP:
+                        i->stopping = true;
+                        break;
+                    case Command::Type::PAUSE:
+                        i->paused = true;
+                        break;
+                    case Command::Type::RESUME:
+                        i->paused = false;
+                        break;
+                    case Command::Type::SET_PARAMETERS:
+                        i->volume = command.volume;
+                        i->pitch = command.pitch;
+                        i->pan = command.pan;
+                        break;
+                    default:
+                        break;
+                }
+            }
+
+            // the play commands have passed their sound references to the voices
+            processedCommands.clear();
+        }
+
+        void Mixer::startVoice(Command& command)
+        {
+            if (command.soundStream)
+            {
+                // a stream has only one read position, so the voice playing it is detached from it and fades out its last frame
+                for (Voice& voice : voices)
+                {
+                    if (voice.soundStream == command.soundStream)
+                    {
+                        if (!voice.stopping) finishedVoiceIds.push_back(voice.id);
+                        voice.stopping = true;
+                        releasedSoundStreams.push_back(std::move(voice.soundStream));
+                    }
+                }
+            }
+
+            // the voices that are fading out don't count
+            Voice* victim = nullptr;
+            uint32_t voiceCount = 0;
+
+            for (Voice& voice : voices)
+            {
+                if (voice.stopping) continue;
+
+                ++voiceCount;
+
+                // the lowest priority and the quietest
+                if (!victim || voice.priority < victim->priority ||
+                    (voice.priority == victim->priority && voice.volume < victim->volume))
+                {
+                    victim = &voice;
+                }
+            }
+
+            if (voiceCount >= maxVoices)
+            {
+                if (!victim || victim->priority > command.priority)
+                {
+                    ++rejectedVoiceCount;
+                    finishedVoiceIds.push_back(command.voiceId);
+                    if (command.soundData) releasedSoundData.push_back(std::move(command.soundData));
+                    if (command.soundStream) releasedSoundStreams.push_back(std::move(command.soundStream));
+                    return;
+                }
+
+                ++stolenVoiceCount;
+                finishedVoiceIds.push_back(victim->id);
+                victim->stopping = true;
+            }
+
+            if (voices.size() == voices.capacity())
+            {
+                // too many voices are fading out, one of them is cut off
+                for (uint32_t i = 0; i < voices.size(); ++i)
+                {
+                    if (voices[i].stopping)
+                    {
+                        removeVoice(i);
+                        break;
+                    }
+                }
+            }
+
+            Voice voice;
+            voice.id = command.voiceId;
+            voice.soundData = std::move(command.soundData);
+            voice.soundStream = std::move(command.soundStream);
+            // the first frame of a stream follows the last frame of the (silent) previous block
+            voice.position = voice.soundStream ? 1.0 : 0.0;
+            voice.lastFrame[0] = voice.lastFrame[1] = 0.0f;
+            voice.hasPendingFrame = false;
+            voice.channels = voice.soundStream ? voice.soundStream->getChannels() : voice.soundData->getChannels();
+            voice.repeat = command.repeat;
+            voice.paused = false;
+            voice.stopping = false;
+            voice.volume = command.volume;
+            voice.pitch = command.pitch;
+            voice.pan = command.pan;
+            voice.priority = command.priority;
+            getTargetGains(voice, voice.gainLeft, voice.gainRight);
+
+            voices.push_back(std::move(voice));
+        }
+
+        void Mixer::removeVoice(uint32_t index)
+        {
+            Voice& voice = voices[index];
+
+            finishedVoiceIds.push_back(voice.id);
+            if (voice.soundData) releasedSoundData.push_back(std::move(voice.soundData));
+            if (voice.soundStream) releasedSoundStreams.push_back(std::move(voice.soundStream));
+
+            if (index != voices.size() - 1)
+            {
+                voice = std::move(voices.back());
+            }
+
+            voices.pop_back();
+        }
+
+        void Mixer::mixBlock(uint32_t frames)
+        {
+            std::fill(accumulatorLeft, accumulatorLeft + BLOCK_SIZE, 0.0f);
+            std::fill(accumulatorRight, accumulatorRight + BLOCK_SIZE, 0.0f);
+
+            for (uint32_t i = 0; i < voices.size();)
+            {
+                if (mixVoice(voices[i], frames))
+                {
+                    ++i;
+                }
+                else
+                {
+                    removeVoice(i);
+                }
+            }
+
+            activeVoiceCount = static_cast<uint32_t>(voices.size());
+        }
+
+        void Mixer::publishFinishedVoices()
+        {
+            if (finishedVoiceIds.empty() && releasedSoundData.empty() && releasedSoundStreams.empty())
+            {
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(commandMutex);
+
+                for (uint32_t voiceId : finishedVoiceIds)
+                {
+                    playingVoiceIds.erase(voiceId);
+                }
+
+                std::move(releasedSoundData.begin(), releasedSoundData.end(), std::back_inserter(finishedSoundData));
+                std::move(releasedSoundStreams.begin(), releasedSoundStreams.end(), std::back_inserter(finishedSoundStreams));
+            }
+
+            finishedVoiceIds.clear();
+            releasedSoundData.clear();
+            releasedSoundStreams.clear();
+        }
+
+        bool Mixer::mixVoice(Voice& voice, uint32_t frames)
+        {
+            float targetLeft;
+            float targetRight;
+            getTargetGains(voice, targetLeft, targetRight);
+
+            if (voice.paused && voice.gainLeft == 0.0f && voice.gainRight == 0.0f)
+            {
+                return !voice.stopping;
+            }
+
+            uint32_t channels = voice.channels;
+            bool finished = false;
+            uint32_t frame = frames;
+
+            // stage 1: resample the source into the planar source buffers
+            if (voice.soundStream)
+            {
+                frame = readSoundStream(voice, frames, finished);
+            }
+            else if (voice.soundData)
+            {
+                frame = readSoundData(voice, frames, finished);
+            }
+            else // detached from its stream
+            {
+                std::fill(sourceLeft, sourceLeft + frames, voice.lastFrame[0]);
+                if (channels > 1) std::fill(sourceRight, sourceRight + frames, voice.lastFrame[1]);
+            }
+
+            // pad to a multiple of four for the SIMD loop
+            uint32_t paddedFrames = (frames + 3) & ~3u;
+            std::fill(sourceLeft + frame, sourceLeft + paddedFrames, 0.0f);
+            if (channels > 1) std::fill(sourceRight + frame, sourceRight + paddedFrames, 0.0f);
+
+            // stage 2: accumulate with a linear gain ramp from the previous gains to the target gains
+            float deltaLeft = (targetLeft - voice.gainLeft) / frames;
+            float deltaRight = (targetRight - voice.gainRight) / frames;
+
+            simd::Float4 ramp = simd::load(RAMP);
+            simd::Float4 gainLeft = simd::add(simd::set(voice.gainLeft), simd::mul(simd::set(deltaLeft), ramp));
+            simd::Float4 gainRight = simd::add(simd::set(voice.gainRight), simd::mul(simd::set(deltaRight), ramp));
+            simd::Float4 stepLeft = simd::set(deltaLeft * 4.0f);
+            simd::Float4 stepRight = simd::set(deltaRight * 4.0f);
+
+            const float* inputRight = (channels > 1) ? sourceRight : sourceLeft;
+
+            for (uint32_t i = 0; i < paddedFrames; i += 4)
+            {
+                simd::store(accumulatorLeft + i, simd::add(simd::load(accumulatorLeft + i), simd::mul(simd::load(sourceLeft + i), gainLeft)));
+                simd::store(accumulatorRight + i, simd::add(simd::load(accumulatorRight + i), simd::mul(simd::load(inputRight + i), gainRight)));
+
+                gainLeft = simd::add(gainLeft, stepLeft);
+                gainRight = simd::add(gainRight, stepRight);
+            }
+
+            voice.gainLeft = targetLeft;
+            voice.gainRight = targetRight;
+
+            return !finished && !voice.stopping;
+        }
+
+        uint32_t Mixer::readSoundData(Voice& voice, uint32_t frames, bool& finished)
+        {
+            const std::vector<float>& samples = voice.soundData->getSamples();
+            uint32_t channels = voice.soundData->getChannels();
+            uint32_t frameCount = voice.soundData->getFrameCount();
+            double step = static_cast<double>(voice.pitch) * voice.soundData->getSamplesPerSecond() / sampleRate;
+            uint32_t frame = 0;
+
+            if (step == 1.0 && voice.position == std::floor(voice.position))
+            {
+                while (frame < frames)
+                {
+                    uint32_t index = static_cast<uint32_t>(voice.position);
+
+                    if (index >= frameCount)
+                    {
+                        if (!voice.repeat)
+                        {
+                            finished = true;
+                            break;
+                        }
+
+                        index = 0;
+                    }
+
+                    uint32_t count = std::min(frames - frame, frameCount - index);
+                    const float* source = samples.data() + index * channels;
+
+                    if (channels == 1)
+                    {
+                        std::copy(source, source + count, sourceLeft + frame);
+                    }
+                    else
+                    {
+                        for (uint32_t i = 0; i < count; ++i, source += channels)
+                        {
+                            sourceLeft[frame + i] = source[0];
+                            sourceRight[frame + i] = source[1];
+                        }
+                    }
+
+                    frame += count;
+                    voice.position = index + count;
+                }
+            }
+            else
+            {
+                for (; frame < frames; ++frame)
+                {
+                    if (voice.position >= frameCount)
+                    {
+                        if (!voice.repeat)
+                        {
+                            finished = true;
+                            break;
+                        }
+
+                        voice.position = std::fmod(voice.position, static_cast<double>(frameCount));
+                    }
+
+                    uint32_t index = static_cast<uint32_t>(voice.position);
+                    uint32_t next = index + 1;
+                    if (next >= frameCount) next = voice.repeat ? 0 : index;
+                    float fraction = static_cast<float>(voice.position - index);
+
+                    const float* current = samples.data() + index * channels;
+                    const float* following = samples.data() + next * channels;
+
+                    sourceLeft[frame] = current[0] + (following[0] - current[0]) * fraction;
+                    if (channels > 1) sourceRight[frame] = current[1] + (following[1] - current[1]) * fraction;
+
+                    voice.position += step;
+                }
+            }
+
+            return frame;
+        }
+
+        uint32_t Mixer::readSoundStream(Voice& voice, uint32_t frames, bool& finished)
+        {
+            uint32_t channels = voice.channels;
+            double step = static_cast<double>(voice.pitch) * voice.soundStream->getSampleRate() / sampleRate;
+            double end = voice.position + frames * step;
+
+            // the frames needed for the interpolation of this block, the first one is the last frame of the previous block
+            uint32_t needed = std::max(static_cast<uint32_t>(voice.position + (frames - 1) * step) + 1, static_cast<uint32_t>(end));
+            uint32_t consumed = static_cast<uint32_t>(end);
+            uint32_t pending = voice.hasPendingFrame ? 1 : 0;
+
+            if (streamBuffer.size() < (needed + 1) * channels)
+            {
+                streamBuffer.resize((needed + 1) * channels);
+            }
+
+            std::copy(voice.lastFrame, voice.lastFrame + channels, streamBuffer.begin());
+            if (pending) std::copy(voice.pendingFrame, voice.pendingFrame + channels, streamBuffer.begin() + channels);
+            uint32_t count = pending + voice.soundStream->read(streamBuffer.data() + (pending + 1) * channels, needed - pending);
+
+            // an underrun is played as silence
+            std::fill(streamBuffer.begin() + (count + 1) * channels, streamBuffer.begin() + (needed + 1) * channels, 0.0f);
+
+            if (count < needed && voice.soundStream->isFinished())
+            {
+                finished = true;
+            }
+
+            for (uint32_t frame = 0; frame < frames; ++frame)
+            {
+                double position = voice.position + frame * step;
+                uint32_t index = static_cast<uint32_t>(position);
+                float fraction = static_cast<float>(position - index);
+
+                const float* current = streamBuffer.data() + index * channels;
+                const float* following = current + channels;
+
+                sourceLeft[frame] = current[0] + (following[0] - current[0]) * fraction;
+                if (channels > 1) sourceRight[frame] = current[1] + (following[1] - current[1]) * fraction;
+            }
+
+            std::copy(streamBuffer.begin() + consumed * channels, streamBuffer.begin() + (consumed + 1) * channels, voice.lastFrame);
+            voice.position = end - consumed;
+
+            // with a pitch below one the last frame of the block can be interpolated towards a frame after the consumed ones
+            voice.hasPendingFrame = (needed > consumed && count > consumed);
+            if (voice.hasPendingFrame)
+            {
+                std::copy(streamBuffer.begin() + (consumed + 1) * channels, streamBuffer.begin() + (consumed + 2) * channels, voice.pendingFrame);
+            }
+
+            return frames;
+        }
+
+        void Mixer::getTargetGains(const Voice& voice, float& left, float& right) const
+        {
+            if (voice.paused || voice.stopping)
+            {
+                left = right = 0.0f;
+                return;
+            }
+
+            float pan = clamp(voice.pan, -1.0f, 1.0f);
+            float volume = voice.volume * currentMasterVolume;
+
+            if (voice.channels == 1)
+            {
+                // constant power panning
+                float angle = (pan + 1.0f) * PI / 4.0f;
+                left = cosf(angle) * volume;
+                right = sinf(angle) * volume;
+            }
+            else
+            {
+                // balance
+                left = (pan > 0.0f ? 1.0f - pan : 1.0f) * volume;
+                right = (pan < 0.0f ? 1.0f + pan : 1.0f) * volume;
+            }
+        }
+    } // namespace audio
+} // namespace ouzel
@@ -0,0 +1,150 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <set>
+#include <mutex>
+#include <atomic>
+#include "utils/Noncopyable.h"
+#include "utils/Types.h"
+
+namespace ouzel
+{
+    namespace audio
+    {
+        /**
+         * Software mixer that mixes all playing sounds into one stereo stream.
+         * The play and control methods can be called from any thread, they are queued and applied at the start of the next process call.
+         * Process is called by the audio thread of the backend, but it can also be called directly to mix offline.
+         * The sound data and streams of finished voices are released by update, so that their destructors don't run on the audio thread.
+         */
+        class Mixer: public Noncopyable
+        {
+        public:
+            static const uint32_t BLOCK_SIZE = 256; // frames
+
+            Mixer(uint32_t aSampleRate = 44100, uint32_t aMaxVoices = 32);
+
+            uint32_t getSampleRate() const { return sampleRate; }
+            uint32_t getMaxVoices() const { return maxVoices; }
+
+            /**
+             * Returns the id of the voice or 0 if the sound data is not ready.
+             * If all voices are used, the voice with the lowest priority is stolen (the quietest one of voices with equal priority).
+             * The new voice is rejected if all the voices have a higher priority.
+             */
+            uint32_t play(const SoundDataPtr& soundData, bool repeat = false,
+                          float volume = 1.0f, float pitch = 1.0f, float pan = 0.0f, int32_t priority = 0);
+            // repeating is controlled by the stream
+            uint32_t play(const SoundStreamPtr& soundStream,
+                          float volume = 1.0f, float pitch = 1.0f, float pan = 0.0f, int32_t priority = 0);
+            void stop(uint32_t voiceId);
+            void pause(uint32_t voiceId);
+            void resume(uint32_t voiceId);
+            void setParameters(uint32_t voiceId, float volume, float pitch, float pan);
+            bool isPlaying(uint32_t voiceId) const; // true until the voice is finished, stopped, stolen or rejected
+
+            // releases the sound data and streams the audio thread has finished with, called by the engine every frame
+            void update();
+
+            void setMasterVolume(float newMasterVolume);
+            float getMasterVolume() const { return masterVolume; }
+
+            // output is interleaved stereo
+            void process(float* output, uint32_t frames);
+            void process(int16_t* output, uint32_t frames);
+
+            uint32_t getActiveVoiceCount() const { return activeVoiceCount; }
+            uint32_t getStolenVoiceCount() const { return stolenVoiceCount; }
+            uint32_t getRejectedVoiceCount() const { return rejectedVoiceCount; }
+
+        protected:
+            struct Command
+            {
+                enum class Type
+                {
+                    PLAY,
+                    STOP,
+                    PAUSE,
+                    RESUME,
+                    SET_PARAMETERS
+                };
+
+                Type type;
+                uint32_t voiceId;
+                SoundDataPtr soundData;
+                SoundStreamPtr soundStream;
+                bool repeat;
+                float volume;
+                float pitch;
+                float pan;
+                int32_t priority;
+            };
+
+            struct Voice
+            {
+                uint32_t id;
+                SoundDataPtr soundData;
+                SoundStreamPtr soundStream;
+                double position; // in source frames, relative to the last consumed frame for streams
+                float lastFrame[2]; // last frame read from the stream, needed for interpolation
+                float pendingFrame[2]; // frame read from the stream, but not consumed by the previous block
+                bool hasPendingFrame;
+                uint16_t channels;
+                bool repeat;
+                bool paused;
+                bool stopping;
+                float volume;
+                float pitch;
+                float pan;
+                int32_t priority;
+                float gainLeft; // gains at the end of the previous block
+                float gainRight;
+            };
+
+            void pushCommand(const Command& command);
+            void executeCommands();
+            void startVoice(Command& command);
+            void removeVoice(uint32_t index);
+            void mixBlock(uint32_t frames);
+            void publishFinishedVoices();
+            bool mixVoice(Voice& voice, uint32_t frames); // returns false when the voice has finished
+            uint32_t readSoundData(Voice& voice, uint32_t frames, bool& finished);
+            uint32_t readSoundStream(Voice& voice, uint32_t frames, bool& finished);
+            void getTargetGains(const Voice& voice, float& left, float& right) const;
+
+            uint32_t sampleRate;
+            uint32_t maxVoices;
+
+            mutable std::mutex commandMutex;
+            std::vector<Command> commands;
+            std::set<uint32_t> playingVoiceIds;
+            uint32_t lastVoiceId = 0;
+            std::vector<SoundDataPtr> finishedSoundData; // released by update
+            std::vector<SoundStreamPtr> finishedSoundStreams;
+
+            // audio thread only
+            std::vector<Command> processedCommands;
+            std::vector<Voice> voices;
+            std::vector<uint32_t> finishedVoiceIds;
+            std::vector<SoundDataPtr> releasedSoundData; // passed to the game thread by publishFinishedVoices
+            std::vector<SoundStreamPtr> releasedSoundStreams;
+            float currentMasterVolume = 1.0f;
+
+            std::vector<float> buffer;
+            float* accumulatorLeft;
+            float* accumulatorRight;
+            float* sourceLeft;
+            float* sourceRight;
+            std::vector<float> streamBuffer;
+
+            std::atomic<float> masterVolume;
+            std::atomic<uint32_t> activeVoiceCount;
+            std::atomic<uint32_t> stolenVoiceCount;
+            std::atomic<uint32_t> rejectedVoiceCount;
+        };
+    } // namespace audio
+} // namespace ouzel
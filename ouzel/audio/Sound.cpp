@@ -2,6 +2,9 @@
 // This file is part of the Ouzel engine.
 
 #include "Sound.h"
+#include "Audio.h"
+#include "SoundStream.h"
+#include "core/Engine.h"
 
 namespace ouzel
 {
@@ -13,16 +16,36 @@ namespace ouzel
 
         Sound::~Sound()
         {
+            if (voiceId && sharedEngine && sharedEngine->getAudio())
+            {
+                sharedEngine->getAudio()->getMixer().stop(voiceId);
+            }
         }
 
         void Sound::free()
         {
+            reset();
+
             ready = false;
         }
 
         bool Sound::init(const SoundDataPtr& newSoundData)
         {
+            free();
+
             soundData = newSoundData;
+            soundStream.reset();
+            ready = true;
+
+            return true;
+        }
+
+        bool Sound::init(const SoundStreamPtr& newSoundStream)
+        {
+            free();
+
+            soundData.reset();
+            soundStream = newSoundStream;
             ready = true;
 
             return true;
@@ -30,18 +53,53 @@ namespace ouzel
 
         bool Sound::play(bool repeatSound)
         {
+            if (!ready)
+            {
+                return false;
+            }
+
+            Mixer& mixer = sharedEngine->getAudio()->getMixer();
+
+            if (paused && repeatSound == repeat && mixer.isPlaying(voiceId))
+            {
+                mixer.resume(voiceId);
+                paused = false;
+
+                return true;
+            }
+
             repeat = repeatSound;
 
-            stop(true);
+            if (soundStream)
+            {
+                soundStream->setRepeat(repeat);
 
-            return true;
+                // rewinds the stream if it has been played before
+                stop(true);
+
+                voiceId = mixer.play(soundStream, volume, pitch, pan, priority);
+            }
+            else
+            {
+                stop(true);
+
+                voiceId = mixer.play(soundData, repeat, volume, pitch, pan, priority);
+            }
+
+            return voiceId != 0;
         }
 
         bool Sound::stop(bool resetSound)
         {
             if (resetSound)
             {
-                reset();
+                return reset();
+            }
+
+            if (voiceId)
+            {
+                sharedEngine->getAudio()->getMixer().pause(voiceId);
+                paused = true;
             }
 
             return true;
@@ -49,7 +107,49 @@ namespace ouzel
 
         bool Sound::reset()
         {
+            if (voiceId)
+            {
+                sharedEngine->getAudio()->getMixer().stop(voiceId);
+                voiceId = 0;
+
+                // a fresh stream is not rewound, so that the data the decoder has already buffered isn't discarded
+                if (soundStream) soundStream->seek(0.0f);
+            }
+
+            paused = false;
+
             return true;
         }
+
+        bool Sound::isPlaying() const
+        {
+            return voiceId && !paused && sharedEngine->getAudio()->getMixer().isPlaying(voiceId);
+        }
+
+        void Sound::setVolume(float newVolume)
+        {
+            volume = newVolume;
+            updateParameters();
+        }
+
+        void Sound::setPitch(float newPitch)
+        {
+            pitch = newPitch;
+            updateParameters();
+        }
+
+        void Sound::setPan(float newPan)
+        {
+            pan = newPan;
+            updateParameters();
+        }
+
+        void Sound::updateParameters()
+        {
+            if (voiceId)
+            {
+                sharedEngine->getAudio()->getMixer().setParameters(voiceId, volume, pitch, pan);
+            }
+        }
     } // namespace audio
 } // namespace ouzel
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include "utils/Types.h"
 
 namespace ouzel
@@ -11,6 +12,10 @@ namespace ouzel
     {
         class Audio;
 
+        /**
+         * Handle of a mixer voice that plays the sound data.
+         * Any number of sounds can share the same sound data.
+         */
         class Sound
         {
             friend Audio;
@@ -19,22 +24,50 @@ namespace ouzel
             virtual void free();
 
             virtual bool init(const SoundDataPtr& newSoundData);
+            virtual bool init(const SoundStreamPtr& newSoundStream);
 
             const SoundDataPtr& getSoundData() const { return soundData; }
+            const SoundStreamPtr& getSoundStream() const { return soundStream; }
 
-            virtual bool play(bool repeatSound = false);
-            virtual bool stop(bool resetSound = false);
+            virtual bool play(bool repeatSound = false); // resumes the sound if it was paused, otherwise starts it from the beginning
+            virtual bool stop(bool resetSound = false); // pauses the sound if resetSound is false
             virtual bool reset();
 
             bool isRepeating() const { return repeat; }
+            bool isPlaying() const;
+
+            void setVolume(float newVolume);
+            float getVolume() const { return volume; }
+
+            void setPitch(float newPitch);
+            float getPitch() const { return pitch; }
+
+            // -1 is left and 1 is right
+            void setPan(float newPan);
+            float getPan() const { return pan; }
+
+            // voices with a lower priority are stolen first when all the voices are used
+            void setPriority(int32_t newPriority) { priority = newPriority; }
+            int32_t getPriority() const { return priority; }
 
             bool isReady() const { return ready; }
 
         protected:
             Sound();
 
+            void updateParameters();
+
             SoundDataPtr soundData;
+            SoundStreamPtr soundStream;
             bool repeat = false;
+            bool paused = false;
+
+            float volume = 1.0f;
+            float pitch = 1.0f;
+            float pan = 0.0f;
+            int32_t priority = 0;
+
+            uint32_t voiceId = 0;
 
             bool ready = false;
         };
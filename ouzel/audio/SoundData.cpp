@@ -1,6 +1,7 @@
 // Copyright (C) 2016 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <cstring>
 #include "SoundData.h"
 #include "core/Engine.h"
 #include "utils/Utils.h"
@@ -19,7 +20,7 @@ namespace ouzel
 
         void SoundData::free()
         {
-            data.clear();
+            samples.clear();
 
             ready = false;
         }
@@ -82,6 +83,8 @@ namespace ouzel
 
             bool foundChunkFound = false;
             bool dataChunkFound = false;
+            uint32_t dataOffset = 0;
+            uint32_t dataSize = 0;
 
             for (; offset < newData.size();)
             {
@@ -121,7 +124,7 @@ namespace ouzel
                     formatTag = readUInt16Little(newData.data() + i);
                     i += 2;
 
-                    if (formatTag != 1)
+                    if (formatTag != 1 && formatTag != 3) // PCM or IEEE float
                     {
                         log("Failed to load sound file. Bad format tag.");
                         return false;
@@ -146,7 +149,8 @@ namespace ouzel
                 }
                 else if (chunkHeader[0] == 'd' && chunkHeader[1] == 'a' && chunkHeader[2] == 't' && chunkHeader[3] == 'a')
                 {
-                    data.assign(newData.begin() + offset, newData.begin() + offset + chunkSize);
+                    dataOffset = offset;
+                    dataSize = chunkSize;
 
                     dataChunkFound = true;
                 }
@@ -166,9 +170,68 @@ namespace ouzel
                 return false;
             }
 
+            if (channels == 0 || !isFormatSupported(formatTag, bitsPerSample))
+            {
+                log("Failed to load sound file. Unsupported sample format.");
+                return false;
+            }
+
+            // the mixer works with floats, so the samples are converted once here instead of on every play
+            if (dataOffset + dataSize > newData.size())
+            {
+                log("Failed to load sound file. Data chunk is too big.");
+                return false;
+            }
+
+            const uint8_t* sampleData = newData.data() + dataOffset;
+            uint32_t bytesPerSample = bitsPerSample / 8;
+            uint32_t sampleCount = (dataSize / (bytesPerSample * channels)) * channels;
+
+            samples.resize(sampleCount);
+
+            for (uint32_t i = 0; i < sampleCount; ++i, sampleData += bytesPerSample)
+            {
+                samples[i] = decodeSample(sampleData, formatTag, bitsPerSample);
+            }
+
             ready = true;
 
             return true;
         }
+
+        bool SoundData::isFormatSupported(uint16_t formatTag, uint16_t bitsPerSample)
+        {
+            return (formatTag == 1 && (bitsPerSample == 8 || bitsPerSample == 16 || bitsPerSample == 24 || bitsPerSample == 32)) ||
+                (formatTag == 3 && bitsPerSample == 32);
+        }
+
+        float SoundData::decodeSample(const uint8_t* sampleData, uint16_t formatTag, uint16_t bitsPerSample)
+        {
+            switch (bitsPerSample)
+            {
+                case 8:
+                    return (static_cast<float>(sampleData[0]) - 128.0f) / 128.0f;
+                case 16:
+                    return static_cast<float>(static_cast<int16_t>(readUInt16Little(sampleData))) / 32768.0f;
+                case 24:
+                    return static_cast<float>(static_cast<int32_t>(static_cast<uint32_t>(sampleData[0]) << 8 |
+                                                                   static_cast<uint32_t>(sampleData[1]) << 16 |
+                                                                   static_cast<uint32_t>(sampleData[2]) << 24)) / 2147483648.0f;
+                case 32:
+                    if (formatTag == 3)
+                    {
+                        float result;
+                        uint32_t bits = readUInt32Little(sampleData);
+                        memcpy(&result, &bits, sizeof(float));
+                        return result;
+                    }
+                    else
+                    {
+                        return static_cast<float>(static_cast<int32_t>(readUInt32Little(sampleData))) / 2147483648.0f;
+                    }
+                default:
+                    return 0.0f;
+            }
+        }
     } // namespace audio
 } // namespace ouzel
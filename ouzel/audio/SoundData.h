@@ -23,7 +23,10 @@ namespace ouzel
             virtual bool initFromFile(const std::string& newFilename);
             virtual bool initFromBuffer(const std::vector<uint8_t>& newData);
 
-            const std::vector<uint8_t>& getData() const { return data; }
+            // interleaved samples in the range [-1, 1], converted from the PCM data of the file
+            const std::vector<float>& getSamples() const { return samples; }
+            uint32_t getFrameCount() const { return channels ? static_cast<uint32_t>(samples.size() / channels) : 0; }
+            size_t getSize() const { return samples.size() * sizeof(float); } // decoded size in bytes
 
             uint16_t getFormatTag() const { return formatTag; }
             uint16_t getChannels() const { return channels; }
@@ -34,6 +37,10 @@ namespace ouzel
 
             bool isReady() const { return ready; }
 
+            // PCM (format tag 1) with 8, 16, 24 or 32 bits per sample and IEEE float (format tag 3) with 32 bits per sample
+            static bool isFormatSupported(uint16_t formatTag, uint16_t bitsPerSample);
+            static float decodeSample(const uint8_t* sampleData, uint16_t formatTag, uint16_t bitsPerSample);
+
         protected:
             SoundData();
 
@@ -46,7 +53,7 @@ namespace ouzel
             uint16_t blockAlign = 0;
             uint16_t bitsPerSample = 0;
 
-            std::vector<uint8_t> data;
+            std::vector<float> samples;
 
             bool ready = false;
         };
@@ -0,0 +1,362 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include "SoundStream.h"
+#include "SoundData.h"
+#include "core/Engine.h"
+#include "files/FileSystem.h"
+#include "utils/Utils.h"
+
+#define STB_VORBIS_NO_PUSHDATA_API
+#include "stb_vorbis.c"
+
+namespace ouzel
+{
+    namespace audio
+    {
+        const uint32_t SoundStream::CHUNK_FRAMES;
+        const uint32_t SoundStream::RING_FRAMES;
+
+        SoundStream::SoundStream():
+            readPosition(0), writePosition(0), discardPosition(0), discard(false), endOfStream(false),
+            repeat(false), seekFrame(0), seekRequested(false), running(false)
+        {
+        }
+
+        SoundStream::~SoundStream()
+        {
+            free();
+        }
+
+        void SoundStream::free()
+        {
+            running = false;
+            decoderCondition.notify_all();
+
+            if (decoderThread.joinable())
+            {
+                decoderThread.join();
+            }
+
+            if (vorbis)
+            {
+                stb_vorbis_close(vorbis);
+                vorbis = nullptr;
+            }
+
+            if (file.is_open())
+            {
+                file.close();
+            }
+
+            ring.clear();
+            chunk.clear();
+
+            ready = false;
+        }
+
+        bool SoundStream::initFromFile(const std::string& newFilename, bool newRepeat)
+        {
+            free();
+
+            filename = newFilename;
+            repeat = newRepeat;
+
+            const FileSystemPtr& fileSystem = sharedEngine->getFileSystem();
+            std::string path = fileSystem->isAbsolutePath(filename) ? filename : fileSystem->getPath(filename);
+
+            if (path.empty())
+            {
+                log("Failed to find file %s", filename.c_str());
+                return false;
+            }
+
+            std::string extension = fileSystem->getExtensionPart(filename);
+            std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+            if (!(extension == "ogg" ? openVorbis(path) : openWave(path)))
+            {
+                return false;
+            }
+
+            chunk.resize(CHUNK_FRAMES * channels);
+            ring.resize(RING_FRAMES * channels);
+            readPosition = 0;
+            writePosition = 0;
+            discard = false;
+            endOfStream = false;
+            seekRequested = false;
+
+            running = true;
+            decoderThread = std::thread(&SoundStream::run, this);
+
+            ready = true;
+
+            return true;
+        }
+
+        bool SoundStream::openWave(const std::string& path)
+        {
+            file.open(path, std::ios::binary);
+
+            if (!file)
+            {
+                log("Failed to open file %s", path.c_str());
+                return false;
+            }
+
+            uint8_t header[12];
+
+            if (!file.read(reinterpret_cast<char*>(header), sizeof(header)) ||
+                header[0] != 'R' || header[1] != 'I' || header[2] != 'F' || header[3] != 'F' ||
+                header[8] != 'W' || header[9] != 'A' || header[10] != 'V' || header[11] != 'E')
+            {
+                log("Failed to load sound file. Not a WAVE file.");
+                return false;
+            }
+
+            bool formatChunkFound = false;
+
+            // only the headers are read, the samples are read by the decoder thread
+            for (;;)
+            {
+                uint8_t chunkHeader[8];
+
+                if (!file.read(reinterpret_cast<char*>(chunkHeader), sizeof(chunkHeader)))
+                {
+                    log("Failed to load sound file. Failed to find a data chunk.");
+                    return false;
+                }
+
+                uint32_t chunkSize = readUInt32Little(chunkHeader + 4);
+
+                if (chunkHeader[0] == 'f' && chunkHeader[1] == 'm' && chunkHeader[2] == 't' && chunkHeader[3] == ' ')
+                {
+                    uint8_t format[16];
+
+                    if (chunkSize < sizeof(format) || !file.read(reinterpret_cast<char*>(format), sizeof(format)))
+                    {
+                        log("Failed to load sound file. Not enough data to read chunk.");
+                        return false;
+                    }
+
+                    formatTag = readUInt16Little(format);
+                    fileChannels = readUInt16Little(format + 2);
+                    sampleRate = readUInt32Little(format + 4);
+                    bitsPerSample = readUInt16Little(format + 14);
+
+                    if (fileChannels == 0 || !SoundData::isFormatSupported(formatTag, bitsPerSample))
+                    {
+                        log("Failed to load sound file. Unsupported sample format.");
+                        return false;
+                    }
+
+                    file.seekg(((chunkSize + 1) & 0xFFFFFFFE) - sizeof(format), std::ios::cur);
+                    formatChunkFound = true;
+                }
+                else if (chunkHeader[0] == 'd' && chunkHeader[1] == 'a' && chunkHeader[2] == 't' && chunkHeader[3] == 'a')
+                {
+                    if (!formatChunkFound)
+                    {
+                        log("Failed to load sound file. Failed to find a format chunk.");
+                        return false;
+                    }
+
+                    dataOffset = static_cast<uint32_t>(file.tellg());
+                    frameCount = chunkSize / (fileChannels * bitsPerSample / 8);
+                    break;
+                }
+                else
+                {
+                    file.seekg((chunkSize + 1) & 0xFFFFFFFE, std::ios::cur);
+                }
+            }
+
+            channels = std::min(fileChannels, static_cast<uint16_t>(2));
+            fileBuffer.resize(CHUNK_FRAMES * fileChannels * bitsPerSample / 8);
+            currentFrame = 0;
+
+            return true;
+        }
+
+        bool SoundStream::openVorbis(const std::string& path)
+        {
+            int error = 0;
+            vorbis = stb_vorbis_open_filename(path.c_str(), &error, nullptr);
+
+            if (!vorbis)
+            {
+                log("Failed to load Ogg Vorbis file %s (error %d)", path.c_str(), error);
+                return false;
+            }
+
+            stb_vorbis_info info = stb_vorbis_get_info(vorbis);
+
+            channels = static_cast<uint16_t>(std::min(info.channels, 2));
+            sampleRate = info.sample_rate;
+            frameCount = stb_vorbis_stream_length_in_samples(vorbis);
+
+            return true;
+        }
+
+        void SoundStream::seek(float time)
+        {
+            seekFrame = static_cast<uint32_t>(std::max(time, 0.0f) * sampleRate);
+            seekRequested = true;
+            decoderCondition.notify_one();
+        }
+
+        uint32_t SoundStream::read(float* output, uint32_t frames)
+        {
+            if (!ready)
+            {
+                return 0;
+            }
+
+            // skip the data that was decoded before the last seek
+            if (discard.exchange(false))
+            {
+                readPosition = discardPosition.load();
+            }
+
+            uint32_t position = readPosition;
+            uint32_t count = std::min(frames, writePosition - position);
+
+            for (uint32_t i = 0; i < count;)
+            {
+                uint32_t index = (position + i) % RING_FRAMES;
+                uint32_t part = std::min(count - i, RING_FRAMES - index);
+                std::copy(ring.begin() + index * channels, ring.begin() + (index + part) * channels, output + i * channels);
+                i += part;
+            }
+
+            readPosition = position + count;
+
+            if (count)
+            {
+                decoderCondition.notify_one();
+            }
+
+            return count;
+        }
+
+        bool SoundStream::isFinished() const
+        {
+            return !ready || (endOfStream && !seekRequested && !discard && readPosition == writePosition);
+        }
+
+        void SoundStream::rewind(uint32_t frame)
+        {
+            if (vorbis)
+            {
+                stb_vorbis_seek(vorbis, frame);
+            }
+            else
+            {
+                currentFrame = std::min(frame, frameCount);
+                file.clear();
+                file.seekg(dataOffset + currentFrame * fileChannels * (bitsPerSample / 8));
+            }
+        }
+
+        uint32_t SoundStream::decode(float* output, uint32_t frames)
+        {
+            if (vorbis)
+            {
+                // stb_vorbis mixes more channels down to the requested count
+                return static_cast<uint32_t>(stb_vorbis_get_samples_float_interleaved(vorbis, channels, output, static_cast<int>(frames * channels)));
+            }
+
+            uint32_t bytesPerSample = bitsPerSample / 8;
+            frames = std::min(frames, frameCount - currentFrame);
+
+            if (!file.read(reinterpret_cast<char*>(fileBuffer.data()), frames * fileChannels * bytesPerSample))
+            {
+                frames = static_cast<uint32_t>(file.gcount() / (fileChannels * bytesPerSample));
+            }
+
+            const uint8_t* sampleData = fileBuffer.data();
+
+            for (uint32_t frame = 0; frame < frames; ++frame)
+            {
+                for (uint16_t channel = 0; channel < channels; ++channel)
+                {
+                    *output++ = SoundData::decodeSample(sampleData + channel * bytesPerSample, formatTag, bitsPerSample);
+                }
+
+                sampleData += fileChannels * bytesPerSample;
+            }
+
+            currentFrame += frames;
+
+            return frames;
+        }
+
+        void SoundStream::run()
+        {
+            while (running)
+            {
+                if (seekRequested)
+                {
+                    // the stream must not appear finished between the request and the discard
+                    endOfStream = false;
+                    seekRequested = false;
+
+                    rewind(seekFrame);
+                    discardPosition = writePosition.load();
+                    discard = true;
+                }
+
+                if (endOfStream || RING_FRAMES - (writePosition - readPosition) < CHUNK_FRAMES)
+                {
+                    std::unique_lock<std::mutex> lock(decoderMutex);
+                    decoderCondition.wait_for(lock, std::chrono::milliseconds(10));
+                    continue;
+                }
+
+                uint32_t frames = 0;
+                bool rewound = false;
+                bool finished = false;
+
+                while (frames < CHUNK_FRAMES)
+                {
+                    uint32_t decoded = decode(chunk.data() + frames * channels, CHUNK_FRAMES - frames);
+                    frames += decoded;
+
+                    if (frames < CHUNK_FRAMES)
+                    {
+                        // continue from the beginning in the same chunk, so that there is no gap in the loop
+                        if (!repeat || (decoded == 0 && rewound))
+                        {
+                            finished = true;
+                            break;
+                        }
+
+                        rewind(0);
+                        rewound = true;
+                    }
+                }
+
+                uint32_t position = writePosition;
+
+                for (uint32_t i = 0; i < frames;)
+                {
+                    uint32_t index = (position + i) % RING_FRAMES;
+                    uint32_t part = std::min(frames - i, RING_FRAMES - index);
+                    std::copy(chunk.begin() + i * channels, chunk.begin() + (i + part) * channels, ring.begin() + index * channels);
+                    i += part;
+                }
+
+                writePosition = position + frames;
+
+                if (finished)
+                {
+                    endOfStream = true;
+                }
+            }
+        }
+    } // namespace audio
+} // namespace ouzel
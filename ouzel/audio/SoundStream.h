@@ -0,0 +1,104 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "utils/Noncopyable.h"
+
+struct stb_vorbis;
+
+namespace ouzel
+{
+    namespace audio
+    {
+        class Audio;
+
+        /**
+         * Sound source that decodes a WAV or Ogg Vorbis file on a background thread into a small ring buffer,
+         * so that only a fraction of a second of the sound is kept in memory.
+         * A stream can be played by only one sound at a time.
+         */
+        class SoundStream: public Noncopyable
+        {
+            friend Audio;
+        public:
+            static const uint32_t CHUNK_FRAMES = 4096;
+            static const uint32_t RING_FRAMES = CHUNK_FRAMES * 4;
+
+            virtual ~SoundStream();
+            virtual void free();
+
+            virtual bool initFromFile(const std::string& newFilename, bool newRepeat = false);
+
+            // a repeating stream continues from the beginning without a gap when the end is reached
+            void setRepeat(bool newRepeat) { repeat = newRepeat; }
+            bool isRepeating() const { return repeat; }
+
+            void seek(float time);
+
+            uint16_t getChannels() const { return channels; } // 1 or 2, more channels are mixed down to stereo
+            uint32_t getSampleRate() const { return sampleRate; }
+            float getDuration() const { return sampleRate ? static_cast<float>(frameCount) / sampleRate : 0.0f; }
+
+            // called by the mixer, reads up to the given number of interleaved frames and returns the number of frames read
+            uint32_t read(float* output, uint32_t frames);
+            bool isFinished() const;
+
+            bool isReady() const { return ready; }
+
+        protected:
+            SoundStream();
+
+            bool openWave(const std::string& path);
+            bool openVorbis(const std::string& path);
+            void rewind(uint32_t frame);
+            uint32_t decode(float* output, uint32_t frames);
+            void run();
+
+            std::string filename;
+
+            uint16_t channels = 0;
+            uint32_t sampleRate = 0;
+            uint32_t frameCount = 0;
+
+            // WAV
+            std::ifstream file;
+            uint16_t fileChannels = 0;
+            uint16_t formatTag = 0;
+            uint16_t bitsPerSample = 0;
+            uint32_t dataOffset = 0;
+            uint32_t currentFrame = 0;
+            std::vector<uint8_t> fileBuffer;
+
+            // Ogg Vorbis
+            stb_vorbis* vorbis = nullptr;
+
+            std::vector<float> chunk;
+            std::vector<float> ring;
+            std::atomic<uint32_t> readPosition; // in frames, wraps around
+            std::atomic<uint32_t> writePosition;
+            std::atomic<uint32_t> discardPosition;
+            std::atomic<bool> discard;
+            std::atomic<bool> endOfStream;
+
+            std::atomic<bool> repeat;
+            std::atomic<uint32_t> seekFrame;
+            std::atomic<bool> seekRequested;
+
+            std::atomic<bool> running;
+            std::thread decoderThread;
+            std::mutex decoderMutex;
+            std::condition_variable decoderCondition;
+
+            bool ready = false;
+        };
+    } // namespace audio
+} // namespace ouzel
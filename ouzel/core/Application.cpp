@@ -49,6 +49,10 @@ namespace ouzel
         executeQueue.push(func);
     }
 
+    void Application::wakeUp()
+    {
+    }
+
     void Application::executeAll()
     {
         std::function<void(void)> func;
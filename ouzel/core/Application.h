@@ -28,6 +28,9 @@ namespace ouzel
 
         virtual void execute(const std::function<void(void)>& func);
 
+        // interrupts the wait of the main loop, called when the engine has a new frame or its state changes
+        virtual void wakeUp();
+
     protected:
         void executeAll();
 
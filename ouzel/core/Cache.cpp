@@ -11,6 +11,8 @@
 #include "graphics/Shader.h"
 #include "scene/ParticleDefinition.h"
 #include "scene/SpriteFrame.h"
+#include "audio/Audio.h"
+#include "audio/SoundData.h"
 #include "utils/Utils.h"
 
 namespace ouzel
@@ -219,4 +221,117 @@ namespace ouzel
     {
         blendStates[blendStateName] = blendState;
     }
+
+    void Cache::preloadSoundData(const std::string& filename)
+    {
+        getSoundData(filename);
+    }
+
+    audio::SoundDataPtr Cache::getSoundData(const std::string& filename) const
+    {
+        std::unordered_map<std::string, CachedSoundData>::iterator i = soundData.find(filename);
+
+        if (i != soundData.end())
+        {
+            i->second.lastUse = ++soundDataUseCounter;
+            return i->second.soundData;
+        }
+
+        audio::SoundDataPtr result = sharedEngine->getAudio()->createSoundData();
+
+        if (!result->initFromFile(filename))
+        {
+            return nullptr;
+        }
+
+        soundData[filename] = { result, ++soundDataUseCounter };
+
+        evictSoundData();
+
+        return result;
+    }
+
+    void Cache::setSoundData(const std::string& filename, const audio::SoundDataPtr& newSoundData)
+    {
+        soundData[filename] = { newSoundData, ++soundDataUseCounter };
+
+        evictSoundData();
+    }
+
+    void Cache::releaseSoundData()
+    {
+        soundData.clear();
+    }
+
+    void Cache::setSoundDataBudget(size_t newSoundDataBudget)
+    {
+        soundDataBudget = newSoundDataBudget;
+
+        evictSoundData();
+    }
+
+    void Cache::update()
+    {
+        evictSoundData();
+    }
+
+    void Cache::releaseUnusedSoundData()
+    {
+        for (std::unordered_map<std::string, CachedSoundData>::iterator i = soundData.begin(); i != soundData.end();)
+        {
+            if (i->second.soundData.use_count() <= 1)
+            {
+                i = soundData.erase(i);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+
+    size_t Cache::getSoundDataSize() const
+    {
+        size_t size = 0;
+
+        for (const auto& i : soundData)
+        {
+            if (i.second.soundData) size += i.second.soundData->getSize();
+        }
+
+        return size;
+    }
+
+    void Cache::evictSoundData() const
+    {
+        if (soundDataBudget == 0)
+        {
+            return;
+        }
+
+        size_t size = getSoundDataSize();
+
+        while (size > soundDataBudget)
+        {
+            // only the sound data that is referenced by the cache alone can be released
+            std::unordered_map<std::string, CachedSoundData>::iterator oldest = soundData.end();
+
+            for (std::unordered_map<std::string, CachedSoundData>::iterator i = soundData.begin(); i != soundData.end(); ++i)
+            {
+                if (i->second.soundData.use_count() <= 1 &&
+                    (oldest == soundData.end() || i->second.lastUse < oldest->second.lastUse))
+                {
+                    oldest = i;
+                }
+            }
+
+            if (oldest == soundData.end())
+            {
+                break;
+            }
+
+            if (oldest->second.soundData) size -= oldest->second.soundData->getSize();
+            soundData.erase(oldest);
+        }
+    }
 }
@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <cstdint>
 #include "utils/Types.h"
 #include "utils/Noncopyable.h"
 
@@ -36,11 +37,40 @@ namespace ouzel
         graphics::BlendStatePtr getBlendState(const std::string& blendStateName) const;
         void setBlendState(const std::string& blendStateName, const graphics::BlendStatePtr& blendState);
 
+        void preloadSoundData(const std::string& filename);
+        audio::SoundDataPtr getSoundData(const std::string& filename) const;
+        void setSoundData(const std::string& filename, const audio::SoundDataPtr& newSoundData);
+        void releaseSoundData();
+
+        /**
+         * When the decoded size of the cached sound data exceeds the budget (in bytes), the least recently used
+         * sound data that is not referenced outside of the cache is released. 0 means no budget.
+         */
+        void setSoundDataBudget(size_t newSoundDataBudget);
+        size_t getSoundDataBudget() const { return soundDataBudget; }
+        size_t getSoundDataSize() const;
+
+        // sound data becomes evictable when the mixer releases it, called by the engine every frame
+        void update();
+        // releases the sound data that is not referenced outside of the cache regardless of the budget
+        void releaseUnusedSoundData();
+
     protected:
+        struct CachedSoundData
+        {
+            audio::SoundDataPtr soundData;
+            uint64_t lastUse;
+        };
+
+        void evictSoundData() const;
+
         mutable std::unordered_map<std::string, graphics::TexturePtr> textures;
         mutable std::unordered_map<std::string, graphics::ShaderPtr> shaders;
         mutable std::unordered_map<std::string, scene::ParticleDefinitionPtr> particleDefinitions;
         mutable std::unordered_map<std::string, graphics::BlendStatePtr> blendStates;
         mutable std::unordered_map<std::string, std::vector<scene::SpriteFramePtr>> spriteFrames;
+        mutable std::unordered_map<std::string, CachedSoundData> soundData;
+        mutable uint64_t soundDataUseCounter = 0;
+        size_t soundDataBudget = 0;
     };
 }
@@ -2,15 +2,26 @@
 // This file is part of the Ouzel engine.
 
 #include <algorithm>
+#include <cmath>
 #include <thread>
+#include <chrono>
 #include "Engine.h"
 #include "CompileConfig.h"
+#include "Application.h"
+#include "Window.h"
 #include "Cache.h"
+#include "WorkerPool.h"
+#include "TimerManager.h"
 #include "localization/Localization.h"
+#include "math/MathUtils.h"
+#include "utils/Random.h"
 #include "utils/Utils.h"
 #include "graphics/Renderer.h"
+#include "graphics/RendererEmpty.h"
 #include "audio/Audio.h"
 #include "files/FileSystem.h"
+#include "scene/ParticleManager.h"
+#include "animators/AnimationSystem.h"
 
 #if OUZEL_PLATFORM_MACOS
 #include "macos/WindowMacOS.h"
@@ -72,17 +83,26 @@ namespace ouzel
     ouzel::Engine* sharedEngine = nullptr;
 
     Engine::Engine():
-        running(false), active(true), currentFPS(0.0f), accumulatedFPS(0.0f)
+        running(false), active(true), currentFPS(0.0f), accumulatedFPS(0.0f), updateLoad(0.0f), latency(0.0f),
+        frameId(0), presentedFrameId(0), randomSeed(0), randomSeedPending(false)
     {
         sharedEngine = this;
     }
 
     Engine::~Engine()
     {
-        running = false;
-        active = false;
+        {
+            std::lock_guard<std::mutex> lock(frameMutex);
+            running = false;
+            active = false;
+        }
+
+        frameCondition.notify_all();
 
         updateThread.join();
+
+        // stop the input thread before the renderer and the window it reads from are destroyed
+        input.reset();
     }
 
     std::set<graphics::Renderer::Driver> Engine::getAvailableDrivers()
@@ -91,6 +111,8 @@ namespace ouzel
 
         if (availableDrivers.empty())
         {
+            availableDrivers.insert(graphics::Renderer::Driver::NONE);
+
 #if OUZEL_SUPPORTS_OPENGL || OUZEL_SUPPORTS_OPENGLES
             availableDrivers.insert(graphics::Renderer::Driver::OPENGL);
 #endif
@@ -114,6 +136,14 @@ namespace ouzel
     {
         settings = newSettings;
 
+        fixedTimeStep = (settings.updateRate > 0.0f) ? 1.0f / settings.updateRate : 0.0f;
+
+        // nothing would ever be updated without at least one step per frame
+        if (settings.maxUpdateSteps == 0)
+        {
+            settings.maxUpdateSteps = 1;
+        }
+
         if (!settings.verticalSync && settings.targetFPS > 0.0f)
         {
             targetFrameInterval = static_cast<uint64_t>(1000000L * (1.0f / settings.targetFPS));
@@ -146,45 +176,70 @@ namespace ouzel
             }
         }
 
+        if (settings.driver == graphics::Renderer::Driver::NONE)
+        {
+            // nothing is shown, the window only provides the size
+            Size2 size = (settings.size.width > 0.0f && settings.size.height > 0.0f) ? settings.size : Size2(800.0f, 600.0f);
+            window.reset(new Window(size, settings.resizable, settings.fullscreen, settings.title));
+        }
+        else
+        {
 #if OUZEL_PLATFORM_MACOS
-        window.reset(new WindowMacOS(settings.size, settings.resizable, settings.fullscreen, settings.title));
+            window.reset(new WindowMacOS(settings.size, settings.resizable, settings.fullscreen, settings.title));
 #elif OUZEL_PLATFORM_IOS
-        window.reset(new WindowIOS(settings.size, settings.resizable, settings.fullscreen, settings.title));
+            window.reset(new WindowIOS(settings.size, settings.resizable, settings.fullscreen, settings.title));
 #elif OUZEL_PLATFORM_TVOS
-        window.reset(new WindowTVOS(settings.size, settings.resizable, settings.fullscreen, settings.title));
+            window.reset(new WindowTVOS(settings.size, settings.resizable, settings.fullscreen, settings.title));
 #elif OUZEL_PLATFORM_ANDROID
-        window.reset(new WindowAndroid(settings.size, settings.resizable, settings.fullscreen, settings.title));
+            window.reset(new WindowAndroid(settings.size, settings.resizable, settings.fullscreen, settings.title));
 #elif OUZEL_PLATFORM_LINUX
-        window.reset(new WindowLinux(settings.size, settings.resizable, settings.fullscreen, settings.title));
+            window.reset(new WindowLinux(settings.size, settings.resizable, settings.fullscreen, settings.title));
 #elif OUZEL_PLATFORM_WINDOWS
-        window.reset(new WindowWin(settings.size, settings.resizable, settings.fullscreen, settings.title));
+            window.reset(new WindowWin(settings.size, settings.resizable, settings.fullscreen, settings.title));
 #elif OUZEL_PLATFORM_RASPBIAN
-        window.reset(new WindowRPI(settings.size, settings.resizable, settings.fullscreen, settings.title));
+            window.reset(new WindowRPI(settings.size, settings.resizable, settings.fullscreen, settings.title));
 #endif
+        }
 
         eventDispatcher.reset(new EventDispatcher());
         cache.reset(new Cache());
         fileSystem.reset(new FileSystem());
+        particleManager.reset(new scene::ParticleManager());
+        animationSystem.reset(new scene::AnimationSystem());
         sceneManager.reset(new scene::SceneManager());
+        workerPool.reset(new WorkerPool(settings.threadCount));
+        timerManager.reset(new TimerManager());
 
+        if (settings.driver == graphics::Renderer::Driver::NONE)
+        {
+            // without a window there is no platform input, it can only be replayed
+            input.reset(new input::Input());
+        }
+        else
+        {
 #if OUZEL_PLATFORM_MACOS || OUZEL_PLATFORM_IOS || OUZEL_PLATFORM_TVOS
-        input.reset(new input::InputApple());
+            input.reset(new input::InputApple());
 #elif OUZEL_PLATFORM_ANDROID
-        input.reset(new input::InputAndroid());
+            input.reset(new input::InputAndroid());
 #elif OUZEL_PLATFORM_LINUX
-        input.reset(new input::InputLinux());
+            input.reset(new input::InputLinux());
 #elif OUZEL_PLATFORM_WINDOWS
-        input.reset(new input::InputWin());
+            input.reset(new input::InputWin());
 #elif OUZEL_PLATFORM_RASPBIAN
-        input.reset(new input::InputRPI());
+            input.reset(new input::InputRPI());
 #else
-        input.reset(new input::Input());
+            input.reset(new input::Input());
 #endif
+        }
 
         localization.reset(new Localization());
 
         switch (settings.driver)
         {
+            case graphics::Renderer::Driver::NONE:
+                log("Using empty render driver");
+                renderer.reset(new graphics::RendererEmpty());
+                break;
 #if OUZEL_SUPPORTS_OPENGL || OUZEL_SUPPORTS_OPENGLES
             case graphics::Renderer::Driver::OPENGL:
                 log("Using OpenGL render driver");
@@ -234,25 +289,49 @@ namespace ouzel
             return false;
         }
 
+        if (settings.driver == graphics::Renderer::Driver::NONE)
+        {
+            audio.reset(new audio::Audio());
+        }
+        else
+        {
 #if OUZEL_SUPPORTS_OPENAL
     #if OUZEL_PLATFORM_MACOS || OUZEL_PLATFORM_IOS || OUZEL_PLATFORM_TVOS
-        audio.reset(new audio::AudioALApple());
+            audio.reset(new audio::AudioALApple());
     #else
-        audio.reset(new audio::AudioAL());
+            audio.reset(new audio::AudioAL());
     #endif
 #elif OUZEL_SUPPORTS_XAUDIO2
-        audio.reset(new audio::AudioXA2());
+            audio.reset(new audio::AudioXA2());
 #elif OUZEL_SUPPORTS_OPENSL
-        audio.reset(new audio::AudioSL());
+            audio.reset(new audio::AudioSL());
 #else
-        audio.reset(new audio::Audio());
+            audio.reset(new audio::Audio());
 #endif
+        }
 
         if (!audio->init())
         {
             return false;
         }
 
+        eventRecorder.reset(new EventRecorder());
+
+        if (!settings.recordFile.empty() && !eventRecorder->startRecording(settings.recordFile))
+        {
+            return false;
+        }
+
+        if (!settings.replayFile.empty())
+        {
+            eventRecorder->setReportFilename(settings.reportFile);
+
+            if (!eventRecorder->startReplay(settings.replayFile, settings.replayTimeStep))
+            {
+                return false;
+            }
+        }
+
         updateThread = std::thread(&Engine::run, this, beginCallback);
 
         return true;
@@ -260,68 +339,355 @@ namespace ouzel
 
     void Engine::exit()
     {
-        running = false;
-        active = false;
+        {
+            std::lock_guard<std::mutex> lock(frameMutex);
+            running = false;
+            active = false;
+        }
+
+        frameCondition.notify_all();
+
+        if (sharedApplication)
+        {
+            sharedApplication->wakeUp();
+        }
     }
 
     void Engine::begin()
     {
         previousUpdateTime = previousFrameTime = getCurrentMicroSeconds();
-        running = true;
+        setRunning(true);
     }
 
     void Engine::end()
     {
-        running = false;
+        setRunning(false);
     }
 
     void Engine::pause()
     {
-        running = false;
+        setRunning(false);
     }
 
     void Engine::resume()
     {
         previousUpdateTime = previousFrameTime = getCurrentMicroSeconds();
-        running = true;
+        setRunning(true);
+    }
+
+    void Engine::setRunning(bool newRunning)
+    {
+        {
+            std::lock_guard<std::mutex> lock(frameMutex);
+            running = newRunning;
+        }
+
+        frameCondition.notify_all();
+    }
+
+    void Engine::setRandomSeed(uint64_t seed)
+    {
+        randomSeed = seed;
+        randomSeedPending = true;
+    }
+
+    void Engine::applyRandomSeed()
+    {
+        if (randomSeedPending.exchange(false))
+        {
+            uint64_t seed = randomSeed;
+
+            // the update thread is thread 0 of the worker pool
+            Random::getThreadInstance().seed(seed);
+            workerPool->seedRandom(seed);
+        }
     }
 
     void Engine::run(const std::function<void(void)>& beginCallback)
     {
+        applyRandomSeed();
         beginCallback();
 
         while (active)
         {
             if (running)
             {
+                applyRandomSeed();
+
+                // the replay runs as fast as possible, every frame is presented before the next one is updated
+                bool replaying = eventRecorder->isReplaying();
+
+                if (settings.lowLatency && !replaying)
+                {
+                    waitForFrameStart();
+                }
+
                 uint64_t currentTime = getCurrentMicroSeconds();
 
                 float delta = static_cast<float>((currentTime - previousUpdateTime)) / 1000000.0f;
                 previousUpdateTime = currentTime;
-                
+
+                if (replaying && !eventRecorder->replayFrame(delta))
+                {
+                    replaying = false;
+
+                    if (!active)
+                    {
+                        break;
+                    }
+                }
+
+                ++frameId;
+
                 input->update();
                 eventDispatcher->update();
+                audio->getMixer().update();
+                cache->update();
+
+                if (eventRecorder->isRecording())
+                {
+                    eventRecorder->recordFrame(delta, eventDispatcher->getInputEvents());
+                }
+
+                uint64_t inputTime = getCurrentMicroSeconds() - currentTime;
+                uint64_t updateTime = 0;
+
+                if (fixedTimeStep > 0.0f)
+                {
+                    // simulate in fixed steps before drawing, the remainder is exposed as the interpolation factor
+                    accumulatedUpdateTime += delta;
+
+                    uint32_t steps = 0;
+
+                    while (accumulatedUpdateTime >= fixedTimeStep)
+                    {
+                        if (steps >= settings.maxUpdateSteps)
+                        {
+                            // drop the time that can't be caught up with instead of spiraling
+                            accumulatedUpdateTime = std::fmod(accumulatedUpdateTime, fixedTimeStep);
+                            break;
+                        }
+
+                        ++updateStep;
+                        runUpdateCallbacks(fixedTimeStep);
+                        accumulatedUpdateTime -= fixedTimeStep;
+                        ++steps;
+                    }
+
+                    updateInterpolation = accumulatedUpdateTime / fixedTimeStep;
+                    updateTime = getCurrentMicroSeconds() - currentTime - inputTime;
+                }
+
+                uint64_t drawStartTime = getCurrentMicroSeconds();
+
                 sceneManager->draw();
                 renderer->flushDrawCommands();
 
-                for (updateCallbackIterator = updateCallbacks.begin(); updateCallbackIterator != updateCallbacks.end();)
+                uint64_t drawTime = getCurrentMicroSeconds() - drawStartTime;
+
+                {
+                    std::lock_guard<std::mutex> lock(frameMutex);
+                    frameReady = true;
+                    frameUpdateTime = currentTime;
+                    readyFrameId = frameId;
+
+                    // a frame that wasn't presented is replaced, its inputs are shown by this one
+                    const std::vector<uint64_t>& inputTimestamps = eventDispatcher->getInputTimestamps();
+                    frameInputTimestamps.insert(frameInputTimestamps.end(), inputTimestamps.begin(), inputTimestamps.end());
+                    updateDuration = updateDuration * 0.9f + static_cast<float>(getCurrentMicroSeconds() - currentTime) * 0.1f;
+                }
+
+                frameCondition.notify_all();
+
+                if (sharedApplication)
+                {
+                    sharedApplication->wakeUp();
+                }
+
+                if (fixedTimeStep <= 0.0f)
                 {
-                    updateCallbackDeleted = false;
+                    uint64_t updateStartTime = getCurrentMicroSeconds();
+                    runUpdateCallbacks(delta);
+                    updateTime = getCurrentMicroSeconds() - updateStartTime;
+                }
 
-                    const UpdateCallback* updateCallback = *updateCallbackIterator;
-                    if (updateCallback && updateCallback->callback)
+                uint64_t busyTime = getCurrentMicroSeconds() - currentTime;
+
+                // wait until the frame is presented, there is no point in producing frames that are never shown
+                {
+                    std::unique_lock<std::mutex> lock(frameMutex);
+
+                    if (replaying)
                     {
-                        updateCallback->callback(delta);
+                        frameCondition.wait(lock, [this]() {
+                            return !frameReady || !running || !active;
+                        });
+                    }
+                    else
+                    {
+                        frameCondition.wait_for(lock, std::chrono::milliseconds(100), [this]() {
+                            return !frameReady || !running || !active;
+                        });
+                    }
+                }
+
+                if (replaying)
+                {
+                    uint32_t droppedFrameCount = renderer->getDroppedFrameCount();
+                    uint32_t repeatedFrameCount = renderer->getRepeatedFrameCount();
+
+                    EventRecorder::FrameReport frameReport;
+                    frameReport.delta = delta;
+                    frameReport.eventCount = static_cast<uint32_t>(eventDispatcher->getInputTimestamps().size());
+                    frameReport.inputTime = inputTime;
+                    frameReport.updateTime = updateTime;
+                    frameReport.drawTime = drawTime;
+                    frameReport.drawCallCount = renderer->getDrawCallCount();
+                    frameReport.droppedFrameCount = droppedFrameCount - reportedDroppedFrameCount;
+                    frameReport.repeatedFrameCount = repeatedFrameCount - reportedRepeatedFrameCount;
+                    eventRecorder->addFrameReport(frameReport);
+
+                    reportedDroppedFrameCount = droppedFrameCount;
+                    reportedRepeatedFrameCount = repeatedFrameCount;
+                }
+                else if (targetFrameInterval > 0)
+                {
+                    uint64_t frameTime = getCurrentMicroSeconds() - currentTime;
+
+                    if (frameTime < targetFrameInterval)
+                    {
+                        std::this_thread::sleep_for(std::chrono::microseconds(targetFrameInterval - frameTime));
                     }
+                }
+
+                uint64_t frameTime = getCurrentMicroSeconds() - currentTime;
+
+                if (frameTime > 0)
+                {
+                    updateLoad = updateLoad * 0.9f + static_cast<float>(busyTime) / static_cast<float>(frameTime) * 0.1f;
+                }
+            }
+            else
+            {
+                // sleep while paused
+                std::unique_lock<std::mutex> lock(frameMutex);
+                frameCondition.wait(lock, [this]() { return running || !active; });
+            }
+        }
+    }
+
+    float Engine::getInputLatency(float percentile)
+    {
+        std::vector<float> samples;
+
+        {
+            std::lock_guard<std::mutex> lock(frameMutex);
+            samples = inputLatencies;
+        }
+
+        if (samples.empty())
+        {
+            return 0.0f;
+        }
+
+        size_t index = static_cast<size_t>(clamp(percentile, 0.0f, 100.0f) / 100.0f * static_cast<float>(samples.size() - 1) + 0.5f);
+        std::nth_element(samples.begin(), samples.begin() + index, samples.end());
 
-                    // current element wasn't delete from the list
-                    if (!updateCallbackDeleted)
+        return samples[index];
+    }
+
+    uint32_t Engine::getInputLatencySampleCount()
+    {
+        std::lock_guard<std::mutex> lock(frameMutex);
+        return static_cast<uint32_t>(inputLatencies.size());
+    }
+
+    bool Engine::isFrameReady()
+    {
+        std::lock_guard<std::mutex> lock(frameMutex);
+        return frameReady;
+    }
+
+    void Engine::runUpdateCallbacks(float delta)
+    {
+        updating = true;
+
+        for (std::pair<const int32_t, UpdateBucket>& bucketPair : updateBuckets)
+        {
+            UpdateBucket& bucket = bucketPair.second;
+
+            // callbacks added during the update are called in the next frame
+            size_t count = bucket.callbacks.size();
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const UpdateCallback* updateCallback = bucket.callbacks[i];
+
+                if (updateCallback && updateCallback->callback)
+                {
+                    if (updateProfiling)
                     {
-                        ++updateCallbackIterator;
+                        uint64_t startTime = getCurrentMicroSeconds();
+                        updateCallback->callback(delta);
+                        uint64_t time = getCurrentMicroSeconds() - startTime;
+
+                        // the callback could have been unscheduled (and deleted) by itself
+                        if (bucket.callbacks[i] == updateCallback)
+                        {
+                            updateCallback->lastTime = time;
+                            updateCallback->totalTime += time;
+                            ++updateCallback->callCount;
+                        }
+                    }
+                    else
+                    {
+                        updateCallback->callback(delta);
                     }
                 }
             }
         }
+
+        updating = false;
+
+        for (std::pair<const int32_t, UpdateBucket>& bucketPair : updateBuckets)
+        {
+            if (bucketPair.second.removedCount)
+            {
+                compactUpdateBucket(bucketPair.second);
+            }
+        }
+    }
+
+    void Engine::waitForFrameStart()
+    {
+        uint64_t startTime;
+
+        {
+            std::lock_guard<std::mutex> lock(frameMutex);
+
+            if (previousPresentTime == 0 || presentInterval <= 0.0f)
+            {
+                return;
+            }
+
+            // leave some headroom for the variance of the update
+            uint64_t margin = static_cast<uint64_t>(updateDuration * 1.5f) + 1000;
+            uint64_t interval = static_cast<uint64_t>(presentInterval);
+
+            if (margin >= interval)
+            {
+                return;
+            }
+
+            startTime = previousPresentTime + interval - margin;
+        }
+
+        uint64_t currentTime = getCurrentMicroSeconds();
+
+        if (startTime > currentTime)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(startTime - currentTime));
+        }
     }
 
     bool Engine::draw()
@@ -346,44 +712,142 @@ namespace ouzel
             currentAccumulatedFPS = 0.0f;
         }
 
+        if (eventRecorder->isReplaying() || settings.driver == graphics::Renderer::Driver::NONE)
+        {
+            // the replay presents every frame exactly once, without a window there is nothing to repaint
+            std::unique_lock<std::mutex> lock(frameMutex);
+            frameCondition.wait(lock, [this]() {
+                return frameReady || !running || !active;
+            });
+        }
+        else if (targetFrameInterval > 0)
+        {
+            // don't present the same frame repeatedly, when the frame rate is limited
+            std::unique_lock<std::mutex> lock(frameMutex);
+            frameCondition.wait_for(lock, std::chrono::microseconds(targetFrameInterval * 2), [this]() {
+                return frameReady || !running || !active;
+            });
+        }
+
         if (!renderer->present())
         {
             return false;
         }
 
+        {
+            std::lock_guard<std::mutex> lock(frameMutex);
+
+            uint64_t presentTime = getCurrentMicroSeconds();
+
+            if (frameReady)
+            {
+                latency = latency * 0.9f + static_cast<float>(presentTime - frameUpdateTime) / 1000000.0f * 0.1f;
+                frameReady = false;
+                presentedFrameId = readyFrameId;
+
+                for (uint64_t inputTimestamp : frameInputTimestamps)
+                {
+                    float inputLatency = (presentTime > inputTimestamp) ? static_cast<float>(presentTime - inputTimestamp) / 1000000.0f : 0.0f;
+
+                    if (inputLatencies.size() < INPUT_LATENCY_SAMPLE_COUNT)
+                    {
+                        inputLatencies.push_back(inputLatency);
+                    }
+                    else
+                    {
+                        inputLatencies[inputLatencyIndex] = inputLatency;
+                    }
+
+                    inputLatencyIndex = (inputLatencyIndex + 1) % INPUT_LATENCY_SAMPLE_COUNT;
+                }
+
+                frameInputTimestamps.clear();
+            }
+
+            if (previousPresentTime)
+            {
+                presentInterval = presentInterval * 0.9f + static_cast<float>(presentTime - previousPresentTime) * 0.1f;
+            }
+
+            previousPresentTime = presentTime;
+        }
+
+        frameCondition.notify_all();
+
         return active;
     }
 
     void Engine::scheduleUpdate(const UpdateCallback& callback)
     {
-        std::list<const UpdateCallback*>::iterator i = std::find(updateCallbacks.begin(), updateCallbacks.end(), &callback);
-
-        if (i == updateCallbacks.end())
+        if (!callback.bucket)
         {
-            updateCallbacks.push_back(&callback);
+            UpdateBucket& bucket = updateBuckets[callback.priority];
 
-            updateCallbacks.sort([](const UpdateCallback* a, const UpdateCallback* b) {
-                return a->priority < b->priority;
-            });
+            callback.bucket = &bucket;
+            callback.slot = bucket.callbacks.size();
+            bucket.callbacks.push_back(&callback);
         }
     }
 
     void Engine::unscheduleUpdate(const UpdateCallback& callback)
     {
-        std::list<const UpdateCallback*>::iterator i = std::find(updateCallbacks.begin(), updateCallbacks.end(), &callback);
+        if (UpdateBucket* bucket = callback.bucket)
+        {
+            // the slot is cleared and removed later to keep the order and the indices of the update loop valid
+            bucket->callbacks[callback.slot] = nullptr;
+            ++bucket->removedCount;
+            callback.bucket = nullptr;
+
+            if (!updating && bucket->removedCount * 2 > bucket->callbacks.size())
+            {
+                compactUpdateBucket(*bucket);
+            }
+        }
+    }
+
+    void Engine::compactUpdateBucket(UpdateBucket& bucket)
+    {
+        size_t count = 0;
 
-        if (i != updateCallbacks.end())
+        for (const UpdateCallback* updateCallback : bucket.callbacks)
         {
-            // increment the iterator if current element is deleted
-            if (i == updateCallbackIterator)
+            if (updateCallback)
             {
-                updateCallbackIterator = updateCallbacks.erase(i);
-                updateCallbackDeleted = true;
+                updateCallback->slot = count;
+                bucket.callbacks[count++] = updateCallback;
             }
-            else
+        }
+
+        bucket.callbacks.resize(count);
+        bucket.removedCount = 0;
+    }
+
+    void Engine::logUpdateProfile() const
+    {
+        std::vector<const UpdateCallback*> updateCallbacks;
+
+        for (const std::pair<const int32_t, UpdateBucket>& bucketPair : updateBuckets)
+        {
+            for (const UpdateCallback* updateCallback : bucketPair.second.callbacks)
             {
-                updateCallbacks.erase(i);
+                if (updateCallback)
+                {
+                    updateCallbacks.push_back(updateCallback);
+                }
             }
         }
+
+        std::sort(updateCallbacks.begin(), updateCallbacks.end(), [](const UpdateCallback* a, const UpdateCallback* b) {
+            return a->totalTime > b->totalTime;
+        });
+
+        for (const UpdateCallback* updateCallback : updateCallbacks)
+        {
+            log("%s: %llu us total, %llu us last, %u calls",
+                updateCallback->name.empty() ? "unnamed" : updateCallback->name.c_str(),
+                static_cast<unsigned long long>(updateCallback->totalTime),
+                static_cast<unsigned long long>(updateCallback->lastTime),
+                updateCallback->callCount);
+        }
     }
 }
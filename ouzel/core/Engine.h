@@ -4,12 +4,14 @@
 #pragma once
 
 #include <memory>
-#include <list>
+#include <map>
 #include <set>
 #include <functional>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 #include <atomic>
+#include <vector>
 #include "utils/Types.h"
 #include "utils/Noncopyable.h"
 #include "graphics/Renderer.h"
@@ -17,6 +19,7 @@
 #include "files/FileSystem.h"
 #include "input/Input.h"
 #include "events/EventDispatcher.h"
+#include "events/EventRecorder.h"
 #include "core/UpdateCallback.h"
 #include "core/Settings.h"
 
@@ -41,9 +44,14 @@ namespace ouzel
         const graphics::RendererPtr& getRenderer() const { return renderer; }
         const audio::AudioPtr& getAudio() const { return audio; }
         const scene::SceneManagerPtr& getSceneManager() const { return sceneManager; }
+        const scene::ParticleManagerPtr& getParticleManager() const { return particleManager; }
+        const scene::AnimationSystemPtr& getAnimationSystem() const { return animationSystem; }
         const FileSystemPtr& getFileSystem() const { return fileSystem; }
         const input::InputPtr& getInput() const { return input; }
         const LocalizationPtr& getLocalization() const { return localization; }
+        const WorkerPoolPtr& getWorkerPool() const { return workerPool; }
+        const TimerManagerPtr& getTimerManager() const { return timerManager; }
+        const EventRecorderPtr& getEventRecorder() const { return eventRecorder; }
 
         void exit();
 
@@ -54,18 +62,60 @@ namespace ouzel
         bool draw();
         bool isRunning() const { return running; }
         bool isActive() const { return active; }
+        bool isFrameReady();
 
         float getFPS() const { return currentFPS; }
         float getAccumulatedFPS() const { return accumulatedFPS; }
 
+        // share of the wall time the update thread spends working (0 - 1)
+        float getUpdateLoad() const { return updateLoad; }
+        // time from the start of the update (when input is processed) to the present of its frame in seconds
+        float getLatency() const { return latency; }
+
+        // number of the frame being updated and of the last presented frame
+        uint64_t getFrameId() const { return frameId; }
+        uint64_t getPresentedFrameId() const { return presentedFrameId; }
+
+        /**
+         * Time from an input event (keyboard, mouse, touch or gamepad) to the present of the first frame
+         * updated after it in seconds, the given percentile (0 - 100) of the last INPUT_LATENCY_SAMPLE_COUNT events.
+         */
+        float getInputLatency(float percentile);
+        uint32_t getInputLatencySampleCount();
+
+        // fixed update step in seconds, 0 if the update uses the frame time
+        float getFixedTimeStep() const { return fixedTimeStep; }
+        // share of the next fixed step that has elapsed (0 - 1), nodes interpolate their transforms between the last two steps with it
+        float getUpdateInterpolation() const { return updateInterpolation; }
+        // number of fixed steps run so far
+        uint64_t getUpdateStep() const { return updateStep; }
+
         void scheduleUpdate(const UpdateCallback& callback);
         void unscheduleUpdate(const UpdateCallback& callback);
 
+        /**
+         * Seeds Random::getThreadInstance of the update thread and the worker threads before the begin callback or at the start of the next frame.
+         * Used by the event recorder, so that a replay gets the same random numbers as the recording.
+         */
+        void setRandomSeed(uint64_t seed);
+
+        void setUpdateProfiling(bool enabled) { updateProfiling = enabled; }
+        bool isUpdateProfiling() const { return updateProfiling; }
+        void logUpdateProfile() const;
+
     protected:
         void run(const std::function<void(void)>& beginCallback);
+        void setRunning(bool newRunning);
+        void runUpdateCallbacks(float delta);
+        void waitForFrameStart();
+        void applyRandomSeed();
 
         Settings settings;
 
+        // buckets are never removed, so callbacks can keep pointers to them,
+        // declared before the subsystems, because they unschedule their callbacks when destroyed
+        std::map<int32_t, UpdateBucket> updateBuckets;
+
         EventDispatcherPtr eventDispatcher;
         input::InputPtr input;
         WindowPtr window;
@@ -74,7 +124,12 @@ namespace ouzel
         graphics::RendererPtr renderer;
         audio::AudioPtr audio;
         CachePtr cache;
+        scene::ParticleManagerPtr particleManager;
+        scene::AnimationSystemPtr animationSystem;
         scene::SceneManagerPtr sceneManager;
+        WorkerPoolPtr workerPool;
+        TimerManagerPtr timerManager;
+        EventRecorderPtr eventRecorder;
 
         uint64_t targetFrameInterval;
         std::atomic<float> currentFPS;
@@ -86,11 +141,44 @@ namespace ouzel
 
         uint64_t previousUpdateTime;
 
-        std::list<const UpdateCallback*> updateCallbacks;
-        std::list<const UpdateCallback*>::iterator updateCallbackIterator;
-        bool updateCallbackDeleted = false;
+        float fixedTimeStep = 0.0f;
+        float accumulatedUpdateTime = 0.0f;
+        float updateInterpolation = 0.0f;
+        uint64_t updateStep = 0;
+
+        void compactUpdateBucket(UpdateBucket& bucket);
+
+        bool updating = false;
+        bool updateProfiling = false;
         std::thread updateThread;
 
+        // the update thread produces at most one frame ahead of the present
+        std::mutex frameMutex;
+        std::condition_variable frameCondition;
+        bool frameReady = false;
+        uint64_t frameUpdateTime = 0;
+        uint64_t previousPresentTime = 0;
+        float presentInterval = 0.0f;
+        float updateDuration = 0.0f;
+        std::atomic<float> updateLoad;
+        std::atomic<float> latency;
+
+        static const uint32_t INPUT_LATENCY_SAMPLE_COUNT = 1024;
+
+        std::atomic<uint64_t> frameId;
+        std::atomic<uint64_t> presentedFrameId;
+        uint64_t readyFrameId = 0;
+        std::vector<uint64_t> frameInputTimestamps; // inputs of the ready frame and the ones it replaced
+        std::vector<float> inputLatencies; // ring buffer of the last samples
+        uint32_t inputLatencyIndex = 0;
+
+        // renderer counters at the previous frame report of the replay
+        uint32_t reportedDroppedFrameCount = 0;
+        uint32_t reportedRepeatedFrameCount = 0;
+
+        std::atomic<uint64_t> randomSeed;
+        std::atomic<bool> randomSeedPending;
+
         std::atomic<bool> running;
         std::atomic<bool> active;
     };
@@ -19,6 +19,15 @@ namespace ouzel
         bool fullscreen = false;
         float targetFPS = 0.0f; // 0 for no limit
         bool verticalSync = true;
+        float updateRate = 0.0f; // fixed number of updates per second, 0 to update once per frame with the frame time
+        uint32_t maxUpdateSteps = 5; // maximum number of fixed updates per frame, the rest of the time is dropped
+        bool lowLatency = false; // start the update just in time before the present, instead of right after the previous one
+        uint32_t threadCount = 0; // number of threads for parallel work, 0 for hardware concurrency
         std::string title = "ouzel";
+
+        std::string recordFile; // records the input of every frame to the file
+        std::string replayFile; // replays the recorded input and exits, use the NONE driver to run without a window
+        float replayTimeStep = 1.0f / 60.0f; // frame time of the replay, 0 to use the recorded frame times
+        std::string reportFile; // per frame update and draw statistics of the replay (CSV)
     };
 }
@@ -0,0 +1,293 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include <cmath>
+#include "TimerManager.h"
+#include "Engine.h"
+
+namespace ouzel
+{
+    const float TimerManager::TICK_DURATION = 0.001f;
+    const uint32_t TimerManager::LEVEL_COUNT;
+    const uint32_t TimerManager::SLOT_BITS;
+    const uint32_t TimerManager::SLOT_COUNT;
+    const uint32_t TimerManager::INVALID_INDEX;
+
+    TimerManager::TimerManager():
+        slots(LEVEL_COUNT * SLOT_COUNT, INVALID_INDEX)
+    {
+        updateCallback.callback = std::bind(&TimerManager::update, this, std::placeholders::_1);
+        updateCallback.name = "TimerManager";
+    }
+
+    TimerManager::~TimerManager()
+    {
+        sharedEngine->unscheduleUpdate(updateCallback);
+    }
+
+    TimerId TimerManager::addTimer(float delay, const std::function<void()>& callback, float interval,
+                                   const scene::NodePtr& node)
+    {
+        uint32_t index = allocateTimer();
+        Timer& timer = timers[index];
+
+        // timers never fire early and wait at least one tick
+        float delayTicks = std::max(std::ceil(delay / TICK_DURATION), 1.0f);
+        // the wheel covers 2^32 ticks (about 49 days)
+        delayTicks = std::min(delayTicks, 4294967295.0f);
+
+        timer.callback = callback;
+        timer.node = node;
+        timer.hasNode = (node != nullptr);
+        timer.expireTick = currentTick + static_cast<uint64_t>(delayTicks);
+        timer.interval = (interval > 0.0f) ? static_cast<uint32_t>(std::min(std::max(std::ceil(interval / TICK_DURATION), 1.0f), 4294967295.0f)) : 0;
+        timer.state = State::PENDING;
+
+        insertTimer(index);
+
+        if (timerCount++ == 0)
+        {
+            sharedEngine->scheduleUpdate(updateCallback);
+        }
+
+        return (static_cast<TimerId>(timer.generation) << 32) | index;
+    }
+
+    bool TimerManager::cancelTimer(TimerId timerId)
+    {
+        if (!getTimer(timerId))
+        {
+            return false;
+        }
+
+        uint32_t index = static_cast<uint32_t>(timerId & 0xFFFFFFFF);
+        Timer& timer = timers[index];
+
+        if (timer.state == State::PENDING)
+        {
+            unlinkTimer(index);
+        }
+
+        // firing timers are only marked free, the update skips them
+        freeTimer(index);
+
+        return true;
+    }
+
+    bool TimerManager::isTimerActive(TimerId timerId) const
+    {
+        return getTimer(timerId) != nullptr;
+    }
+
+    const TimerManager::Timer* TimerManager::getTimer(TimerId timerId) const
+    {
+        uint32_t index = static_cast<uint32_t>(timerId & 0xFFFFFFFF);
+        uint32_t generation = static_cast<uint32_t>(timerId >> 32);
+
+        if (index >= timers.size())
+        {
+            return nullptr;
+        }
+
+        const Timer& timer = timers[index];
+
+        if (timer.state == State::FREE || timer.generation != generation)
+        {
+            return nullptr;
+        }
+
+        return &timer;
+    }
+
+    void TimerManager::update(float delta)
+    {
+        if (paused)
+        {
+            return;
+        }
+
+        accumulatedTime += delta * timeScale;
+
+        if (accumulatedTime < TICK_DURATION)
+        {
+            return;
+        }
+
+        uint64_t ticks = static_cast<uint64_t>(accumulatedTime / TICK_DURATION);
+        accumulatedTime -= static_cast<float>(ticks) * TICK_DURATION;
+
+        for (uint64_t i = 0; i < ticks && timerCount > 0; ++i)
+        {
+            advance();
+        }
+
+        if (timerCount == 0)
+        {
+            sharedEngine->unscheduleUpdate(updateCallback);
+        }
+    }
+
+    void TimerManager::advance()
+    {
+        ++currentTick;
+
+        // move the timers of the higher levels down when a lower level wraps around
+        for (uint32_t level = 1; level < LEVEL_COUNT; ++level)
+        {
+            if ((currentTick & ((static_cast<uint64_t>(1) << (level * SLOT_BITS)) - 1)) != 0)
+            {
+                break;
+            }
+
+            cascade(level);
+        }
+
+        uint32_t& head = slots[currentTick & (SLOT_COUNT - 1)];
+
+        // detach the slot first, callbacks can add and cancel timers
+        firingTimers.clear();
+
+        for (uint32_t index = head; index != INVALID_INDEX; index = timers[index].next)
+        {
+            timers[index].state = State::FIRING;
+            firingTimers.push_back(index);
+        }
+
+        head = INVALID_INDEX;
+
+        for (uint32_t index : firingTimers)
+        {
+            if (timers[index].state != State::FIRING)
+            {
+                continue;
+            }
+
+            if (timers[index].hasNode && timers[index].node.expired())
+            {
+                freeTimer(index);
+                continue;
+            }
+
+            uint32_t generation = timers[index].generation;
+
+            // copy the callback, it can cancel its own timer
+            std::function<void()> callback = timers[index].callback;
+            if (callback) callback();
+
+            // timers can reallocate the vector, so don't keep references across the call
+            Timer& timer = timers[index];
+
+            if (timer.state == State::FIRING && timer.generation == generation)
+            {
+                if (timer.interval)
+                {
+                    timer.expireTick += timer.interval;
+                    timer.state = State::PENDING;
+                    insertTimer(index);
+                }
+                else
+                {
+                    freeTimer(index);
+                }
+            }
+        }
+    }
+
+    void TimerManager::cascade(uint32_t level)
+    {
+        uint32_t& head = slots[level * SLOT_COUNT + ((currentTick >> (level * SLOT_BITS)) & (SLOT_COUNT - 1))];
+        uint32_t index = head;
+        head = INVALID_INDEX;
+
+        while (index != INVALID_INDEX)
+        {
+            uint32_t next = timers[index].next;
+            insertTimer(index);
+            index = next;
+        }
+    }
+
+    uint32_t TimerManager::allocateTimer()
+    {
+        if (freeList != INVALID_INDEX)
+        {
+            uint32_t index = freeList;
+            freeList = timers[index].next;
+            return index;
+        }
+
+        timers.push_back(Timer());
+        return static_cast<uint32_t>(timers.size() - 1);
+    }
+
+    void TimerManager::freeTimer(uint32_t index)
+    {
+        Timer& timer = timers[index];
+
+        timer.callback = nullptr;
+        timer.node.reset();
+        timer.state = State::FREE;
+        // invalidates the ids of this timer
+        ++timer.generation;
+        timer.slot = INVALID_INDEX;
+        timer.previous = INVALID_INDEX;
+        timer.next = freeList;
+        freeList = index;
+
+        --timerCount;
+    }
+
+    void TimerManager::insertTimer(uint32_t index)
+    {
+        Timer& timer = timers[index];
+        uint64_t expireTick = timer.expireTick;
+        uint64_t delta = (expireTick > currentTick) ? expireTick - currentTick : 0;
+
+        uint32_t level = 0;
+
+        while (level < LEVEL_COUNT - 1 && delta >= (static_cast<uint64_t>(1) << ((level + 1) * SLOT_BITS)))
+        {
+            ++level;
+        }
+
+        // due timers go to the current slot
+        if (delta == 0) expireTick = currentTick;
+
+        uint32_t slot = level * SLOT_COUNT + static_cast<uint32_t>((expireTick >> (level * SLOT_BITS)) & (SLOT_COUNT - 1));
+
+        timer.slot = slot;
+        timer.previous = INVALID_INDEX;
+        timer.next = slots[slot];
+
+        if (timer.next != INVALID_INDEX)
+        {
+            timers[timer.next].previous = index;
+        }
+
+        slots[slot] = index;
+    }
+
+    void TimerManager::unlinkTimer(uint32_t index)
+    {
+        Timer& timer = timers[index];
+
+        if (timer.previous != INVALID_INDEX)
+        {
+            timers[timer.previous].next = timer.next;
+        }
+        else
+        {
+            slots[timer.slot] = timer.next;
+        }
+
+        if (timer.next != INVALID_INDEX)
+        {
+            timers[timer.next].previous = timer.previous;
+        }
+
+        timer.slot = INVALID_INDEX;
+        timer.previous = INVALID_INDEX;
+        timer.next = INVALID_INDEX;
+    }
+}
@@ -0,0 +1,107 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <vector>
+#include <functional>
+#include "utils/Types.h"
+#include "utils/Noncopyable.h"
+#include "core/UpdateCallback.h"
+
+namespace ouzel
+{
+    typedef uint64_t TimerId;
+
+    /**
+     * Calls functions after a delay or repeatedly, on the update thread.
+     * Timers are kept in a hierarchical timing wheel, so adding and canceling a timer is O(1)
+     * and the update cost doesn't depend on the number of pending timers.
+     */
+    class TimerManager: public Noncopyable
+    {
+        friend Engine;
+    public:
+        // resolution of the timers in seconds
+        static const float TICK_DURATION;
+
+        virtual ~TimerManager();
+
+        /**
+         * Calls the callback after the delay (in seconds), if interval is greater than zero, the timer
+         * repeats with the given interval until it is canceled.
+         * Timers added with a node are canceled when the node is destroyed.
+         */
+        TimerId addTimer(float delay, const std::function<void()>& callback, float interval = 0.0f,
+                         const scene::NodePtr& node = nullptr);
+        bool cancelTimer(TimerId timerId);
+        bool isTimerActive(TimerId timerId) const;
+
+        uint32_t getTimerCount() const { return timerCount; }
+
+        void pause() { paused = true; }
+        void resume() { paused = false; }
+        bool isPaused() const { return paused; }
+
+        void setTimeScale(float newTimeScale) { timeScale = newTimeScale; }
+        float getTimeScale() const { return timeScale; }
+
+    protected:
+        static const uint32_t LEVEL_COUNT = 4;
+        static const uint32_t SLOT_BITS = 8;
+        static const uint32_t SLOT_COUNT = 1 << SLOT_BITS;
+        static const uint32_t INVALID_INDEX = 0xFFFFFFFF;
+
+        enum class State
+        {
+            FREE,
+            PENDING,
+            FIRING
+        };
+
+        struct Timer
+        {
+            std::function<void()> callback;
+            scene::NodeWeakPtr node;
+            bool hasNode = false;
+            uint64_t expireTick = 0;
+            uint32_t interval = 0;
+            uint32_t generation = 1;
+            State state = State::FREE;
+
+            // links in the wheel slot list (or in the free list)
+            uint32_t slot = INVALID_INDEX;
+            uint32_t previous = INVALID_INDEX;
+            uint32_t next = INVALID_INDEX;
+        };
+
+        TimerManager();
+
+        void update(float delta);
+        void advance();
+        void cascade(uint32_t level);
+
+        uint32_t allocateTimer();
+        void freeTimer(uint32_t index);
+        void insertTimer(uint32_t index);
+        void unlinkTimer(uint32_t index);
+
+        const Timer* getTimer(TimerId timerId) const;
+
+        std::vector<Timer> timers;
+        uint32_t freeList = INVALID_INDEX;
+        uint32_t timerCount = 0;
+
+        // heads of the slot lists, LEVEL_COUNT * SLOT_COUNT entries
+        std::vector<uint32_t> slots;
+        uint64_t currentTick = 0;
+        float accumulatedTime = 0.0f;
+
+        std::vector<uint32_t> firingTimers;
+
+        bool paused = false;
+        float timeScale = 1.0f;
+
+        UpdateCallback updateCallback;
+    };
+}
@@ -4,11 +4,20 @@
 #pragma once
 
 #include <functional>
+#include <string>
+#include <vector>
 #include <cstdint>
 
 namespace ouzel
 {
     class Engine;
+    class UpdateCallback;
+
+    struct UpdateBucket
+    {
+        std::vector<const UpdateCallback*> callbacks;
+        uint32_t removedCount = 0;
+    };
 
     class UpdateCallback
     {
@@ -18,9 +27,38 @@ namespace ouzel
 
         UpdateCallback(int32_t pPriority = 0): priority(pPriority) { }
 
+        // copies are not scheduled
+        UpdateCallback(const UpdateCallback& other):
+            callback(other.callback), name(other.name), priority(other.priority)
+        {
+        }
+
+        UpdateCallback& operator=(const UpdateCallback& other)
+        {
+            callback = other.callback;
+            name = other.name;
+            return *this;
+        }
+
         std::function<void(float)> callback;
 
+        // shown in the update profile
+        std::string name;
+
+        uint64_t getLastTime() const { return lastTime; }
+        uint64_t getTotalTime() const { return totalTime; }
+        uint32_t getCallCount() const { return callCount; }
+
     protected:
         int32_t priority;
+
+        // position in the engine's scheduler
+        mutable UpdateBucket* bucket = nullptr;
+        mutable size_t slot = 0;
+
+        // profiling data in microseconds, collected only when update profiling is enabled
+        mutable uint64_t lastTime = 0;
+        mutable uint64_t totalTime = 0;
+        mutable uint32_t callCount = 0;
     };
 }
@@ -0,0 +1,120 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include "WorkerPool.h"
+#include "utils/Random.h"
+
+namespace ouzel
+{
+    WorkerPool::WorkerPool(uint32_t threadCount)
+    {
+        if (threadCount == 0)
+        {
+            threadCount = std::thread::hardware_concurrency();
+        }
+
+        for (uint32_t i = 1; i < threadCount; ++i)
+        {
+            workers.push_back(std::thread(&WorkerPool::work, this, i));
+        }
+    }
+
+    WorkerPool::~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            running = false;
+        }
+
+        queueCondition.notify_all();
+
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    void WorkerPool::run(const std::vector<std::function<void()>>& tasks)
+    {
+        if (workers.empty() || tasks.size() <= 1)
+        {
+            for (const std::function<void()>& task : tasks)
+            {
+                task();
+            }
+
+            return;
+        }
+
+        Batch batch(tasks);
+
+        std::unique_lock<std::mutex> lock(queueMutex);
+        batches.push_back(&batch);
+        queueCondition.notify_all();
+
+        while (batch.remaining > 0)
+        {
+            if (!batches.empty())
+            {
+                executeTask(lock);
+            }
+            else
+            {
+                finishCondition.wait(lock);
+            }
+        }
+    }
+
+    void WorkerPool::seedRandom(uint64_t seed)
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        randomSeed = seed;
+        ++seedGeneration;
+    }
+
+    void WorkerPool::work(uint32_t index)
+    {
+        uint32_t generation = 0;
+
+        std::unique_lock<std::mutex> lock(queueMutex);
+
+        while (running)
+        {
+            if (batches.empty())
+            {
+                queueCondition.wait(lock);
+            }
+            else
+            {
+                if (generation != seedGeneration)
+                {
+                    generation = seedGeneration;
+                    Random::getThreadInstance().seed(randomSeed + index);
+                }
+
+                executeTask(lock);
+            }
+        }
+    }
+
+    void WorkerPool::executeTask(std::unique_lock<std::mutex>& lock)
+    {
+        Batch* batch = batches.front();
+        size_t index = batch->next++;
+
+        if (batch->next == batch->tasks.size())
+        {
+            batches.pop_front();
+        }
+
+        lock.unlock();
+        batch->tasks[index]();
+        lock.lock();
+
+        // batch is owned by the thread waiting in run and must not be accessed after the last task finishes
+        if (--batch->remaining == 0)
+        {
+            finishCondition.notify_all();
+        }
+    }
+}
@@ -0,0 +1,56 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "utils/Noncopyable.h"
+
+namespace ouzel
+{
+    class WorkerPool: public Noncopyable
+    {
+    public:
+        WorkerPool(uint32_t threadCount = 0);
+        virtual ~WorkerPool();
+
+        // number of threads executing tasks, including the calling thread
+        uint32_t getThreadCount() const { return static_cast<uint32_t>(workers.size()) + 1; }
+
+        // blocks until all tasks are finished, the calling thread also executes tasks, so it is safe to call run from a task
+        void run(const std::vector<std::function<void()>>& tasks);
+
+        // the worker threads seed their Random::getThreadInstance with seed + the index of the thread (from 1) before their next task
+        void seedRandom(uint64_t seed);
+
+    protected:
+        struct Batch
+        {
+            Batch(const std::vector<std::function<void()>>& pTasks):
+                tasks(pTasks), remaining(pTasks.size())
+            {
+            }
+
+            const std::vector<std::function<void()>>& tasks;
+            size_t next = 0;
+            size_t remaining;
+        };
+
+        void work(uint32_t index);
+        void executeTask(std::unique_lock<std::mutex>& lock);
+
+        std::vector<std::thread> workers;
+        std::deque<Batch*> batches;
+        std::mutex queueMutex;
+        std::condition_variable queueCondition;
+        std::condition_variable finishCondition;
+        bool running = true;
+        uint64_t randomSeed = 0;
+        uint32_t seedGeneration = 0;
+    };
+}
@@ -408,31 +408,19 @@ namespace ouzel
 
             context->RSSetState(rasterizerState);
 
-            std::queue<DrawCommand> drawCommands;
+            bool newFrame;
+            const FramePacket& framePacket = acquireFramePacket(newFrame);
+            const DrawCommandList& drawCommands = framePacket.drawCommands;
 
+            if (newFrame)
             {
-                std::lock_guard<std::mutex> lock(drawQueueMutex);
-                drawCommands = drawQueue;
-            }
-
-            std::queue<ResourcePtr> resources;
-
-            {
-                std::lock_guard<std::mutex> lock(updateMutex);
-                resources = std::move(updateQueue);
-                updateSet.clear();
-            }
-
-            while (!resources.empty())
-            {
-                const ResourcePtr& resource = resources.front();
-
-                if (!resource->update())
+                for (const ResourcePtr& resource : framePacket.resources)
                 {
-                    return false;
+                    if (!resource->update())
+                    {
+                        return false;
+                    }
                 }
-
-                resources.pop();
             }
 
             if (!update())
@@ -447,10 +435,8 @@ namespace ouzel
 
                 context->ClearRenderTargetView(renderTargetView, frameBufferClearColor);
             }
-            else while (!drawCommands.empty())
+            else for (const DrawCommand& drawCommand : drawCommands)
             {
-                const DrawCommand& drawCommand = drawCommands.front();
-
                 // render target
                 ID3D11RenderTargetView* newRenderTargetView = nullptr;
                 const float* newClearColor;
@@ -617,7 +603,11 @@ namespace ouzel
                 UINT stride = meshBufferD3D11->getVertexSize();
                 UINT offset = 0;
                 context->IASetVertexBuffers(0, 1, buffers, &stride, &offset);
-                context->IASetIndexBuffer(meshBufferD3D11->getIndexBuffer(), meshBufferD3D11->getIndexFormat(), 0);
+
+                // the indices can be shared with another mesh buffer
+                MeshBufferD3D11* indexMeshBufferD3D11 = meshBufferD3D11->getIndexMeshBuffer() ?
+                    static_cast<MeshBufferD3D11*>(meshBufferD3D11->getIndexMeshBuffer().get()) : meshBufferD3D11.get();
+                context->IASetIndexBuffer(indexMeshBufferD3D11->getIndexBuffer(), indexMeshBufferD3D11->getIndexFormat(), 0);
 
                 D3D_PRIMITIVE_TOPOLOGY topology;
 
@@ -633,9 +623,7 @@ namespace ouzel
 
                 context->IASetPrimitiveTopology(topology);
 
-                context->DrawIndexed(drawCommand.indexCount, static_cast<UINT>(drawCommand.startIndex * meshBufferD3D11->getIndexSize()), 0);
-
-                drawCommands.pop();
+                context->DrawIndexed(drawCommand.indexCount, static_cast<UINT>(drawCommand.startIndex * indexMeshBufferD3D11->getIndexSize()), 0);
             }
 
             swapChain->Present(swapInterval, 0);
@@ -0,0 +1,181 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <cstring>
+#include <sys/ioctl.h>
+#include "GamepadEvdev.h"
+#include "math/MathUtils.h"
+#include "utils/Utils.h"
+#include <linux/input.h>
+
+namespace ouzel
+{
+    namespace input
+    {
+        static const float THUMB_DEADZONE = 0.2f;
+        static const float TRIGGER_THRESHOLD = 0.1f;
+
+        GamepadEvdev::GamepadEvdev(int pFd):
+            fd(pFd)
+        {
+            char deviceName[256];
+            memset(deviceName, 0, sizeof(deviceName));
+            if (ioctl(fd, EVIOCGNAME(sizeof(deviceName) - 1), deviceName) != -1)
+            {
+                name = deviceName;
+            }
+
+            for (uint32_t axis = 0; axis < AXIS_COUNT; ++axis)
+            {
+                input_absinfo info;
+                if (ioctl(fd, EVIOCGABS(axis), &info) != -1)
+                {
+                    axes[axis].minimum = info.minimum;
+                    axes[axis].maximum = info.maximum;
+                }
+            }
+        }
+
+        bool GamepadEvdev::isAttached() const
+        {
+            return attached;
+        }
+
+        void GamepadEvdev::handleEvent(const input_event& event)
+        {
+            if (event.type == EV_KEY)
+            {
+                GamepadButton button = GamepadButton::NONE;
+
+                switch (event.code)
+                {
+                    case BTN_SOUTH: button = GamepadButton::A; break;
+                    case BTN_EAST: button = GamepadButton::B; break;
+                    case BTN_NORTH: button = GamepadButton::Y; break;
+                    case BTN_WEST: button = GamepadButton::X; break;
+                    case BTN_TL: button = GamepadButton::LEFT_SHOULDER; break;
+                    case BTN_TR: button = GamepadButton::RIGHT_SHOULDER; break;
+                    case BTN_TL2: button = GamepadButton::LEFT_TRIGGER; break;
+                    case BTN_TR2: button = GamepadButton::RIGHT_TRIGGER; break;
+                    case BTN_THUMBL: button = GamepadButton::LEFT_THUMB; break;
+                    case BTN_THUMBR: button = GamepadButton::RIGHT_THUMB; break;
+                    case BTN_START: button = GamepadButton::START; break;
+                    case BTN_SELECT: button = GamepadButton::BACK; break;
+                    case BTN_MODE: button = GamepadButton::PAUSE; break;
+                    case BTN_DPAD_LEFT: button = GamepadButton::DPAD_LEFT; break;
+                    case BTN_DPAD_RIGHT: button = GamepadButton::DPAD_RIGHT; break;
+                    case BTN_DPAD_UP: button = GamepadButton::DPAD_UP; break;
+                    case BTN_DPAD_DOWN: button = GamepadButton::DPAD_DOWN; break;
+                    default: break;
+                }
+
+                // analog triggers report their own values
+                if (button != GamepadButton::NONE &&
+                    !((button == GamepadButton::LEFT_TRIGGER && (axes[ABS_Z].maximum || axes[ABS_HAT2Y].maximum)) ||
+                      (button == GamepadButton::RIGHT_TRIGGER && (axes[ABS_RZ].maximum || axes[ABS_HAT2X].maximum))))
+                {
+                    bool pressed = (event.value != 0);
+                    handleButtonValueChange(button, pressed, pressed ? 1.0f : 0.0f);
+                }
+            }
+            else if (event.type == EV_ABS && event.code < AXIS_COUNT)
+            {
+                switch (event.code)
+                {
+                    case ABS_X:
+                        handleAxis(event.code, event.value, GamepadButton::LEFT_THUMB_LEFT, GamepadButton::LEFT_THUMB_RIGHT);
+                        break;
+                    case ABS_Y:
+                        handleAxis(event.code, event.value, GamepadButton::LEFT_THUMB_UP, GamepadButton::LEFT_THUMB_DOWN);
+                        break;
+                    case ABS_RX:
+                        handleAxis(event.code, event.value, GamepadButton::RIGHT_THUMB_LEFT, GamepadButton::RIGHT_THUMB_RIGHT);
+                        break;
+                    case ABS_RY:
+                        handleAxis(event.code, event.value, GamepadButton::RIGHT_THUMB_UP, GamepadButton::RIGHT_THUMB_DOWN);
+                        break;
+                    case ABS_HAT0X:
+                        handleAxis(event.code, event.value, GamepadButton::DPAD_LEFT, GamepadButton::DPAD_RIGHT);
+                        break;
+                    case ABS_HAT0Y:
+                        handleAxis(event.code, event.value, GamepadButton::DPAD_UP, GamepadButton::DPAD_DOWN);
+                        break;
+                    case ABS_Z:
+                    case ABS_HAT2Y:
+                        handleTrigger(event.code, event.value, GamepadButton::LEFT_TRIGGER);
+                        break;
+                    case ABS_RZ:
+                    case ABS_HAT2X:
+                        handleTrigger(event.code, event.value, GamepadButton::RIGHT_TRIGGER);
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+
+        void GamepadEvdev::handleAxis(uint32_t axis, int32_t value, GamepadButton negativeButton, GamepadButton positiveButton)
+        {
+            AxisInfo& axisInfo = axes[axis];
+
+            float newValue;
+
+            if (axisInfo.maximum > axisInfo.minimum)
+            {
+                newValue = 2.0f * static_cast<float>(value - axisInfo.minimum) / static_cast<float>(axisInfo.maximum - axisInfo.minimum) - 1.0f;
+            }
+            else // hats report -1, 0 and 1
+            {
+                newValue = static_cast<float>(value);
+            }
+
+            newValue = clamp(newValue, -1.0f, 1.0f);
+
+            if (newValue > 0.0f)
+            {
+                if (axisInfo.value < 0.0f)
+                {
+                    handleButtonValueChange(negativeButton, false, 0.0f);
+                }
+
+                handleButtonValueChange(positiveButton, newValue > THUMB_DEADZONE, newValue);
+            }
+            else if (newValue < 0.0f)
+            {
+                if (axisInfo.value > 0.0f)
+                {
+                    handleButtonValueChange(positiveButton, false, 0.0f);
+                }
+
+                handleButtonValueChange(negativeButton, newValue < -THUMB_DEADZONE, -newValue);
+            }
+            else if (axisInfo.value > 0.0f)
+            {
+                handleButtonValueChange(positiveButton, false, 0.0f);
+            }
+            else if (axisInfo.value < 0.0f)
+            {
+                handleButtonValueChange(negativeButton, false, 0.0f);
+            }
+
+            axisInfo.value = newValue;
+        }
+
+        void GamepadEvdev::handleTrigger(uint32_t axis, int32_t value, GamepadButton button)
+        {
+            AxisInfo& axisInfo = axes[axis];
+
+            float newValue = (axisInfo.maximum > axisInfo.minimum) ?
+                static_cast<float>(value - axisInfo.minimum) / static_cast<float>(axisInfo.maximum - axisInfo.minimum) :
+                static_cast<float>(value != 0);
+
+            newValue = clamp(newValue, 0.0f, 1.0f);
+
+            if (newValue != axisInfo.value)
+            {
+                handleButtonValueChange(button, newValue > TRIGGER_THRESHOLD, newValue);
+                axisInfo.value = newValue;
+            }
+        }
+    } // namespace input
+} // namespace ouzel
@@ -0,0 +1,47 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <string>
+#include "input/Gamepad.h"
+
+struct input_event;
+
+namespace ouzel
+{
+    namespace input
+    {
+        class InputEvdev;
+
+        class GamepadEvdev: public Gamepad
+        {
+            friend InputEvdev;
+        public:
+            virtual bool isAttached() const override;
+
+            const std::string& getName() const { return name; }
+
+        protected:
+            GamepadEvdev(int pFd);
+
+            void handleEvent(const struct input_event& event);
+            void handleAxis(uint32_t axis, int32_t value, GamepadButton negativeButton, GamepadButton positiveButton);
+            void handleTrigger(uint32_t axis, int32_t value, GamepadButton button);
+
+            struct AxisInfo
+            {
+                int32_t minimum = 0;
+                int32_t maximum = 0;
+                float value = 0.0f;
+            };
+
+            static const uint32_t AXIS_COUNT = 0x40;
+
+            int fd;
+            bool attached = true;
+            std::string name;
+            AxisInfo axes[AXIS_COUNT];
+        };
+    } // namespace input
+} // namespace ouzel
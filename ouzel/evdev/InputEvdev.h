@@ -0,0 +1,124 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include "input/Input.h"
+#include "evdev/GamepadEvdev.h"
+
+struct input_event;
+
+namespace ouzel
+{
+    class Engine;
+
+    namespace input
+    {
+        struct InputDeviceEvdev
+        {
+            enum DeviceClass
+            {
+                CLASS_KEYBOARD = 1,
+                CLASS_MOUSE = 2,
+                CLASS_TOUCHPAD = 4,
+                CLASS_GAMEPAD = 8
+            };
+
+            struct Axis
+            {
+                int32_t minimum = 0;
+                int32_t maximum = 0;
+            };
+
+            struct TouchSlot
+            {
+                int32_t trackingId = -1;
+                bool began = false;
+                bool moved = false;
+                bool ended = false;
+                Vector2 position;
+            };
+
+            static const uint32_t MAX_TOUCH_SLOTS = 10;
+
+            std::string path;
+            uint32_t deviceClass = 0;
+            int fd = -1;
+            bool grabbed = false;
+            bool monotonicClock = false;
+            bool multiTouch = false;
+
+            Axis axisX;
+            Axis axisY;
+
+            // accumulated until the next SYN_REPORT
+            Vector2 relativeMove;
+            Vector2 absolutePosition;
+            bool absoluteMoved = false;
+            Vector2 scroll;
+
+            uint32_t currentSlot = 0;
+            TouchSlot touchSlots[MAX_TOUCH_SLOTS];
+
+            std::shared_ptr<GamepadEvdev> gamepad;
+        };
+
+        /**
+         * Reads Linux evdev devices (/dev/input/event*) on a dedicated thread.
+         * The thread sleeps in epoll_wait on the device file descriptors, an inotify watch of
+         * /dev/input for hot-plugging and an eventfd for shutdown, so events reach the
+         * event dispatcher as soon as the kernel delivers them instead of once per frame.
+         */
+        class InputEvdev: public Input
+        {
+            friend Engine;
+        public:
+            virtual ~InputEvdev();
+
+            virtual void update() override;
+
+            /**
+             * Adds an already opened device, for example the read end of a pipe or a uinput device.
+             * The device class is detected from the event bits if deviceClass is 0.
+             * Takes ownership of the file descriptor.
+             */
+            bool addDevice(int fd, uint32_t deviceClass = 0, const std::string& path = "");
+            bool addDevice(const std::string& path);
+
+            uint32_t getDeviceCount() const;
+
+        protected:
+            InputEvdev(uint32_t pDeviceClasses, bool pGrab);
+
+            void run();
+            void scanDevices();
+            void handleHotplug();
+            bool readDevice(InputDeviceEvdev& inputDevice);
+            void handleEvent(InputDeviceEvdev& inputDevice, const struct input_event& event);
+            void handleSync(InputDeviceEvdev& inputDevice, const struct input_event& event);
+            void flushMouse(InputDeviceEvdev& inputDevice, uint64_t timestamp);
+            void removeDevice(int fd);
+            Vector2 convertAbsolutePosition(const InputDeviceEvdev& inputDevice, const Vector2& position) const;
+
+            uint32_t deviceClasses;
+            bool grab;
+            uint32_t modifiers = 0;
+
+            int epollFd = -1;
+            int eventFd = -1;
+            int inotifyFd = -1;
+
+            mutable std::mutex devicesMutex;
+            std::map<int, std::unique_ptr<InputDeviceEvdev>> inputDevices;
+
+            std::atomic<bool> running;
+            std::thread inputThread;
+        };
+    } // namespace input
+} // namespace ouzel
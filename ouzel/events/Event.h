@@ -36,6 +36,7 @@ namespace ouzel
         uint32_t modifiers = 0;
         input::MouseButton button = input::MouseButton::NONE;
         Vector2 position;
+        Vector2 difference; // movement since the previous move event
         Vector2 scroll;
     };
 
@@ -119,6 +120,7 @@ namespace ouzel
         };
 
         Type type;
+        uint64_t timestamp = 0; // time of the input in microseconds (getCurrentMicroSeconds), set on dispatch if 0
 
         KeyboardEvent keyboardEvent;
         MouseEvent mouseEvent;
@@ -2,165 +2,511 @@
 // This file is part of the Ouzel engine.
 
 #include <algorithm>
+#include <cstdint>
 #include "EventDispatcher.h"
+#include "utils/Utils.h"
 
 namespace ouzel
 {
-    EventDispatcher::EventDispatcher()
+    EventDispatcher::EventDispatcher():
+        queueCells(new QueueCell[QUEUE_SIZE]), enqueuePosition(0), overflow(false), overflowCount(0)
     {
-
+        for (size_t i = 0; i < QUEUE_SIZE; ++i)
+        {
+            queueCells[i].sequence.store(i, std::memory_order_relaxed);
+        }
     }
 
     EventDispatcher::~EventDispatcher()
     {
+        drainEvents();
+
+        for (const QueuedEvent& queuedEvent : pendingEvents)
+        {
+            delete queuedEvent.event;
+        }
+    }
+
+    uint32_t EventDispatcher::getCategory(Event::Type type)
+    {
+        switch (type)
+        {
+            case Event::Type::KEY_DOWN:
+            case Event::Type::KEY_UP:
+            case Event::Type::KEY_REPEAT:
+                return EventHandler::CATEGORY_KEYBOARD;
+            case Event::Type::MOUSE_DOWN:
+            case Event::Type::MOUSE_UP:
+            case Event::Type::MOUSE_SCROLL:
+            case Event::Type::MOUSE_MOVE:
+                return EventHandler::CATEGORY_MOUSE;
+            case Event::Type::TOUCH_BEGIN:
+            case Event::Type::TOUCH_MOVE:
+            case Event::Type::TOUCH_END:
+            case Event::Type::TOUCH_CANCEL:
+                return EventHandler::CATEGORY_TOUCH;
+            case Event::Type::GAMEPAD_CONNECT:
+            case Event::Type::GAMEPAD_DISCONNECT:
+            case Event::Type::GAMEPAD_BUTTON_CHANGE:
+                return EventHandler::CATEGORY_GAMEPAD;
+            case Event::Type::WINDOW_SIZE_CHANGE:
+            case Event::Type::WINDOW_TITLE_CHANGE:
+            case Event::Type::WINDOW_FULLSCREEN_CHANGE:
+                return EventHandler::CATEGORY_WINDOW;
+            case Event::Type::ORIENTATION_CHANGE:
+            case Event::Type::LOW_MEMORY:
+            case Event::Type::OPEN_FILE:
+                return EventHandler::CATEGORY_SYSTEM;
+            case Event::Type::UI_ENTER_NODE:
+            case Event::Type::UI_LEAVE_NODE:
+            case Event::Type::UI_PRESS_NODE:
+            case Event::Type::UI_RELEASE_NODE:
+            case Event::Type::UI_CLICK_NODE:
+            case Event::Type::UI_DRAG_NODE:
+            case Event::Type::UI_WIDGET_CHANGE:
+                return EventHandler::CATEGORY_UI;
+        }
 
+        return EventHandler::CATEGORY_COUNT;
     }
 
     void EventDispatcher::update()
     {
         Event event;
 
+        moveHistory.clear();
+        inputTimestamps.clear();
+        inputEvents.clear();
+
+        // handlers can dispatch new events, which are handled in the same update
         for (;;)
         {
+            drainEvents();
+
+            if (pendingEvents.empty())
             {
-                std::lock_guard<std::mutex> lock(queueMutex);
-                if (eventQueue.empty())
+                break;
+            }
+
+            for (const QueuedEvent& queuedEvent : pendingEvents)
+            {
+                uint32_t category = getCategory(queuedEvent.type);
+
+                if (category == EventHandler::CATEGORY_KEYBOARD ||
+                    category == EventHandler::CATEGORY_MOUSE ||
+                    category == EventHandler::CATEGORY_TOUCH ||
+                    queuedEvent.type == Event::Type::GAMEPAD_BUTTON_CHANGE)
                 {
-                    break;
-                }
+                    inputTimestamps.push_back(queuedEvent.timestamp);
 
-                event = eventQueue.front();
-                eventQueue.pop();
+                    if (inputRecording && category != EventHandler::CATEGORY_GAMEPAD)
+                    {
+                        inputEvents.emplace_back();
+                        unpackEvent(queuedEvent, inputEvents.back());
+                    }
+                }
             }
 
-            bool propagate = true;
+            if (moveCoalescing)
+            {
+                coalesceEvents();
+            }
 
-            for (eventHandlerIterator = eventHandlers.begin(); eventHandlerIterator != eventHandlers.end();)
+            for (const QueuedEvent& queuedEvent : pendingEvents)
             {
-                eventHandlerDeleted = false;
+                unpackEvent(queuedEvent, event);
+
+                uint32_t category = getCategory(event.type);
+
+                if (category == EventHandler::CATEGORY_COUNT)
+                {
+                    continue;
+                }
 
-                const EventHandler* eventHandler = *eventHandlerIterator;
-                if (eventHandler)
+                dispatching = true;
+
+                for (std::pair<const int32_t, EventHandlerBucket>& bucketPair : eventHandlers[category])
                 {
-                    switch (event.type)
+                    EventHandlerBucket& bucket = bucketPair.second;
+
+                    // handlers added during the dispatch receive the next event
+                    size_t count = bucket.eventHandlers.size();
+                    bool propagate = true;
+
+                    for (size_t i = 0; i < count; ++i)
                     {
-                        case Event::Type::KEY_DOWN:
-                        case Event::Type::KEY_UP:
-                        case Event::Type::KEY_REPEAT:
-                            if (eventHandler->keyboardHandler)
-                            {
-                                propagate = eventHandler->keyboardHandler(event.type, event.keyboardEvent);
-                            }
-                            break;
+                        const EventHandler* eventHandler = bucket.eventHandlers[i];
 
-                        case Event::Type::MOUSE_DOWN:
-                        case Event::Type::MOUSE_UP:
-                        case Event::Type::MOUSE_SCROLL:
-                        case Event::Type::MOUSE_MOVE:
-                            if (eventHandler->mouseHandler)
-                            {
-                                propagate = eventHandler->mouseHandler(event.type, event.mouseEvent);
-                            }
-                            break;
-                        case Event::Type::TOUCH_BEGIN:
-                        case Event::Type::TOUCH_MOVE:
-                        case Event::Type::TOUCH_END:
-                        case Event::Type::TOUCH_CANCEL:
-                            if (eventHandler->touchHandler)
-                            {
-                                propagate = eventHandler->touchHandler(event.type, event.touchEvent);
-                            }
-                            break;
-                        case Event::Type::GAMEPAD_CONNECT:
-                        case Event::Type::GAMEPAD_DISCONNECT:
-                        case Event::Type::GAMEPAD_BUTTON_CHANGE:
-                            if (eventHandler->gamepadHandler)
-                            {
-                                propagate = eventHandler->gamepadHandler(event.type, event.gamepadEvent);
-                            }
-                            break;
-                        case Event::Type::WINDOW_SIZE_CHANGE:
-                        case Event::Type::WINDOW_TITLE_CHANGE:
-                        case Event::Type::WINDOW_FULLSCREEN_CHANGE:
-                            if (eventHandler->windowHandler)
-                            {
-                                propagate = eventHandler->windowHandler(event.type, event.windowEvent);
-                            }
-                            break;
-                        case Event::Type::ORIENTATION_CHANGE:
-                        case Event::Type::LOW_MEMORY:
-                        case Event::Type::OPEN_FILE:
-                            if (eventHandler->systemHandler)
-                            {
-                                propagate = eventHandler->systemHandler(event.type, event.systemEvent);
-                            }
-                            break;
-                        case Event::Type::UI_ENTER_NODE:
-                        case Event::Type::UI_LEAVE_NODE:
-                        case Event::Type::UI_PRESS_NODE:
-                        case Event::Type::UI_RELEASE_NODE:
-                        case Event::Type::UI_CLICK_NODE:
-                        case Event::Type::UI_DRAG_NODE:
-                        case Event::Type::UI_WIDGET_CHANGE:
-                            if (eventHandler->uiHandler)
-                            {
-                                propagate = eventHandler->uiHandler(event.type, event.uiEvent);
-                            }
+                        if (eventHandler && !handleEvent(eventHandler, event))
+                        {
+                            propagate = false;
                             break;
+                        }
+                    }
+
+                    if (!propagate)
+                    {
+                        break;
                     }
                 }
 
-                if (!propagate)
+                dispatching = false;
+
+                for (std::pair<const int32_t, EventHandlerBucket>& bucketPair : eventHandlers[category])
                 {
-                    break;
+                    if (bucketPair.second.removedCount)
+                    {
+                        compactBucket(bucketPair.second);
+                    }
                 }
+            }
+        }
+    }
 
-                // current element wasn't delete from the list
-                if (!eventHandlerDeleted)
+    void EventDispatcher::drainEvents()
+    {
+        pendingEvents.clear();
+
+        for (;;)
+        {
+            QueueCell& cell = queueCells[dequeuePosition & (QUEUE_SIZE - 1)];
+
+            if (cell.sequence.load(std::memory_order_acquire) != dequeuePosition + 1)
+            {
+                break;
+            }
+
+            pendingEvents.push_back(cell.event);
+            cell.sequence.store(dequeuePosition + QUEUE_SIZE, std::memory_order_release);
+            ++dequeuePosition;
+        }
+
+        // overflowed events were pushed after the ones in the ring buffer
+        if (overflow.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(overflowMutex);
+            pendingEvents.insert(pendingEvents.end(), overflowEvents.begin(), overflowEvents.end());
+            overflowEvents.clear();
+            overflow.store(false, std::memory_order_release);
+        }
+    }
+
+    void EventDispatcher::coalesceEvents()
+    {
+        coalescedEvents.clear();
+
+        // index of the last move event of each pointer that later moves can still be merged into
+        size_t mouseMove = SIZE_MAX;
+        std::vector<std::pair<uint64_t, size_t>> touchMoves;
+
+        for (const QueuedEvent& queuedEvent : pendingEvents)
+        {
+            if (queuedEvent.type == Event::Type::MOUSE_MOVE)
+            {
+                ++moveEventCount;
+                moveHistory.push_back({ queuedEvent.type, 0, Vector2(queuedEvent.x, queuedEvent.y) });
+
+                if (mouseMove != SIZE_MAX && coalescedEvents[mouseMove].modifiers == queuedEvent.modifiers)
+                {
+                    QueuedEvent& previousEvent = coalescedEvents[mouseMove];
+                    previousEvent.x = queuedEvent.x;
+                    previousEvent.y = queuedEvent.y;
+                    previousEvent.differenceX += queuedEvent.differenceX;
+                    previousEvent.differenceY += queuedEvent.differenceY;
+                    ++coalescedMoveEventCount;
+                }
+                else
                 {
-                    ++eventHandlerIterator;
+                    mouseMove = coalescedEvents.size();
+                    coalescedEvents.push_back(queuedEvent);
                 }
             }
+            else if (queuedEvent.type == Event::Type::TOUCH_MOVE)
+            {
+                ++moveEventCount;
+                moveHistory.push_back({ queuedEvent.type, queuedEvent.touchId, Vector2(queuedEvent.x, queuedEvent.y) });
+
+                std::vector<std::pair<uint64_t, size_t>>::iterator i = std::find_if(touchMoves.begin(), touchMoves.end(), [&queuedEvent](const std::pair<uint64_t, size_t>& touchMove) {
+                    return touchMove.first == queuedEvent.touchId;
+                });
+
+                if (i != touchMoves.end())
+                {
+                    QueuedEvent& previousEvent = coalescedEvents[i->second];
+                    previousEvent.x = queuedEvent.x;
+                    previousEvent.y = queuedEvent.y;
+                    ++coalescedMoveEventCount;
+                }
+                else
+                {
+                    touchMoves.push_back(std::make_pair(queuedEvent.touchId, coalescedEvents.size()));
+                    coalescedEvents.push_back(queuedEvent);
+                }
+            }
+            else
+            {
+                // moves can't be merged across other events, that would change their order
+                mouseMove = SIZE_MAX;
+                touchMoves.clear();
+                coalescedEvents.push_back(queuedEvent);
+            }
+        }
+
+        pendingEvents.swap(coalescedEvents);
+    }
+
+    void EventDispatcher::unpackEvent(const QueuedEvent& queuedEvent, Event& event)
+    {
+        if (queuedEvent.event)
+        {
+            event = std::move(*queuedEvent.event);
+            delete queuedEvent.event;
+            return;
+        }
+
+        event.type = queuedEvent.type;
+        event.timestamp = queuedEvent.timestamp;
+
+        switch (queuedEvent.type)
+        {
+            case Event::Type::KEY_DOWN:
+            case Event::Type::KEY_UP:
+            case Event::Type::KEY_REPEAT:
+                event.keyboardEvent.modifiers = queuedEvent.modifiers;
+                event.keyboardEvent.key = static_cast<input::KeyboardKey>(queuedEvent.button);
+                break;
+            case Event::Type::MOUSE_DOWN:
+            case Event::Type::MOUSE_UP:
+            case Event::Type::MOUSE_SCROLL:
+            case Event::Type::MOUSE_MOVE:
+                event.mouseEvent.modifiers = queuedEvent.modifiers;
+                event.mouseEvent.button = static_cast<input::MouseButton>(queuedEvent.button);
+                event.mouseEvent.position = Vector2(queuedEvent.x, queuedEvent.y);
+                event.mouseEvent.difference = Vector2(queuedEvent.differenceX, queuedEvent.differenceY);
+                event.mouseEvent.scroll = Vector2(queuedEvent.scrollX, queuedEvent.scrollY);
+                break;
+            case Event::Type::TOUCH_BEGIN:
+            case Event::Type::TOUCH_MOVE:
+            case Event::Type::TOUCH_END:
+            case Event::Type::TOUCH_CANCEL:
+                event.touchEvent.touchId = queuedEvent.touchId;
+                event.touchEvent.position = Vector2(queuedEvent.x, queuedEvent.y);
+                break;
+            default:
+                break;
         }
     }
 
+    bool EventDispatcher::handleEvent(const EventHandler* eventHandler, const Event& event)
+    {
+        // the handler functions can be reset after the handler was added, missing ones let the event propagate
+        switch (event.type)
+        {
+            case Event::Type::KEY_DOWN:
+            case Event::Type::KEY_UP:
+            case Event::Type::KEY_REPEAT:
+                return !eventHandler->keyboardHandler || eventHandler->keyboardHandler(event.type, event.keyboardEvent);
+            case Event::Type::MOUSE_DOWN:
+            case Event::Type::MOUSE_UP:
+            case Event::Type::MOUSE_SCROLL:
+            case Event::Type::MOUSE_MOVE:
+                return !eventHandler->mouseHandler || eventHandler->mouseHandler(event.type, event.mouseEvent);
+            case Event::Type::TOUCH_BEGIN:
+            case Event::Type::TOUCH_MOVE:
+            case Event::Type::TOUCH_END:
+            case Event::Type::TOUCH_CANCEL:
+                return !eventHandler->touchHandler || eventHandler->touchHandler(event.type, event.touchEvent);
+            case Event::Type::GAMEPAD_CONNECT:
+            case Event::Type::GAMEPAD_DISCONNECT:
+            case Event::Type::GAMEPAD_BUTTON_CHANGE:
+                return !eventHandler->gamepadHandler || eventHandler->gamepadHandler(event.type, event.gamepadEvent);
+            case Event::Type::WINDOW_SIZE_CHANGE:
+            case Event::Type::WINDOW_TITLE_CHANGE:
+            case Event::Type::WINDOW_FULLSCREEN_CHANGE:
+                return !eventHandler->windowHandler || eventHandler->windowHandler(event.type, event.windowEvent);
+            case Event::Type::ORIENTATION_CHANGE:
+            case Event::Type::LOW_MEMORY:
+            case Event::Type::OPEN_FILE:
+                return !eventHandler->systemHandler || eventHandler->systemHandler(event.type, event.systemEvent);
+            case Event::Type::UI_ENTER_NODE:
+            case Event::Type::UI_LEAVE_NODE:
+            case Event::Type::UI_PRESS_NODE:
+            case Event::Type::UI_RELEASE_NODE:
+            case Event::Type::UI_CLICK_NODE:
+            case Event::Type::UI_DRAG_NODE:
+            case Event::Type::UI_WIDGET_CHANGE:
+                return !eventHandler->uiHandler || eventHandler->uiHandler(event.type, event.uiEvent);
+        }
+
+        return true;
+    }
+
     void EventDispatcher::addEventHandler(const EventHandler& eventHandler)
     {
-        std::list<const EventHandler*>::iterator i = std::find(eventHandlers.begin(), eventHandlers.end(), &eventHandler);
+        if (eventHandler.added)
+        {
+            return;
+        }
 
-        if (i == eventHandlers.end())
+        eventHandler.added = true;
+
+        // the handler is added to all the categories, because its functions can be set after it was added
+        for (uint32_t category = 0; category < EventHandler::CATEGORY_COUNT; ++category)
         {
-            eventHandlers.push_back(&eventHandler);
+            EventHandlerBucket& bucket = eventHandlers[category][eventHandler.priority];
 
-            eventHandlers.sort([](const EventHandler* a, const EventHandler* b) {
-                return a->priority < b->priority;
-            });
+            eventHandler.buckets[category] = &bucket;
+            eventHandler.slots[category] = bucket.eventHandlers.size();
+            bucket.eventHandlers.push_back(&eventHandler);
         }
     }
 
     void EventDispatcher::removeEventHandler(const EventHandler& eventHandler)
     {
-        std::list<const EventHandler*>::iterator i = std::find(eventHandlers.begin(), eventHandlers.end(), &eventHandler);
+        if (!eventHandler.added)
+        {
+            return;
+        }
+
+        eventHandler.added = false;
 
-        if (i != eventHandlers.end())
+        for (uint32_t category = 0; category < EventHandler::CATEGORY_COUNT; ++category)
         {
-            // increment the iterator if current element is deleted
-            if (i == eventHandlerIterator)
+            if (EventHandlerBucket* bucket = eventHandler.buckets[category])
             {
-                eventHandlerIterator = eventHandlers.erase(i);
-                eventHandlerDeleted = true;
+                // the slot is cleared and removed later to keep the order and the indices of the dispatch loop valid
+                bucket->eventHandlers[eventHandler.slots[category]] = nullptr;
+                ++bucket->removedCount;
+                eventHandler.buckets[category] = nullptr;
+
+                if (!dispatching && bucket->removedCount * 2 > bucket->eventHandlers.size())
+                {
+                    compactBucket(*bucket);
+                }
             }
-            else
+        }
+    }
+
+    void EventDispatcher::compactBucket(EventHandlerBucket& bucket)
+    {
+        size_t count = 0;
+
+        for (const EventHandler* eventHandler : bucket.eventHandlers)
+        {
+            if (eventHandler)
             {
-                eventHandlers.erase(i);
+                // a handler is in at most one bucket of each category, find its slot in this one
+                for (uint32_t category = 0; category < EventHandler::CATEGORY_COUNT; ++category)
+                {
+                    if (eventHandler->buckets[category] == &bucket)
+                    {
+                        eventHandler->slots[category] = count;
+                        break;
+                    }
+                }
+
+                bucket.eventHandlers[count++] = eventHandler;
             }
         }
+
+        bucket.eventHandlers.resize(count);
+        bucket.removedCount = 0;
     }
 
     void EventDispatcher::dispatchEvent(const Event& event)
     {
-        std::lock_guard<std::mutex> lock(queueMutex);
+        QueuedEvent queuedEvent;
+        queuedEvent.type = event.type;
+        queuedEvent.modifiers = 0;
+        queuedEvent.button = 0;
+        queuedEvent.x = 0.0f;
+        queuedEvent.y = 0.0f;
+        queuedEvent.differenceX = 0.0f;
+        queuedEvent.differenceY = 0.0f;
+        queuedEvent.scrollX = 0.0f;
+        queuedEvent.scrollY = 0.0f;
+        queuedEvent.touchId = 0;
+        queuedEvent.timestamp = event.timestamp ? event.timestamp : getCurrentMicroSeconds();
+        queuedEvent.event = nullptr;
 
-        eventQueue.push(event);
+        switch (event.type)
+        {
+            case Event::Type::KEY_DOWN:
+            case Event::Type::KEY_UP:
+            case Event::Type::KEY_REPEAT:
+                queuedEvent.modifiers = event.keyboardEvent.modifiers;
+                queuedEvent.button = static_cast<uint32_t>(event.keyboardEvent.key);
+                break;
+            case Event::Type::MOUSE_DOWN:
+            case Event::Type::MOUSE_UP:
+            case Event::Type::MOUSE_SCROLL:
+            case Event::Type::MOUSE_MOVE:
+                queuedEvent.modifiers = event.mouseEvent.modifiers;
+                queuedEvent.button = static_cast<uint32_t>(event.mouseEvent.button);
+                queuedEvent.x = event.mouseEvent.position.x;
+                queuedEvent.y = event.mouseEvent.position.y;
+                queuedEvent.differenceX = event.mouseEvent.difference.x;
+                queuedEvent.differenceY = event.mouseEvent.difference.y;
+                queuedEvent.scrollX = event.mouseEvent.scroll.x;
+                queuedEvent.scrollY = event.mouseEvent.scroll.y;
+                break;
+            case Event::Type::TOUCH_BEGIN:
+            case Event::Type::TOUCH_MOVE:
+            case Event::Type::TOUCH_END:
+            case Event::Type::TOUCH_CANCEL:
+                queuedEvent.touchId = event.touchEvent.touchId;
+                queuedEvent.x = event.touchEvent.position.x;
+                queuedEvent.y = event.touchEvent.position.y;
+                break;
+            default:
+                queuedEvent.event = new Event(event);
+                queuedEvent.event->timestamp = queuedEvent.timestamp;
+                break;
+        }
+
+        // once an event is in the overflow list, the following events of this thread must go there too
+        if (overflow.load(std::memory_order_acquire) || !pushEvent(queuedEvent))
+        {
+            std::lock_guard<std::mutex> lock(overflowMutex);
+
+            // the overflow list could have been drained since the check above, so the ring buffer can be used again
+            if (overflow.load(std::memory_order_relaxed) || !pushEvent(queuedEvent))
+            {
+                overflowEvents.push_back(queuedEvent);
+                overflow.store(true, std::memory_order_release);
+                ++overflowCount;
+            }
+        }
+    }
+
+    bool EventDispatcher::pushEvent(const QueuedEvent& queuedEvent)
+    {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            QueueCell& cell = queueCells[position & (QUEUE_SIZE - 1)];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            if (difference == 0)
+            {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.event = queuedEvent;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                // full
+                return false;
+            }
+            else
+            {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
     }
 }
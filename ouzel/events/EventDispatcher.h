@@ -3,10 +3,11 @@
 
 #pragma once
 
-#include <list>
+#include <map>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <vector>
+#include <atomic>
 #include <cstdint>
 #include "utils/Types.h"
 #include "utils/Noncopyable.h"
@@ -28,15 +29,107 @@ namespace ouzel
         void addEventHandler(const EventHandler& eventHandler);
         void removeEventHandler(const EventHandler& eventHandler);
 
+        // can be called from any thread, events are delivered in the order they were dispatched by one thread
+        // (and after the events that thread had observed being dispatched), events dispatched concurrently by different threads can be delivered in any order
         void dispatchEvent(const Event& event);
 
+        // events that didn't fit into the queue and were stored in the overflow list
+        uint64_t getOverflowCount() const { return overflowCount; }
+
+        struct MoveSample
+        {
+            Event::Type type; // MOUSE_MOVE or TOUCH_MOVE
+            uint64_t touchId;
+            Vector2 position;
+        };
+
+        /**
+         * Consecutive move events of the same mouse or touch are merged into one per update,
+         * keeping the latest position and the summed difference.
+         */
+        void setMoveCoalescing(bool enabled) { moveCoalescing = enabled; }
+        bool isMoveCoalescing() const { return moveCoalescing; }
+
+        // all move samples received in the current update at full rate (only recorded while coalescing)
+        const std::vector<MoveSample>& getMoveHistory() const { return moveHistory; }
+
+        uint64_t getMoveEventCount() const { return moveEventCount; }
+        uint64_t getCoalescedMoveEventCount() const { return coalescedMoveEventCount; }
+        // share of move events that were merged into others
+        float getCoalescingRatio() const { return moveEventCount ? static_cast<float>(coalescedMoveEventCount) / static_cast<float>(moveEventCount) : 0.0f; }
+
+        // timestamps of the keyboard, mouse, touch and gamepad events received in the current update (before coalescing)
+        const std::vector<uint64_t>& getInputTimestamps() const { return inputTimestamps; }
+
+        // keeps the keyboard, mouse and touch events received in the current update (before coalescing) for the event recorder
+        void setInputRecording(bool enabled) { inputRecording = enabled; }
+        bool isInputRecording() const { return inputRecording; }
+        const std::vector<Event>& getInputEvents() const { return inputEvents; }
+
     protected:
+        static const size_t QUEUE_SIZE = 4096; // must be a power of two
+
+        // keyboard, mouse and touch events are stored inline, other (rare) events are allocated
+        struct QueuedEvent
+        {
+            Event::Type type;
+            uint32_t modifiers;
+            uint32_t button;
+            float x;
+            float y;
+            float differenceX;
+            float differenceY;
+            float scrollX;
+            float scrollY;
+            uint64_t touchId;
+            uint64_t timestamp;
+            Event* event;
+        };
+
+        // bounded multi-producer single-consumer ring buffer
+        struct QueueCell
+        {
+            std::atomic<size_t> sequence;
+            QueuedEvent event;
+        };
+
         EventDispatcher();
 
-        std::list<const EventHandler*> eventHandlers;
-        std::list<const EventHandler*>::iterator eventHandlerIterator;
-        bool eventHandlerDeleted = false;
-        std::queue<Event> eventQueue;
-        std::mutex queueMutex;
+        bool pushEvent(const QueuedEvent& queuedEvent);
+        void drainEvents();
+        void coalesceEvents();
+        static void unpackEvent(const QueuedEvent& queuedEvent, Event& event);
+
+        static uint32_t getCategory(Event::Type type);
+        static bool handleEvent(const EventHandler* eventHandler, const Event& event);
+        void compactBucket(EventHandlerBucket& bucket);
+
+        // handlers of each event category sorted by priority, buckets are never removed, so handlers can keep pointers to them
+        std::map<int32_t, EventHandlerBucket> eventHandlers[EventHandler::CATEGORY_COUNT];
+        bool dispatching = false;
+
+        std::unique_ptr<QueueCell[]> queueCells;
+        std::atomic<size_t> enqueuePosition;
+        size_t dequeuePosition = 0;
+
+        // used only when the ring buffer is full, while it isn't empty all producers write to it to keep the order
+        std::vector<QueuedEvent> overflowEvents;
+        std::atomic<bool> overflow;
+        std::atomic<uint64_t> overflowCount;
+        std::mutex overflowMutex;
+
+        // drained batch, reused between updates
+        std::vector<QueuedEvent> pendingEvents;
+        std::vector<QueuedEvent> coalescedEvents;
+
+        bool moveCoalescing = true;
+        std::vector<MoveSample> moveHistory;
+        uint64_t moveEventCount = 0;
+        uint64_t coalescedMoveEventCount = 0;
+
+        std::vector<uint64_t> inputTimestamps;
+
+        bool inputRecording = false;
+        std::vector<Event> inputEvents;
     };
 }
@@ -4,12 +4,20 @@
 #pragma once
 
 #include <functional>
+#include <vector>
 #include <cstdint>
 #include "events/Event.h"
 
 namespace ouzel
 {
     class EventDispatcher;
+    class EventHandler;
+
+    struct EventHandlerBucket
+    {
+        std::vector<const EventHandler*> eventHandlers;
+        uint32_t removedCount = 0;
+    };
 
     class EventHandler
     {
@@ -19,6 +27,32 @@ namespace ouzel
 
         EventHandler(int32_t pPriority = 0): priority(pPriority) { }
 
+        // copies are not added to the dispatcher
+        EventHandler(const EventHandler& other):
+            keyboardHandler(other.keyboardHandler),
+            mouseHandler(other.mouseHandler),
+            touchHandler(other.touchHandler),
+            gamepadHandler(other.gamepadHandler),
+            windowHandler(other.windowHandler),
+            systemHandler(other.systemHandler),
+            uiHandler(other.uiHandler),
+            priority(other.priority)
+        {
+        }
+
+        EventHandler& operator=(const EventHandler& other)
+        {
+            keyboardHandler = other.keyboardHandler;
+            mouseHandler = other.mouseHandler;
+            touchHandler = other.touchHandler;
+            gamepadHandler = other.gamepadHandler;
+            windowHandler = other.windowHandler;
+            systemHandler = other.systemHandler;
+            uiHandler = other.uiHandler;
+            return *this;
+        }
+
+        // the functions can be set or reset while the handler is added to the dispatcher
         std::function<bool(Event::Type, const KeyboardEvent&)> keyboardHandler;
         std::function<bool(Event::Type, const MouseEvent&)> mouseHandler;
         std::function<bool(Event::Type, const TouchEvent&)> touchHandler;
@@ -28,6 +62,23 @@ namespace ouzel
         std::function<bool(Event::Type, const UIEvent&)> uiHandler;
 
     protected:
+        enum Category
+        {
+            CATEGORY_KEYBOARD,
+            CATEGORY_MOUSE,
+            CATEGORY_TOUCH,
+            CATEGORY_GAMEPAD,
+            CATEGORY_WINDOW,
+            CATEGORY_SYSTEM,
+            CATEGORY_UI,
+            CATEGORY_COUNT
+        };
+
         int32_t priority;
+
+        // position in the dispatcher's handler list of each category
+        mutable bool added = false;
+        mutable EventHandlerBucket* buckets[CATEGORY_COUNT] = {};
+        mutable size_t slots[CATEGORY_COUNT] = {};
     };
 }
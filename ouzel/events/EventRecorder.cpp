@@ -0,0 +1,506 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <cstring>
+#include "EventRecorder.h"
+#include "EventDispatcher.h"
+#include "core/Engine.h"
+#include "input/Input.h"
+#include "utils/Random.h"
+#include "utils/Utils.h"
+
+namespace ouzel
+{
+    static const uint8_t MAGIC[4] = { 'O', 'U', 'Z', 'R' };
+    static const uint32_t VERSION = 2;
+    static const size_t FLUSH_SIZE = 65536;
+
+    // the header (magic, uint32 version, uint64 random seed) is followed by the frames,
+    // every frame starts with a frame record followed by the input events handled in it,
+    // values are stored in the native byte order
+    enum RecordType
+    {
+        RECORD_FRAME = 1, // float delta
+        RECORD_KEYBOARD = 2, // uint8 type, uint32 time, uint32 modifiers, uint32 key
+        RECORD_MOUSE = 3, // uint8 type, uint32 time, uint32 modifiers, uint8 button, float x, float y (, float scroll x, float scroll y)
+        RECORD_TOUCH = 4 // uint8 type, uint32 time, uint64 touch id, float x, float y
+    };
+
+    EventRecorder::EventRecorder():
+        recording(false), replaying(false)
+    {
+    }
+
+    EventRecorder::~EventRecorder()
+    {
+        if (recording)
+        {
+            stopRecording();
+        }
+    }
+
+    template<class T> void EventRecorder::write(const T& value)
+    {
+        size_t size = buffer.size();
+        buffer.resize(size + sizeof(T));
+        memcpy(buffer.data() + size, &value, sizeof(T));
+    }
+
+    template<class T> bool EventRecorder::read(T& value)
+    {
+        if (data.size() - offset < sizeof(T))
+        {
+            return false;
+        }
+
+        memcpy(&value, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+
+        return true;
+    }
+
+    bool EventRecorder::startRecording(const std::string& filename)
+    {
+        if (recording)
+        {
+            stopRecording();
+        }
+
+        if (replaying)
+        {
+            log("Can't record input while replaying");
+            return false;
+        }
+
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+
+        if (!file)
+        {
+            log("Failed to open file %s", filename.c_str());
+            return false;
+        }
+
+        // seeded from std::random_device, the thread instance will be reseeded with it
+        uint64_t newSeed = Random().next64();
+
+        file.write(reinterpret_cast<const char*>(MAGIC), sizeof(MAGIC));
+        file.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+        file.write(reinterpret_cast<const char*>(&newSeed), sizeof(newSeed));
+
+        if (!file)
+        {
+            log("Failed to write file %s", filename.c_str());
+            return false;
+        }
+
+        recordFilename = filename;
+        seed = newSeed;
+        sharedEngine->setRandomSeed(seed);
+        buffer.clear();
+        previousTimestamp = getCurrentMicroSeconds();
+        frameCount = 0;
+
+        sharedEngine->getEventDispatcher()->setInputRecording(true);
+        recording = true;
+
+        return true;
+    }
+
+    bool EventRecorder::stopRecording()
+    {
+        if (!recording)
+        {
+            return false;
+        }
+
+        recording = false;
+        sharedEngine->getEventDispatcher()->setInputRecording(false);
+
+        if (!flush())
+        {
+            return false;
+        }
+
+        log("Recorded %u frames to %s", frameCount, recordFilename.c_str());
+
+        return true;
+    }
+
+    bool EventRecorder::flush()
+    {
+        if (buffer.empty())
+        {
+            return true;
+        }
+
+        std::ofstream file(recordFilename, std::ios::binary | std::ios::app);
+
+        if (!file)
+        {
+            log("Failed to open file %s", recordFilename.c_str());
+            return false;
+        }
+
+        file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        buffer.clear();
+
+        if (!file)
+        {
+            log("Failed to write file %s", recordFilename.c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    void EventRecorder::recordFrame(float delta, const std::vector<Event>& events)
+    {
+        write(static_cast<uint8_t>(RECORD_FRAME));
+        write(delta);
+
+        for (const Event& event : events)
+        {
+            // time since the previous event, so that the recording doesn't depend on the clock
+            uint32_t time = 0;
+
+            if (event.timestamp > previousTimestamp)
+            {
+                time = static_cast<uint32_t>(std::min(event.timestamp - previousTimestamp, static_cast<uint64_t>(UINT32_MAX)));
+                previousTimestamp = event.timestamp;
+            }
+
+            switch (event.type)
+            {
+                case Event::Type::KEY_DOWN:
+                case Event::Type::KEY_UP:
+                case Event::Type::KEY_REPEAT:
+                    write(static_cast<uint8_t>(RECORD_KEYBOARD));
+                    write(static_cast<uint8_t>(event.type));
+                    write(time);
+                    write(event.keyboardEvent.modifiers);
+                    write(static_cast<uint32_t>(event.keyboardEvent.key));
+                    break;
+                case Event::Type::MOUSE_DOWN:
+                case Event::Type::MOUSE_UP:
+                case Event::Type::MOUSE_SCROLL:
+                case Event::Type::MOUSE_MOVE:
+                    write(static_cast<uint8_t>(RECORD_MOUSE));
+                    write(static_cast<uint8_t>(event.type));
+                    write(time);
+                    write(event.mouseEvent.modifiers);
+                    write(static_cast<uint8_t>(event.mouseEvent.button));
+                    write(event.mouseEvent.position.x);
+                    write(event.mouseEvent.position.y);
+
+                    if (event.type == Event::Type::MOUSE_SCROLL)
+                    {
+                        write(event.mouseEvent.scroll.x);
+                        write(event.mouseEvent.scroll.y);
+                    }
+                    break;
+                case Event::Type::TOUCH_BEGIN:
+                case Event::Type::TOUCH_MOVE:
+                case Event::Type::TOUCH_END:
+                case Event::Type::TOUCH_CANCEL:
+                    write(static_cast<uint8_t>(RECORD_TOUCH));
+                    write(static_cast<uint8_t>(event.type));
+                    write(time);
+                    write(event.touchEvent.touchId);
+                    write(event.touchEvent.position.x);
+                    write(event.touchEvent.position.y);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        ++frameCount;
+
+        if (buffer.size() >= FLUSH_SIZE && !flush())
+        {
+            stopRecording();
+        }
+    }
+
+    bool EventRecorder::startReplay(const std::string& filename, float newTimeStep, bool newExitWhenFinished)
+    {
+        if (recording)
+        {
+            log("Can't replay input while recording");
+            return false;
+        }
+
+        // opened the same way as the recording is written, so that the paths match
+        std::ifstream file(filename, std::ios::binary);
+
+        if (!file)
+        {
+            log("Failed to open file %s", filename.c_str());
+            return false;
+        }
+
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        offset = 0;
+
+        uint8_t magic[4];
+        uint32_t version;
+
+        if (!read(magic) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || !read(version))
+        {
+            log("File %s is not an input recording", filename.c_str());
+            return false;
+        }
+
+        if (version != VERSION)
+        {
+            log("Unsupported input recording version %u", version);
+            return false;
+        }
+
+        if (!read(seed))
+        {
+            log("File %s is not an input recording", filename.c_str());
+            return false;
+        }
+
+        sharedEngine->setRandomSeed(seed);
+
+        timeStep = newTimeStep;
+        exitWhenFinished = newExitWhenFinished;
+        replayEventCount = 0;
+        frameCount = 0;
+        frameReports.clear();
+        replaying = true;
+
+        return true;
+    }
+
+    void EventRecorder::stopReplay()
+    {
+        replaying = false;
+        data.clear();
+    }
+
+    bool EventRecorder::replayFrame(float& delta)
+    {
+        uint8_t recordType;
+        float recordedDelta;
+
+        if (!read(recordType) || recordType != RECORD_FRAME || !read(recordedDelta))
+        {
+            if (offset < data.size())
+            {
+                log("Invalid input recording at offset %u", static_cast<uint32_t>(offset));
+            }
+
+            stopReplay();
+
+            log("Replayed %u frames and %u events", frameCount, replayEventCount);
+            logReport();
+
+            if (!reportFilename.empty())
+            {
+                saveReport(reportFilename);
+            }
+
+            if (exitWhenFinished)
+            {
+                sharedEngine->exit();
+            }
+
+            return false;
+        }
+
+        const input::InputPtr& input = sharedEngine->getInput();
+
+        while (offset < data.size() && data[offset] != RECORD_FRAME)
+        {
+            uint8_t type;
+            uint32_t time;
+
+            if (!read(recordType) || !read(type) || !read(time))
+            {
+                break;
+            }
+
+            bool valid = true;
+
+            if (recordType == RECORD_KEYBOARD)
+            {
+                uint32_t modifiers;
+                uint32_t key;
+                valid = read(modifiers) && read(key) && key < static_cast<uint32_t>(input::KeyboardKey::KEY_COUNT);
+
+                if (valid)
+                {
+                    if (static_cast<Event::Type>(type) == Event::Type::KEY_UP)
+                    {
+                        input->keyUp(static_cast<input::KeyboardKey>(key), modifiers);
+                    }
+                    else // down or repeat, depending on the state of the key
+                    {
+                        input->keyDown(static_cast<input::KeyboardKey>(key), modifiers);
+                    }
+                }
+            }
+            else if (recordType == RECORD_MOUSE)
+            {
+                uint32_t modifiers;
+                uint8_t button;
+                Vector2 position;
+                valid = read(modifiers) && read(button) && read(position.x) && read(position.y) &&
+                    button < static_cast<uint8_t>(input::MouseButton::BUTTON_COUNT);
+
+                if (valid)
+                {
+                    switch (static_cast<Event::Type>(type))
+                    {
+                        case Event::Type::MOUSE_DOWN:
+                            input->mouseDown(static_cast<input::MouseButton>(button), position, modifiers);
+                            break;
+                        case Event::Type::MOUSE_UP:
+                            input->mouseUp(static_cast<input::MouseButton>(button), position, modifiers);
+                            break;
+                        case Event::Type::MOUSE_SCROLL:
+                        {
+                            Vector2 scroll;
+                            valid = read(scroll.x) && read(scroll.y);
+
+                            if (valid)
+                            {
+                                input->mouseScroll(scroll, position, modifiers);
+                            }
+                            break;
+                        }
+                        default: // the difference is calculated from the previous position
+                            input->mouseMove(position, modifiers);
+                            break;
+                    }
+                }
+            }
+            else if (recordType == RECORD_TOUCH)
+            {
+                uint64_t touchId;
+                Vector2 position;
+                valid = read(touchId) && read(position.x) && read(position.y);
+
+                if (valid)
+                {
+                    switch (static_cast<Event::Type>(type))
+                    {
+                        case Event::Type::TOUCH_BEGIN: input->touchBegin(touchId, position); break;
+                        case Event::Type::TOUCH_MOVE: input->touchMove(touchId, position); break;
+                        case Event::Type::TOUCH_END: input->touchEnd(touchId, position); break;
+                        default: input->touchCancel(touchId, position); break;
+                    }
+                }
+            }
+            else
+            {
+                valid = false;
+            }
+
+            if (!valid)
+            {
+                // skip the rest of the file, the next call finishes the replay
+                log("Invalid input recording at offset %u", static_cast<uint32_t>(offset));
+                offset = data.size();
+                break;
+            }
+
+            ++replayEventCount;
+        }
+
+        delta = (timeStep > 0.0f) ? timeStep : recordedDelta;
+        ++frameCount;
+
+        return true;
+    }
+
+    void EventRecorder::addFrameReport(const FrameReport& frameReport)
+    {
+        frameReports.push_back(frameReport);
+    }
+
+    bool EventRecorder::saveReport(const std::string& filename) const
+    {
+        std::ofstream file(filename, std::ios::trunc);
+
+        if (!file)
+        {
+            log("Failed to open file %s", filename.c_str());
+            return false;
+        }
+
+        file << "frame,delta,events,input_us,update_us,draw_us,draw_calls,dropped_frames,repeated_frames\n";
+
+        for (size_t i = 0; i < frameReports.size(); ++i)
+        {
+            const FrameReport& frameReport = frameReports[i];
+
+            file << i << ',' <<
+                frameReport.delta << ',' <<
+                frameReport.eventCount << ',' <<
+                frameReport.inputTime << ',' <<
+                frameReport.updateTime << ',' <<
+                frameReport.drawTime << ',' <<
+                frameReport.drawCallCount << ',' <<
+                frameReport.droppedFrameCount << ',' <<
+                frameReport.repeatedFrameCount << '\n';
+        }
+
+        if (!file)
+        {
+            log("Failed to write file %s", filename.c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    static uint64_t getPercentile(std::vector<uint64_t>& values, float percentile)
+    {
+        size_t index = static_cast<size_t>(percentile / 100.0f * static_cast<float>(values.size() - 1) + 0.5f);
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+
+        return values[index];
+    }
+
+    void EventRecorder::logReport() const
+    {
+        if (frameReports.empty())
+        {
+            return;
+        }
+
+        std::vector<uint64_t> updateTimes;
+        std::vector<uint64_t> drawTimes;
+        updateTimes.reserve(frameReports.size());
+        drawTimes.reserve(frameReports.size());
+
+        uint64_t drawCallCount = 0;
+
+        for (const FrameReport& frameReport : frameReports)
+        {
+            updateTimes.push_back(frameReport.inputTime + frameReport.updateTime);
+            drawTimes.push_back(frameReport.drawTime);
+            drawCallCount += frameReport.drawCallCount;
+        }
+
+        log("Update time (us): p50 %llu, p95 %llu, p99 %llu, max %llu",
+            static_cast<unsigned long long>(getPercentile(updateTimes, 50.0f)),
+            static_cast<unsigned long long>(getPercentile(updateTimes, 95.0f)),
+            static_cast<unsigned long long>(getPercentile(updateTimes, 99.0f)),
+            static_cast<unsigned long long>(*std::max_element(updateTimes.begin(), updateTimes.end())));
+
+        log("Draw time (us): p50 %llu, p95 %llu, p99 %llu, max %llu, %.1f draw calls per frame",
+            static_cast<unsigned long long>(getPercentile(drawTimes, 50.0f)),
+            static_cast<unsigned long long>(getPercentile(drawTimes, 95.0f)),
+            static_cast<unsigned long long>(getPercentile(drawTimes, 99.0f)),
+            static_cast<unsigned long long>(*std::max_element(drawTimes.begin(), drawTimes.end())),
+            static_cast<double>(drawCallCount) / static_cast<double>(frameReports.size()));
+    }
+}
@@ -0,0 +1,95 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include "utils/Noncopyable.h"
+#include "events/Event.h"
+
+namespace ouzel
+{
+    class Engine;
+
+    /**
+     * Records the keyboard, mouse and touch input of each frame together with the frame time to a binary file
+     * and replays it through Input with a fixed time step, so that a play session can be repeated deterministically.
+     * Gamepad events are not recorded, because the gamepads can't be recreated on replay.
+     * The recording starts with a random seed, which the recording and the replay set with Engine::setRandomSeed.
+     * Platform input is not suppressed during the replay, with a window and a real renderer live input
+     * still reaches the game and makes it diverge from the recording, so it should not be touched while replaying.
+     * The recording and the replay must be started and stopped on the update thread (or before Engine::init returns).
+     */
+    class EventRecorder: public Noncopyable
+    {
+        friend Engine;
+    public:
+        struct FrameReport
+        {
+            float delta;
+            uint32_t eventCount;
+            uint64_t inputTime; // input update and event dispatch in microseconds
+            uint64_t updateTime; // update callbacks in microseconds
+            uint64_t drawTime; // draw command generation in microseconds
+            uint32_t drawCallCount;
+            uint32_t droppedFrameCount;
+            uint32_t repeatedFrameCount;
+        };
+
+        virtual ~EventRecorder();
+
+        bool startRecording(const std::string& filename);
+        bool stopRecording();
+        bool isRecording() const { return recording; }
+
+        /**
+         * Every frame of the replay uses the given time step, 0 uses the recorded frame times.
+         * The engine exits after the last frame if exitWhenFinished is true.
+         */
+        bool startReplay(const std::string& filename, float timeStep = 1.0f / 60.0f, bool exitWhenFinished = true);
+        void stopReplay();
+        bool isReplaying() const { return replaying; }
+
+        uint32_t getFrameCount() const { return frameCount; }
+        uint64_t getSeed() const { return seed; }
+
+        // per frame statistics of the replay, written as CSV to the file (if not empty) when the replay finishes
+        void setReportFilename(const std::string& filename) { reportFilename = filename; }
+        const std::vector<FrameReport>& getFrameReports() const { return frameReports; }
+        bool saveReport(const std::string& filename) const;
+        void logReport() const;
+
+    protected:
+        EventRecorder();
+
+        void recordFrame(float delta, const std::vector<Event>& events);
+        bool replayFrame(float& delta);
+        void addFrameReport(const FrameReport& frameReport);
+
+        template<class T> void write(const T& value);
+        template<class T> bool read(T& value);
+        bool flush();
+
+        std::atomic<bool> recording;
+        std::atomic<bool> replaying;
+
+        std::string recordFilename;
+        std::vector<uint8_t> buffer; // written records, flushed to the file when full
+        uint64_t previousTimestamp = 0;
+        uint64_t seed = 0;
+
+        std::vector<uint8_t> data; // the whole replayed file
+        size_t offset = 0;
+        float timeStep = 0.0f;
+        bool exitWhenFinished = true;
+        uint32_t replayEventCount = 0;
+
+        uint32_t frameCount = 0;
+
+        std::string reportFilename;
+        std::vector<FrameReport> frameReports;
+    };
+}
@@ -20,6 +20,8 @@ namespace ouzel
 
         void MeshBuffer::free()
         {
+            indexMeshBuffer.reset();
+
             ready = false;
         }
 
@@ -50,9 +52,32 @@ namespace ouzel
             return true;
         }
 
+        bool MeshBuffer::initFromBuffer(const std::shared_ptr<MeshBuffer>& newIndexMeshBuffer,
+                                        const void* newVertices, uint32_t newVertexAttributes,
+                                        uint32_t newVertexCount, bool newDynamicVertexBuffer)
+        {
+            if (!newIndexMeshBuffer)
+            {
+                log("Invalid index mesh buffer");
+                return false;
+            }
+
+            // no indices are uploaded, so the backends do not create an own index buffer
+            if (!initFromBuffer(nullptr, newIndexMeshBuffer->getIndexSize(), 0, false,
+                                newVertices, newVertexAttributes, newVertexCount, newDynamicVertexBuffer))
+            {
+                return false;
+            }
+
+            indexMeshBuffer = newIndexMeshBuffer;
+            indexCount = newIndexMeshBuffer->getIndexCount();
+
+            return true;
+        }
+
         bool MeshBuffer::uploadIndices(const void*, uint32_t newIndexCount)
         {
-            if (!dynamicIndexBuffer)
+            if (!dynamicIndexBuffer || indexMeshBuffer)
             {
                 return false;
             }
@@ -77,6 +102,11 @@ namespace ouzel
 
         bool MeshBuffer::setIndexSize(uint32_t newIndexSize)
         {
+            if (indexMeshBuffer)
+            {
+                return false;
+            }
+
             indexSize = newIndexSize;
             return true;
         }
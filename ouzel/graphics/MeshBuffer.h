@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 #include "utils/Noncopyable.h"
 #include "graphics/Resource.h"
@@ -26,6 +27,12 @@ namespace ouzel
                                         uint32_t newIndexCount, bool newDynamicIndexBuffer,
                                         const void* newVertices, uint32_t newVertexAttributes,
                                         uint32_t newVertexCount, bool newDynamicVertexBuffer);
+            // uses the indices of another mesh buffer, so that meshes with the same indices can share one index buffer
+            bool initFromBuffer(const std::shared_ptr<MeshBuffer>& newIndexMeshBuffer,
+                                const void* newVertices, uint32_t newVertexAttributes,
+                                uint32_t newVertexCount, bool newDynamicVertexBuffer);
+
+            const std::shared_ptr<MeshBuffer>& getIndexMeshBuffer() const { return indexMeshBuffer; }
 
             uint32_t getIndexCount() const { return indexCount; }
             virtual bool setIndexSize(uint32_t newIndexSize);
@@ -49,6 +56,7 @@ namespace ouzel
             uint32_t indexCount = 0;
             uint32_t indexSize = 0;
             bool dynamicIndexBuffer = true;
+            std::shared_ptr<MeshBuffer> indexMeshBuffer;
 
             uint32_t vertexCount = 0;
             uint32_t vertexSize = 0;
@@ -16,8 +16,11 @@ namespace ouzel
 {
     namespace graphics
     {
+        static thread_local Renderer::DrawCommandList* currentDrawCommandList = nullptr;
+
         Renderer::Renderer(Driver pDriver):
-            driver(pDriver), clearColor(0, 0, 0, 255)
+            driver(pDriver), clearColor(0, 0, 0, 255),
+            readyFramePacket(2), droppedFrameCount(0), repeatedFrameCount(0)
         {
 
         }
@@ -29,10 +32,9 @@ namespace ouzel
 
         void Renderer::free()
         {
-            while (!activeDrawQueue.empty())
-            {
-                activeDrawQueue.pop();
-            }
+            framePackets[activeFramePacket].drawCommands.clear();
+
+            releaseUnusedRenderTargets();
 
             ready = false;
         }
@@ -100,6 +102,64 @@ namespace ouzel
             return meshBuffer;
         }
 
+        static float nextPowerOfTwo(float value)
+        {
+            float result = 1.0f;
+
+            while (result < value)
+            {
+                result *= 2.0f;
+            }
+
+            return result;
+        }
+
+        RenderTargetPtr Renderer::acquireRenderTarget(const Size2& minSize)
+        {
+            Size2 renderTargetSize(nextPowerOfTwo(minSize.width), nextPowerOfTwo(minSize.height));
+
+            {
+                std::lock_guard<std::mutex> lock(renderTargetPoolMutex);
+
+                for (auto i = renderTargetPool.begin(); i != renderTargetPool.end(); ++i)
+                {
+                    RenderTargetPtr renderTarget = *i;
+
+                    if (renderTarget->getTexture()->getSize() == renderTargetSize)
+                    {
+                        renderTargetPool.erase(i);
+                        return renderTarget;
+                    }
+                }
+            }
+
+            RenderTargetPtr renderTarget = createRenderTarget();
+
+            if (!renderTarget->init(renderTargetSize, false))
+            {
+                return nullptr;
+            }
+
+            renderTarget->setClearColor(Color(0, 0, 0, 0));
+
+            return renderTarget;
+        }
+
+        void Renderer::releaseRenderTarget(const RenderTargetPtr& renderTarget)
+        {
+            if (renderTarget)
+            {
+                std::lock_guard<std::mutex> lock(renderTargetPoolMutex);
+                renderTargetPool.push_back(renderTarget);
+            }
+        }
+
+        void Renderer::releaseUnusedRenderTargets()
+        {
+            std::lock_guard<std::mutex> lock(renderTargetPoolMutex);
+            renderTargetPool.clear();
+        }
+
         bool Renderer::addDrawCommand(const std::vector<TexturePtr>& textures,
                                       const ShaderPtr& shader,
                                       const std::vector<std::vector<float>>& pixelShaderConstants,
@@ -113,7 +173,7 @@ namespace ouzel
                                       bool scissorTestEnabled,
                                       const Rectangle& scissorTest)
         {
-            activeDrawQueue.push({
+            DrawCommand drawCommand = {
                 textures,
                 shader,
                 pixelShaderConstants,
@@ -126,16 +186,117 @@ namespace ouzel
                 renderTarget,
                 scissorTestEnabled,
                 scissorTest
-            });
+            };
+
+            if (currentDrawCommandList)
+            {
+                currentDrawCommandList->push_back(std::move(drawCommand));
+            }
+            else
+            {
+                framePackets[activeFramePacket].drawCommands.push_back(std::move(drawCommand));
+            }
 
             return true;
         }
 
+        void Renderer::addDrawCommands(const DrawCommandList& drawCommands)
+        {
+            if (currentDrawCommandList)
+            {
+                currentDrawCommandList->insert(currentDrawCommandList->end(), drawCommands.begin(), drawCommands.end());
+            }
+            else
+            {
+                for (const DrawCommand& drawCommand : drawCommands)
+                {
+                    framePackets[activeFramePacket].drawCommands.push_back(drawCommand);
+                }
+            }
+        }
+
+        void Renderer::addDrawCommands(DrawCommandList&& drawCommands)
+        {
+            if (currentDrawCommandList)
+            {
+                currentDrawCommandList->insert(currentDrawCommandList->end(),
+                                               std::make_move_iterator(drawCommands.begin()),
+                                               std::make_move_iterator(drawCommands.end()));
+            }
+            else
+            {
+                for (DrawCommand& drawCommand : drawCommands)
+                {
+                    framePackets[activeFramePacket].drawCommands.push_back(std::move(drawCommand));
+                }
+            }
+
+            drawCommands.clear();
+        }
+
         void Renderer::flushDrawCommands()
         {
-            std::lock_guard<std::mutex> lock(drawQueueMutex);
-            drawQueue = std::move(activeDrawQueue);
-            drawCallCount = static_cast<uint32_t>(drawQueue.size());
+            std::lock_guard<std::mutex> lock(updateMutex);
+
+            FramePacket& framePacket = framePackets[activeFramePacket];
+            drawCallCount = static_cast<uint32_t>(framePacket.drawCommands.size());
+
+            uint32_t ready = readyFramePacket;
+
+            if (ready & FRAME_PACKET_NEW)
+            {
+                // the previous packet can be replaced before the render thread takes it,
+                // so its resources are also updated with this one (updating a resource twice is harmless)
+                for (const ResourcePtr& resource : framePackets[ready & FRAME_PACKET_INDEX_MASK].resources)
+                {
+                    if (framePacket.resourceSet.insert(resource).second)
+                    {
+                        framePacket.resources.push_back(resource);
+                    }
+                }
+            }
+
+            uint32_t previous = readyFramePacket.exchange(activeFramePacket | FRAME_PACKET_NEW);
+
+            if (previous & FRAME_PACKET_NEW)
+            {
+                ++droppedFrameCount;
+            }
+
+            // the previous ready packet is not used by the render thread anymore
+            activeFramePacket = previous & FRAME_PACKET_INDEX_MASK;
+
+            FramePacket& nextFramePacket = framePackets[activeFramePacket];
+            nextFramePacket.drawCommands.clear();
+            nextFramePacket.resources.clear();
+            nextFramePacket.resourceSet.clear();
+        }
+
+        const Renderer::FramePacket& Renderer::acquireFramePacket(bool& newFrame)
+        {
+            // only the update thread sets the flag, so it can't be cleared between the load and the exchange
+            newFrame = (readyFramePacket & FRAME_PACKET_NEW) != 0;
+
+            if (newFrame)
+            {
+                renderFramePacket = readyFramePacket.exchange(renderFramePacket) & FRAME_PACKET_INDEX_MASK;
+            }
+            else
+            {
+                ++repeatedFrameCount;
+            }
+
+            return framePackets[renderFramePacket];
+        }
+
+        void Renderer::setDrawCommandList(DrawCommandList* drawCommandList)
+        {
+            currentDrawCommandList = drawCommandList;
+        }
+
+        Renderer::DrawCommandList* Renderer::getDrawCommandList() const
+        {
+            return currentDrawCommandList;
         }
 
         Vector2 Renderer::viewToScreenLocation(const Vector2& position)
@@ -166,10 +327,11 @@ namespace ouzel
         {
             std::lock_guard<std::mutex> lock(updateMutex);
 
-            if (updateSet.find(resource) == updateSet.end())
+            FramePacket& framePacket = framePackets[activeFramePacket];
+
+            if (framePacket.resourceSet.insert(resource).second)
             {
-                updateSet.insert(resource);
-                updateQueue.push(resource);
+                framePacket.resources.push_back(resource);
             }
         }
     } // namespace graphics
@@ -9,6 +9,7 @@
 #include <set>
 #include <memory>
 #include <mutex>
+#include <atomic>
 #include "utils/Types.h"
 #include "utils/Noncopyable.h"
 #include "math/Rectangle.h"
@@ -67,6 +68,33 @@ namespace ouzel
                 TRIANGLE_STRIP
             };
 
+            struct DrawCommand
+            {
+                std::vector<TexturePtr> textures;
+                ShaderPtr shader;
+                std::vector<std::vector<float>> pixelShaderConstants;
+                std::vector<std::vector<float>> vertexShaderConstants;
+                BlendStatePtr blendState;
+                MeshBufferPtr meshBuffer;
+                uint32_t indexCount;
+                DrawMode drawMode;
+                uint32_t startIndex;
+                RenderTargetPtr renderTarget;
+
+                bool scissorTestEnabled;
+                Rectangle scissorTest;
+            };
+
+            typedef std::vector<DrawCommand> DrawCommandList;
+
+            // everything the render thread needs to draw one frame
+            struct FramePacket
+            {
+                DrawCommandList drawCommands;
+                std::vector<ResourcePtr> resources;
+                std::set<ResourcePtr> resourceSet;
+            };
+
             virtual ~Renderer() = 0;
             virtual void free();
 
@@ -89,6 +117,11 @@ namespace ouzel
             virtual ShaderPtr createShader();
             virtual MeshBufferPtr createMeshBuffer();
 
+            // returns an unused render target from the pool with power of two dimensions at least the given size
+            RenderTargetPtr acquireRenderTarget(const Size2& minSize);
+            void releaseRenderTarget(const RenderTargetPtr& renderTarget);
+            void releaseUnusedRenderTargets();
+
             bool addDrawCommand(const std::vector<TexturePtr>& textures,
                                 const ShaderPtr& shader,
                                 const std::vector<std::vector<float>>& pixelShaderConstants,
@@ -101,8 +134,14 @@ namespace ouzel
                                 const RenderTargetPtr& renderTarget = nullptr,
                                 bool scissorTestEnabled = false,
                                 const Rectangle& scissorTest = Rectangle());
+            void addDrawCommands(const DrawCommandList& drawCommands);
+            void addDrawCommands(DrawCommandList&& drawCommands);
             void flushDrawCommands();
 
+            // redirects draw commands added from the calling thread to the given list, nullptr adds them to the renderer's queue
+            void setDrawCommandList(DrawCommandList* drawCommandList);
+            DrawCommandList* getDrawCommandList() const;
+
             Vector2 viewToScreenLocation(const Vector2& position);
             Vector2 viewToScreenRelativeLocation(const Vector2& position);
             Vector2 screenToViewLocation(const Vector2& position);
@@ -111,6 +150,11 @@ namespace ouzel
 
             virtual uint32_t getDrawCallCount() const { return drawCallCount; }
 
+            // frames that were replaced by a newer one before they were rendered
+            uint32_t getDroppedFrameCount() const { return droppedFrameCount; }
+            // presents that rendered the previous frame again, because no new frame was ready
+            uint32_t getRepeatedFrameCount() const { return repeatedFrameCount; }
+
             uint32_t getAPIVersion() const { return apiVersion; }
             void setAPIVersion(uint32_t version) { apiVersion = version; }
 
@@ -129,6 +173,9 @@ namespace ouzel
             virtual void setSize(const Size2& newSize);
             virtual void setFullscreen(bool newFullscreen);
 
+            // called by the render thread, newFrame is false if the packet was already rendered
+            const FramePacket& acquireFramePacket(bool& newFrame);
+
             Driver driver;
             Size2 size;
             bool fullscreen = false;
@@ -144,29 +191,22 @@ namespace ouzel
 
             bool ready = false;
 
-            struct DrawCommand
-            {
-                std::vector<TexturePtr> textures;
-                ShaderPtr shader;
-                std::vector<std::vector<float>> pixelShaderConstants;
-                std::vector<std::vector<float>> vertexShaderConstants;
-                BlendStatePtr blendState;
-                MeshBufferPtr meshBuffer;
-                uint32_t indexCount;
-                DrawMode drawMode;
-                uint32_t startIndex;
-                RenderTargetPtr renderTarget;
+            static const uint32_t FRAME_PACKET_INDEX_MASK = 0x03;
+            static const uint32_t FRAME_PACKET_NEW = 0x04;
 
-                bool scissorTestEnabled;
-                Rectangle scissorTest;
-            };
+            // triple buffering: the update thread fills the active packet while the render thread draws its own,
+            // the ready packet (with the FRAME_PACKET_NEW flag if it hasn't been rendered yet) is swapped between them
+            FramePacket framePackets[3];
+            uint32_t activeFramePacket = 0;
+            uint32_t renderFramePacket = 1;
+            std::atomic<uint32_t> readyFramePacket;
+            std::atomic<uint32_t> droppedFrameCount;
+            std::atomic<uint32_t> repeatedFrameCount;
 
-            std::queue<DrawCommand> activeDrawQueue;
-            std::queue<DrawCommand> drawQueue;
-            std::mutex drawQueueMutex;
+            std::vector<RenderTargetPtr> renderTargetPool;
+            std::mutex renderTargetPoolMutex;
 
-            std::queue<ResourcePtr> updateQueue;
-            std::set<ResourcePtr> updateSet;
+            // guards the resources of the active packet, resources can be scheduled from any thread
             std::mutex updateMutex;
         };
     } // namespace graphics
@@ -0,0 +1,52 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include "RendererEmpty.h"
+#include "Resource.h"
+#include "utils/Utils.h"
+
+namespace ouzel
+{
+    namespace graphics
+    {
+        RendererEmpty::RendererEmpty():
+            Renderer(Driver::NONE)
+        {
+        }
+
+        bool RendererEmpty::present()
+        {
+            if (!Renderer::present())
+            {
+                return false;
+            }
+
+            bool newFrame;
+            const FramePacket& framePacket = acquireFramePacket(newFrame);
+
+            if (newFrame)
+            {
+                for (const ResourcePtr& resource : framePacket.resources)
+                {
+                    if (!resource->update())
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        std::vector<Size2> RendererEmpty::getSupportedResolutions() const
+        {
+            return std::vector<Size2>();
+        }
+
+        bool RendererEmpty::saveScreenshot(const std::string& filename)
+        {
+            log("Failed to save screenshot %s, the renderer has no frame buffer", filename.c_str());
+            return false;
+        }
+    } // namespace graphics
+} // namespace ouzel
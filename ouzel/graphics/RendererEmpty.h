@@ -0,0 +1,30 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include "graphics/Renderer.h"
+
+namespace ouzel
+{
+    namespace graphics
+    {
+        /**
+         * Renderer of the NONE driver, consumes the frame packets without drawing anything.
+         * Used to run the engine without a window, for example to replay recorded input.
+         */
+        class RendererEmpty: public Renderer
+        {
+            friend Engine;
+        public:
+            virtual bool present() override;
+
+            virtual std::vector<Size2> getSupportedResolutions() const override;
+
+            virtual bool saveScreenshot(const std::string& filename) override;
+
+        protected:
+            RendererEmpty();
+        };
+    } // namespace graphics
+} // namespace ouzel
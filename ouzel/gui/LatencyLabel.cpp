@@ -0,0 +1,46 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <cstdio>
+#include "LatencyLabel.h"
+#include "core/Engine.h"
+
+namespace ouzel
+{
+    namespace gui
+    {
+        LatencyLabel::LatencyLabel(const std::string& font, const Vector2& textAnchor):
+            Label(font, "", textAnchor)
+        {
+            updateCallback.callback = std::bind(&LatencyLabel::update, this, std::placeholders::_1);
+            updateCallback.name = "LatencyLabel";
+            sharedEngine->scheduleUpdate(updateCallback);
+        }
+
+        LatencyLabel::~LatencyLabel()
+        {
+            sharedEngine->unscheduleUpdate(updateCallback);
+        }
+
+        void LatencyLabel::update(float delta)
+        {
+            timeSinceRefresh += delta;
+
+            if (timeSinceRefresh < refreshInterval)
+            {
+                return;
+            }
+
+            timeSinceRefresh = 0.0f;
+
+            char buffer[128];
+            snprintf(buffer, sizeof(buffer), "FPS: %.0f, input latency: %.1f / %.1f / %.1f ms (50 / 95 / 99%%)",
+                     sharedEngine->getAccumulatedFPS(),
+                     sharedEngine->getInputLatency(50.0f) * 1000.0f,
+                     sharedEngine->getInputLatency(95.0f) * 1000.0f,
+                     sharedEngine->getInputLatency(99.0f) * 1000.0f);
+
+            setText(buffer);
+        }
+    } // namespace gui
+} // namespace ouzel
@@ -0,0 +1,34 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include "gui/Label.h"
+#include "core/UpdateCallback.h"
+
+namespace ouzel
+{
+    namespace gui
+    {
+        /**
+         * Shows the frame rate and the input-to-present latency percentiles of the engine.
+         */
+        class LatencyLabel: public Label
+        {
+        public:
+            LatencyLabel(const std::string& font, const Vector2& textAnchor = Vector2(0.0f, 0.5f));
+            virtual ~LatencyLabel();
+
+            // how often the text is refreshed in seconds
+            void setRefreshInterval(float newRefreshInterval) { refreshInterval = newRefreshInterval; }
+            float getRefreshInterval() const { return refreshInterval; }
+
+        protected:
+            void update(float delta);
+
+            UpdateCallback updateCallback;
+            float refreshInterval = 0.5f;
+            float timeSinceRefresh = 0.0f;
+        };
+    } // namespace gui
+} // namespace ouzel
@@ -44,9 +44,10 @@ namespace ouzel
 
         }
 
-        void Input::keyDown(KeyboardKey key, uint32_t modifiers)
+        void Input::keyDown(KeyboardKey key, uint32_t modifiers, uint64_t timestamp)
         {
             Event event;
+            event.timestamp = timestamp;
 
             event.keyboardEvent.key = key;
             event.keyboardEvent.modifiers = modifiers;
@@ -65,11 +66,12 @@ namespace ouzel
             }
         }
 
-        void Input::keyUp(KeyboardKey key, uint32_t modifiers)
+        void Input::keyUp(KeyboardKey key, uint32_t modifiers, uint64_t timestamp)
         {
             keyboardKeyStates[static_cast<uint32_t>(key)] = false;
 
             Event event;
+            event.timestamp = timestamp;
             event.type = Event::Type::KEY_UP;
 
             event.keyboardEvent.key = key;
@@ -78,11 +80,12 @@ namespace ouzel
             sharedEngine->getEventDispatcher()->dispatchEvent(event);
         }
 
-        void Input::mouseDown(MouseButton button, const Vector2& position, uint32_t modifiers)
+        void Input::mouseDown(MouseButton button, const Vector2& position, uint32_t modifiers, uint64_t timestamp)
         {
             mouseButtonStates[static_cast<uint32_t>(button)] = true;
 
             Event event;
+            event.timestamp = timestamp;
             event.type = Event::Type::MOUSE_DOWN;
 
             event.mouseEvent.button = button;
@@ -92,11 +95,12 @@ namespace ouzel
             sharedEngine->getEventDispatcher()->dispatchEvent(event);
         }
 
-        void Input::mouseUp(MouseButton button, const Vector2& position, uint32_t modifiers)
+        void Input::mouseUp(MouseButton button, const Vector2& position, uint32_t modifiers, uint64_t timestamp)
         {
             mouseButtonStates[static_cast<uint32_t>(button)] = false;
 
             Event event;
+            event.timestamp = timestamp;
             event.type = Event::Type::MOUSE_UP;
 
             event.mouseEvent.button = button;
@@ -106,32 +110,35 @@ namespace ouzel
             sharedEngine->getEventDispatcher()->dispatchEvent(event);
         }
 
-        void Input::mouseMove(const Vector2& position, uint32_t modifiers)
+        void Input::mouseMove(const Vector2& position, uint32_t modifiers, uint64_t timestamp)
         {
-            cursorPosition = position;
-
             Event event;
+            event.timestamp = timestamp;
             event.type = Event::Type::MOUSE_MOVE;
 
+            event.mouseEvent.difference = position - cursorPosition;
+            cursorPosition = position;
+
             event.mouseEvent.position = position;
             event.mouseEvent.modifiers = modifiers;
 
             sharedEngine->getEventDispatcher()->dispatchEvent(event);
         }
 
-        void Input::mouseRelativeMove(const Vector2& relativePosition, uint32_t modifiers)
+        void Input::mouseRelativeMove(const Vector2& relativePosition, uint32_t modifiers, uint64_t timestamp)
         {
             Vector2 newPosition = cursorPosition + relativePosition;
 
             newPosition.x = clamp(newPosition.x, -1.0f, 1.0f);
             newPosition.y = clamp(newPosition.y, -1.0f, 1.0f);
 
-            mouseMove(newPosition, modifiers);
+            mouseMove(newPosition, modifiers, timestamp);
         }
 
-        void Input::mouseScroll(const Vector2& scroll, const Vector2& position, uint32_t modifiers)
+        void Input::mouseScroll(const Vector2& scroll, const Vector2& position, uint32_t modifiers, uint64_t timestamp)
         {
             Event event;
+            event.timestamp = timestamp;
             event.type = Event::Type::MOUSE_SCROLL;
 
             event.mouseEvent.position = position;
@@ -141,9 +148,10 @@ namespace ouzel
             sharedEngine->getEventDispatcher()->dispatchEvent(event);
         }
 
-        void Input::touchBegin(uint64_t touchId, const Vector2& position)
+        void Input::touchBegin(uint64_t touchId, const Vector2& position, uint64_t timestamp)
         {
             Event event;
+            event.timestamp = timestamp;
             event.type = Event::Type::TOUCH_BEGIN;
 
             event.touchEvent.touchId = touchId;
@@ -152,9 +160,10 @@ namespace ouzel
             sharedEngine->getEventDispatcher()->dispatchEvent(event);
         }
 
-        void Input::touchEnd(uint64_t touchId, const Vector2& position)
+        void Input::touchEnd(uint64_t touchId, const Vector2& position, uint64_t timestamp)
         {
             Event event;
+            event.timestamp = timestamp;
             event.type = Event::Type::TOUCH_END;
 
             event.touchEvent.touchId = touchId;
@@ -163,9 +172,10 @@ namespace ouzel
             sharedEngine->getEventDispatcher()->dispatchEvent(event);
         }
 
-        void Input::touchMove(uint64_t touchId, const Vector2& position)
+        void Input::touchMove(uint64_t touchId, const Vector2& position, uint64_t timestamp)
         {
             Event event;
+            event.timestamp = timestamp;
             event.type = Event::Type::TOUCH_MOVE;
 
             event.touchEvent.touchId = touchId;
@@ -174,9 +184,10 @@ namespace ouzel
             sharedEngine->getEventDispatcher()->dispatchEvent(event);
         }
 
-        void Input::touchCancel(uint64_t touchId, const Vector2& position)
+        void Input::touchCancel(uint64_t touchId, const Vector2& position, uint64_t timestamp)
         {
             Event event;
+            event.timestamp = timestamp;
             event.type = Event::Type::TOUCH_CANCEL;
 
             event.touchEvent.touchId = touchId;
@@ -231,19 +231,20 @@ namespace ouzel
             bool isKeyboardKeyDown(KeyboardKey key) const { return keyboardKeyStates[static_cast<uint32_t>(key)]; }
             bool isMouseButtonDown(MouseButton button) const { return mouseButtonStates[static_cast<uint32_t>(button)]; }
 
-            virtual void keyDown(KeyboardKey key, uint32_t modifiers);
-            virtual void keyUp(KeyboardKey key, uint32_t modifiers);
+            // timestamp is the time of the input in microseconds (getCurrentMicroSeconds), 0 for the time of the call
+            virtual void keyDown(KeyboardKey key, uint32_t modifiers, uint64_t timestamp = 0);
+            virtual void keyUp(KeyboardKey key, uint32_t modifiers, uint64_t timestamp = 0);
 
-            virtual void mouseDown(MouseButton button, const Vector2& position, uint32_t modifiers);
-            virtual void mouseUp(MouseButton button, const Vector2& position, uint32_t modifiers);
-            virtual void mouseMove(const Vector2& position, uint32_t modifiers);
-            virtual void mouseRelativeMove(const Vector2& relativePosition, uint32_t modifiers);
-            virtual void mouseScroll(const Vector2& scroll, const Vector2& position, uint32_t modifiers);
+            virtual void mouseDown(MouseButton button, const Vector2& position, uint32_t modifiers, uint64_t timestamp = 0);
+            virtual void mouseUp(MouseButton button, const Vector2& position, uint32_t modifiers, uint64_t timestamp = 0);
+            virtual void mouseMove(const Vector2& position, uint32_t modifiers, uint64_t timestamp = 0);
+            virtual void mouseRelativeMove(const Vector2& relativePosition, uint32_t modifiers, uint64_t timestamp = 0);
+            virtual void mouseScroll(const Vector2& scroll, const Vector2& position, uint32_t modifiers, uint64_t timestamp = 0);
 
-            virtual void touchBegin(uint64_t touchId, const Vector2& position);
-            virtual void touchEnd(uint64_t touchId, const Vector2& position);
-            virtual void touchMove(uint64_t touchId, const Vector2& position);
-            virtual void touchCancel(uint64_t touchId, const Vector2& position);
+            virtual void touchBegin(uint64_t touchId, const Vector2& position, uint64_t timestamp = 0);
+            virtual void touchEnd(uint64_t touchId, const Vector2& position, uint64_t timestamp = 0);
+            virtual void touchMove(uint64_t touchId, const Vector2& position, uint64_t timestamp = 0);
+            virtual void touchCancel(uint64_t touchId, const Vector2& position, uint64_t timestamp = 0);
 
             virtual bool showVirtualKeyboard();
             virtual bool hideVirtualKeyboard();
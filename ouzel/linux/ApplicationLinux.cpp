@@ -1,6 +1,11 @@
 // Copyright (C) 2016 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <ctime>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <GL/gl.h>
 #include <GL/glext.h>
 #include <X11/keysym.h>
@@ -8,6 +13,7 @@
 #include "ApplicationLinux.h"
 #include "core/Engine.h"
 #include "WindowLinux.h"
+#include "utils/Utils.h"
 
 namespace ouzel
 {
@@ -219,9 +225,52 @@ namespace ouzel
         }
     }
 
+    static uint64_t getProcessMicroSeconds()
+    {
+        timespec now;
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+
+        return static_cast<uint64_t>(now.tv_sec) * 1000000 + static_cast<uint64_t>(now.tv_nsec) / 1000;
+    }
+
     ApplicationLinux::ApplicationLinux(int pArgc, char* pArgv[]):
-        Application(pArgc, pArgv)
+        Application(pArgc, pArgv), wakeUpCount(0), idleTime(0)
+    {
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (epollFd == -1)
+        {
+            log("Failed to create epoll instance");
+        }
+
+        eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (eventFd == -1)
+        {
+            log("Failed to create event file descriptor");
+        }
+    }
+
+    ApplicationLinux::~ApplicationLinux()
     {
+        if (eventFd != -1) close(eventFd);
+        if (epollFd != -1) close(epollFd);
+    }
+
+    void ApplicationLinux::execute(const std::function<void(void)>& func)
+    {
+        Application::execute(func);
+        wakeUp();
+    }
+
+    void ApplicationLinux::wakeUp()
+    {
+        if (eventFd != -1)
+        {
+            uint64_t value = 1;
+            if (write(eventFd, &value, sizeof(value)) == -1)
+            {
+                log("Failed to wake up the main loop");
+            }
+        }
     }
 
     bool ApplicationLinux::run()
@@ -233,32 +282,72 @@ namespace ouzel
             return false;
         }
 
+        if (epollFd == -1 || eventFd == -1)
+        {
+            return false;
+        }
+
+        if (sharedEngine->getRenderer()->getDriver() == graphics::Renderer::Driver::NONE)
+        {
+            // without a window there are no events to wait for, draw blocks until the next frame
+            sharedEngine->begin();
+
+            for (;;)
+            {
+                executeAll();
+
+                if (!sharedEngine->draw())
+                {
+                    break;
+                }
+            }
+
+            sharedEngine->end();
+
+            return true;
+        }
+
+        std::shared_ptr<WindowLinux> windowLinux = std::static_pointer_cast<WindowLinux>(sharedEngine->getWindow());
+        Display* display = windowLinux->getDisplay();
+
+        epoll_event pollEvent;
+        pollEvent.events = EPOLLIN;
+        pollEvent.data.fd = ConnectionNumber(display);
+
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, ConnectionNumber(display), &pollEvent) == -1)
+        {
+            log("Failed to add X connection to epoll");
+            return false;
+        }
+
+        pollEvent.events = EPOLLIN;
+        pollEvent.data.fd = eventFd;
+
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, eventFd, &pollEvent) == -1)
+        {
+            log("Failed to add event file descriptor to epoll");
+            return false;
+        }
+
         sharedEngine->begin();
 
         XEvent event;
 
-        std::shared_ptr<WindowLinux> windowLinux = std::static_pointer_cast<WindowLinux>(sharedEngine->getWindow());
+        uint64_t startTime = getCurrentMicroSeconds();
+        uint64_t startProcessTime = getProcessMicroSeconds();
 
         bool running = true;
+        bool redraw = false;
 
         while (running)
         {
             executeAll();
 
-            if (!sharedEngine->draw())
+            // XPending also reads the events that are waiting on the connection
+            while (running && XPending(display))
             {
-                running = false;
-            }
+                XNextEvent(display, &event);
 
-            for (;;)
-            {
-                if (sharedEngine->isRunning() && !XPending(windowLinux->getDisplay()))
-                {
-                    break;
-                }
-            
-                XNextEvent(windowLinux->getDisplay(), &event);
-            
                 switch (event.type)
                 {
                     case ClientMessage:
@@ -278,7 +367,7 @@ namespace ouzel
                     case KeyPress: // keyboard
                     case KeyRelease:
                     {
-                        KeySym keySym = XkbKeycodeToKeysym(windowLinux->getDisplay(), event.xkey.keycode, 0, event.xkey.state & ShiftMask ? 1 : 0);
+                        KeySym keySym = XkbKeycodeToKeysym(display, event.xkey.keycode, 0, event.xkey.state & ShiftMask ? 1 : 0);
 
                         if (event.type == KeyPress)
                         {
@@ -338,19 +427,81 @@ namespace ouzel
                     case ConfigureNotify:
                     {
                         sharedEngine->getWindow()->setSize(Size2(event.xconfigure.width, event.xconfigure.height));
+                        redraw = true;
                         break;
                     }
                     case Expose:
                     {
-                        // need redraw
+                        redraw = true;
                         break;
                     }
                 }
             }
+
+            if (!running || !sharedEngine->isActive())
+            {
+                break;
+            }
+
+            // present only when the update thread has produced a frame or the window needs to be repainted
+            if (sharedEngine->isRunning() && (redraw || sharedEngine->isFrameReady()))
+            {
+                redraw = false;
+
+                if (!sharedEngine->draw())
+                {
+                    running = false;
+                }
+
+                continue;
+            }
+
+            // the events could have been read into the queue of Xlib by the calls above
+            if (XEventsQueued(display, QueuedAfterFlush))
+            {
+                continue;
+            }
+
+            uint64_t waitStartTime = getCurrentMicroSeconds();
+
+            epoll_event pollEvents[2];
+            int count = epoll_wait(epollFd, pollEvents, 2, -1);
+
+            idleTime += getCurrentMicroSeconds() - waitStartTime;
+            ++wakeUpCount;
+
+            if (count == -1 && errno != EINTR)
+            {
+                log("Failed to wait for events");
+                running = false;
+            }
+
+            for (int i = 0; i < count; ++i)
+            {
+                if (pollEvents[i].data.fd == eventFd)
+                {
+                    uint64_t value;
+                    if (read(eventFd, &value, sizeof(value)) == -1)
+                    {
+                        log("Failed to read event file descriptor");
+                    }
+                }
+            }
         }
 
         sharedEngine->end();
 
+        uint64_t totalTime = getCurrentMicroSeconds() - startTime;
+        uint64_t processTime = getProcessMicroSeconds() - startProcessTime;
+
+        if (totalTime > 0)
+        {
+            log("Main loop: %llu wake-ups, idle %.1f%%, process CPU usage %.1f%%",
+                static_cast<unsigned long long>(wakeUpCount.load()),
+                100.0 * static_cast<double>(idleTime) / static_cast<double>(totalTime),
+                100.0 * static_cast<double>(processTime) / static_cast<double>(totalTime));
+        }
+
         return true;
     }
 }
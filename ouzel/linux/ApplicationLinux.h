@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include "core/Application.h"
 
 namespace ouzel
@@ -11,8 +12,22 @@ namespace ouzel
     {
     public:
         ApplicationLinux(int pArgc, char* pArgv[]);
-        virtual ~ApplicationLinux() {}
+        virtual ~ApplicationLinux();
 
         virtual bool run() override;
+
+        virtual void execute(const std::function<void(void)>& func) override;
+        virtual void wakeUp() override;
+
+        uint64_t getWakeUpCount() const { return wakeUpCount; }
+        // time spent waiting for events in microseconds
+        uint64_t getIdleTime() const { return idleTime; }
+
+    protected:
+        int epollFd = -1;
+        int eventFd = -1;
+
+        std::atomic<uint64_t> wakeUpCount;
+        std::atomic<uint64_t> idleTime;
     };
 }
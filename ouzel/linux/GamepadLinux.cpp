@@ -1,18 +0,0 @@
-// Copyright (C) 2016 Elviss Strazdins
-// This file is part of the Ouzel engine.
-
-#include "GamepadLinux.h"
-
-namespace ouzel
-{
-    namespace input
-    {
-        GamepadLinux::GamepadLinux()
-        {
-        }
-
-        GamepadLinux::~GamepadLinux()
-        {
-        }
-    } // namespace input
-} // namespace ouzel
@@ -7,7 +7,9 @@ namespace ouzel
 {
     namespace input
     {
-        InputLinux::InputLinux()
+        // keyboard and mouse come from X11, only gamepads are read from evdev
+        InputLinux::InputLinux():
+            InputEvdev(InputDeviceEvdev::CLASS_GAMEPAD, false)
         {
         }
 
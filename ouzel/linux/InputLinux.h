@@ -3,7 +3,7 @@
 
 #pragma once
 
-#include "input/Input.h"
+#include "evdev/InputEvdev.h"
 
 namespace ouzel
 {
@@ -11,7 +11,7 @@ namespace ouzel
 
     namespace input
     {
-        class InputLinux: public Input
+        class InputLinux: public InputEvdev
         {
             friend Engine;
         public:
@@ -10,6 +10,29 @@
 
 namespace ouzel
 {
+#if OUZEL_SUPPORTS_SSE
+    // 2x2 matrix helpers for the block-wise SSE inverse, each matrix is stored in one __m128 as (m00, m01, m10, m11)
+    static inline __m128 mat2Mul(__m128 m1, __m128 m2)
+    {
+        return _mm_add_ps(_mm_mul_ps(m1, _mm_shuffle_ps(m2, m2, _MM_SHUFFLE(3, 0, 3, 0))),
+                          _mm_mul_ps(_mm_shuffle_ps(m1, m1, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(m2, m2, _MM_SHUFFLE(1, 2, 1, 2))));
+    }
+
+    // adj(m1) * m2
+    static inline __m128 mat2AdjMul(__m128 m1, __m128 m2)
+    {
+        return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(m1, m1, _MM_SHUFFLE(0, 0, 3, 3)), m2),
+                          _mm_mul_ps(_mm_shuffle_ps(m1, m1, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(m2, m2, _MM_SHUFFLE(1, 0, 3, 2))));
+    }
+
+    // m1 * adj(m2)
+    static inline __m128 mat2MulAdj(__m128 m1, __m128 m2)
+    {
+        return _mm_sub_ps(_mm_mul_ps(m1, _mm_shuffle_ps(m2, m2, _MM_SHUFFLE(0, 3, 0, 3))),
+                          _mm_mul_ps(_mm_shuffle_ps(m1, m1, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(m2, m2, _MM_SHUFFLE(1, 2, 1, 2))));
+    }
+#endif
+
     const Matrix4 Matrix4::IDENTITY(1.0f, 0.0f, 0.0f, 0.0f,
                                     0.0f, 1.0f, 0.0f, 0.0f,
                                     0.0f, 0.0f, 1.0f, 0.0f,
@@ -552,6 +575,56 @@ namespace ouzel
 
     bool Matrix4::invert(Matrix4& dst) const
     {
+#if OUZEL_SUPPORTS_SSE
+        // Block-wise inverse, the columns are treated as rows because inverse(transpose(M)) == transpose(inverse(M))
+        __m128 a = _mm_movelh_ps(col[0], col[1]);
+        __m128 b = _mm_movehl_ps(col[1], col[0]);
+        __m128 c = _mm_movelh_ps(col[2], col[3]);
+        __m128 d = _mm_movehl_ps(col[3], col[2]);
+
+        // determinants of the sub matrices (|A|, |B|, |C|, |D|)
+        __m128 detSub = _mm_sub_ps(
+            _mm_mul_ps(_mm_shuffle_ps(col[0], col[2], _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(col[1], col[3], _MM_SHUFFLE(3, 1, 3, 1))),
+            _mm_mul_ps(_mm_shuffle_ps(col[0], col[2], _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(col[1], col[3], _MM_SHUFFLE(2, 0, 2, 0))));
+        __m128 detA = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(0, 0, 0, 0));
+        __m128 detB = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(1, 1, 1, 1));
+        __m128 detC = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(2, 2, 2, 2));
+        __m128 detD = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(3, 3, 3, 3));
+
+        __m128 dc = mat2AdjMul(d, c);
+        __m128 ab = mat2AdjMul(a, b);
+
+        __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), mat2Mul(b, dc));
+        __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), mat2Mul(c, ab));
+        __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), mat2MulAdj(d, ab));
+        __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), mat2MulAdj(a, dc));
+
+        // |M| = |A| * |D| + |B| * |C| - tr(adj(A) * B * adj(D) * C)
+        __m128 tr = _mm_mul_ps(ab, _mm_shuffle_ps(dc, dc, _MM_SHUFFLE(3, 1, 2, 0)));
+        tr = _mm_add_ps(tr, _mm_movehl_ps(tr, tr));
+        tr = _mm_add_ss(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(1, 1, 1, 1)));
+
+        __m128 detM = _mm_sub_ss(_mm_add_ss(_mm_mul_ss(detA, detD), _mm_mul_ss(detB, detC)), tr);
+        float det = _mm_cvtss_f32(detM);
+
+        // Close to zero, can't invert.
+        if (fabs(det) <= TOLERANCE)
+            return false;
+
+        __m128 invDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), _mm_shuffle_ps(detM, detM, _MM_SHUFFLE(0, 0, 0, 0)));
+
+        x = _mm_mul_ps(x, invDet);
+        y = _mm_mul_ps(y, invDet);
+        z = _mm_mul_ps(z, invDet);
+        w = _mm_mul_ps(w, invDet);
+
+        dst.col[0] = _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3));
+        dst.col[1] = _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2));
+        dst.col[2] = _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3));
+        dst.col[3] = _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2));
+
+        return true;
+#else
         float a0 = m[0] * m[5] - m[1] * m[4];
         float a1 = m[0] * m[6] - m[2] * m[4];
         float a2 = m[0] * m[7] - m[3] * m[4];
@@ -597,6 +670,7 @@ namespace ouzel
         multiply(inverse, 1.0f / det, dst);
 
         return true;
+#endif
     }
 
     bool Matrix4::isIdentity() const
@@ -1173,26 +1247,41 @@ namespace ouzel
 #endif
     }
 
+    // without SSE the single points go through transformVector(Vector4), which has the NEON code
     void Matrix4::transformPoint(Vector3& point) const
     {
+#if OUZEL_SUPPORTS_SSE
+        transformPoints(&point, &point, 1);
+#else
         transformVector(point.x, point.y, point.z, 1.0f, point);
+#endif
     }
 
     void Matrix4::transformPoint(const Vector3& point, Vector3& dst) const
     {
+#if OUZEL_SUPPORTS_SSE
+        transformPoints(&point, &dst, 1);
+#else
         transformVector(point.x, point.y, point.z, 1.0f, dst);
+#endif
     }
 
     void Matrix4::transformVector(Vector3& vector) const
     {
-        Vector4 t;
-        transformVector(Vector4(vector.x, vector.y, vector.z, 0.0f), t);
-        vector = Vector3(t.x, t.y, t.z);
+#if OUZEL_SUPPORTS_SSE
+        transformVectors(&vector, &vector, 1);
+#else
+        transformVector(vector.x, vector.y, vector.z, 0.0f, vector);
+#endif
     }
 
     void Matrix4::transformVector(const Vector3& vector, Vector3& dst) const
     {
+#if OUZEL_SUPPORTS_SSE
+        transformVectors(&vector, &dst, 1);
+#else
         transformVector(vector.x, vector.y, vector.z, 0.0f, dst);
+#endif
     }
 
     void Matrix4::transformVector(float x, float y, float z, float w, Vector3& dst) const
@@ -1281,6 +1370,82 @@ namespace ouzel
 #endif
     }
 
+    void Matrix4::transformPoints(const Vector2* points, Vector2* dst, uint32_t count) const
+    {
+#if OUZEL_SUPPORTS_SSE
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(col[0], _mm_set1_ps(points[i].x)),
+                                                  _mm_mul_ps(col[1], _mm_set1_ps(points[i].y))),
+                                       col[3]);
+
+            _mm_storel_pi(reinterpret_cast<__m64*>(&dst[i].x), result);
+        }
+#else
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            float x = points[i].x;
+            float y = points[i].y;
+
+            dst[i].x = x * m[0] + y * m[4] + m[12];
+            dst[i].y = x * m[1] + y * m[5] + m[13];
+        }
+#endif
+    }
+
+    void Matrix4::transformPoints(const Vector3* points, Vector3* dst, uint32_t count) const
+    {
+#if OUZEL_SUPPORTS_SSE
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(col[0], _mm_set1_ps(points[i].x)),
+                                                  _mm_mul_ps(col[1], _mm_set1_ps(points[i].y))),
+                                       _mm_add_ps(_mm_mul_ps(col[2], _mm_set1_ps(points[i].z)),
+                                                  col[3]));
+
+            _mm_storel_pi(reinterpret_cast<__m64*>(&dst[i].x), result);
+            _mm_store_ss(&dst[i].z, _mm_movehl_ps(result, result));
+        }
+#else
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            float x = points[i].x;
+            float y = points[i].y;
+            float z = points[i].z;
+
+            dst[i].x = x * m[0] + y * m[4] + z * m[8] + m[12];
+            dst[i].y = x * m[1] + y * m[5] + z * m[9] + m[13];
+            dst[i].z = x * m[2] + y * m[6] + z * m[10] + m[14];
+        }
+#endif
+    }
+
+    void Matrix4::transformVectors(const Vector3* vectors, Vector3* dst, uint32_t count) const
+    {
+#if OUZEL_SUPPORTS_SSE
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            __m128 result = _mm_add_ps(_mm_add_ps(_mm_mul_ps(col[0], _mm_set1_ps(vectors[i].x)),
+                                                  _mm_mul_ps(col[1], _mm_set1_ps(vectors[i].y))),
+                                       _mm_mul_ps(col[2], _mm_set1_ps(vectors[i].z)));
+
+            _mm_storel_pi(reinterpret_cast<__m64*>(&dst[i].x), result);
+            _mm_store_ss(&dst[i].z, _mm_movehl_ps(result, result));
+        }
+#else
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            float x = vectors[i].x;
+            float y = vectors[i].y;
+            float z = vectors[i].z;
+
+            dst[i].x = x * m[0] + y * m[4] + z * m[8];
+            dst[i].y = x * m[1] + y * m[5] + z * m[9];
+            dst[i].z = x * m[2] + y * m[6] + z * m[10];
+        }
+#endif
+    }
+
     void Matrix4::translate(float x, float y, float z)
     {
         translate(x, y, z, *this);
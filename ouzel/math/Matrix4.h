@@ -7,6 +7,8 @@
 #if OUZEL_SUPPORTS_SSE
 #include <xmmintrin.h>
 #endif
+#include <cstdint>
+#include "Vector2.h"
 #include "Vector3.h"
 #include "Vector4.h"
 
@@ -688,6 +690,36 @@ namespace ouzel
          */
         void transformVector(const Vector4& vector, Vector4& dst) const;
 
+        /**
+         * Transforms an array of 2D points by this matrix, treating
+         * the z coordinate as zero and the w coordinate as one.
+         *
+         * @param points The points to transform.
+         * @param dst An array to store the transformed points in (can be the same as points).
+         * @param count The number of points.
+         */
+        void transformPoints(const Vector2* points, Vector2* dst, uint32_t count) const;
+
+        /**
+         * Transforms an array of 3D points by this matrix, treating
+         * the w coordinate as one.
+         *
+         * @param points The points to transform.
+         * @param dst An array to store the transformed points in (can be the same as points).
+         * @param count The number of points.
+         */
+        void transformPoints(const Vector3* points, Vector3* dst, uint32_t count) const;
+
+        /**
+         * Transforms an array of 3D vectors by this matrix, treating
+         * the w coordinate as zero.
+         *
+         * @param vectors The vectors to transform.
+         * @param dst An array to store the transformed vectors in (can be the same as vectors).
+         * @param count The number of vectors.
+         */
+        void transformVectors(const Vector3* vectors, Vector3* dst, uint32_t count) const;
+
         /**
          * Post-multiplies this matrix by the matrix corresponding to the
          * specified translation.
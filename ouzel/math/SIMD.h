@@ -0,0 +1,152 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <cstdint>
+#include <cmath>
+#include "core/CompileConfig.h"
+#if OUZEL_SUPPORTS_SSE
+#include <xmmintrin.h>
+#elif OUZEL_SUPPORTS_NEON || OUZEL_SUPPORTS_NEON64
+#include <arm_neon.h>
+#endif
+
+namespace ouzel
+{
+    /**
+     * Thin wrappers around four-wide float vectors, so that hot loops can be written once
+     * and compiled to SSE, NEON or plain scalar code.
+     * Loads and stores require 16-byte aligned addresses.
+     */
+    namespace simd
+    {
+#if OUZEL_SUPPORTS_SSE
+        typedef __m128 Float4;
+        typedef __m128 Mask4;
+
+        inline Float4 load(const float* p) { return _mm_load_ps(p); }
+        inline void store(float* p, Float4 v) { _mm_store_ps(p, v); }
+        inline Float4 set(float f) { return _mm_set1_ps(f); }
+
+        inline Float4 add(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+        inline Float4 sub(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+        inline Float4 mul(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+        inline Float4 min(Float4 a, Float4 b) { return _mm_min_ps(a, b); }
+        inline Float4 max(Float4 a, Float4 b) { return _mm_max_ps(a, b); }
+        inline Float4 reciprocalSqrt(Float4 v) { return _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(v)); }
+
+        inline Mask4 equal(Float4 a, Float4 b) { return _mm_cmpeq_ps(a, b); }
+        inline Mask4 less(Float4 a, Float4 b) { return _mm_cmplt_ps(a, b); }
+        inline Mask4 maskOr(Mask4 a, Mask4 b) { return _mm_or_ps(a, b); }
+        inline Mask4 maskAnd(Mask4 a, Mask4 b) { return _mm_and_ps(a, b); }
+        inline Float4 select(Mask4 mask, Float4 a, Float4 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+#elif OUZEL_SUPPORTS_NEON || OUZEL_SUPPORTS_NEON64
+        typedef float32x4_t Float4;
+        typedef uint32x4_t Mask4;
+
+        inline Float4 load(const float* p) { return vld1q_f32(p); }
+        inline void store(float* p, Float4 v) { vst1q_f32(p, v); }
+        inline Float4 set(float f) { return vdupq_n_f32(f); }
+
+        inline Float4 add(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+        inline Float4 sub(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+        inline Float4 mul(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+        inline Float4 min(Float4 a, Float4 b) { return vminq_f32(a, b); }
+        inline Float4 max(Float4 a, Float4 b) { return vmaxq_f32(a, b); }
+        inline Float4 reciprocalSqrt(Float4 v)
+        {
+            // estimate refined with two Newton-Raphson steps
+            Float4 e = vrsqrteq_f32(v);
+            e = vmulq_f32(e, vrsqrtsq_f32(vmulq_f32(v, e), e));
+            return vmulq_f32(e, vrsqrtsq_f32(vmulq_f32(v, e), e));
+        }
+
+        inline Mask4 equal(Float4 a, Float4 b) { return vceqq_f32(a, b); }
+        inline Mask4 less(Float4 a, Float4 b) { return vcltq_f32(a, b); }
+        inline Mask4 maskOr(Mask4 a, Mask4 b) { return vorrq_u32(a, b); }
+        inline Mask4 maskAnd(Mask4 a, Mask4 b) { return vandq_u32(a, b); }
+        inline Float4 select(Mask4 mask, Float4 a, Float4 b) { return vbslq_f32(mask, a, b); }
+#else
+        struct Float4
+        {
+            float v[4];
+        };
+
+        struct Mask4
+        {
+            bool v[4];
+        };
+
+        inline Float4 load(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+        inline void store(float* p, Float4 v) { p[0] = v.v[0]; p[1] = v.v[1]; p[2] = v.v[2]; p[3] = v.v[3]; }
+        inline Float4 set(float f) { return { { f, f, f, f } }; }
+
+        inline Float4 add(Float4 a, Float4 b) { return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } }; }
+        inline Float4 sub(Float4 a, Float4 b) { return { { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] } }; }
+        inline Float4 mul(Float4 a, Float4 b) { return { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } }; }
+        inline Float4 min(Float4 a, Float4 b) { return { { fminf(a.v[0], b.v[0]), fminf(a.v[1], b.v[1]), fminf(a.v[2], b.v[2]), fminf(a.v[3], b.v[3]) } }; }
+        inline Float4 max(Float4 a, Float4 b) { return { { fmaxf(a.v[0], b.v[0]), fmaxf(a.v[1], b.v[1]), fmaxf(a.v[2], b.v[2]), fmaxf(a.v[3], b.v[3]) } }; }
+        inline Float4 reciprocalSqrt(Float4 v) { return { { 1.0f / sqrtf(v.v[0]), 1.0f / sqrtf(v.v[1]), 1.0f / sqrtf(v.v[2]), 1.0f / sqrtf(v.v[3]) } }; }
+
+        inline Mask4 equal(Float4 a, Float4 b) { return { { a.v[0] == b.v[0], a.v[1] == b.v[1], a.v[2] == b.v[2], a.v[3] == b.v[3] } }; }
+        inline Mask4 less(Float4 a, Float4 b) { return { { a.v[0] < b.v[0], a.v[1] < b.v[1], a.v[2] < b.v[2], a.v[3] < b.v[3] } }; }
+        inline Mask4 maskOr(Mask4 a, Mask4 b) { return { { a.v[0] || b.v[0], a.v[1] || b.v[1], a.v[2] || b.v[2], a.v[3] || b.v[3] } }; }
+        inline Mask4 maskAnd(Mask4 a, Mask4 b) { return { { a.v[0] && b.v[0], a.v[1] && b.v[1], a.v[2] && b.v[2], a.v[3] && b.v[3] } }; }
+        inline Float4 select(Mask4 mask, Float4 a, Float4 b)
+        {
+            return { { mask.v[0] ? a.v[0] : b.v[0], mask.v[1] ? a.v[1] : b.v[1], mask.v[2] ? a.v[2] : b.v[2], mask.v[3] ? a.v[3] : b.v[3] } };
+        }
+#endif
+
+        /**
+         * Rounds to the nearest integer, valid for values with magnitude below 2^22.
+         */
+        inline Float4 round(Float4 v)
+        {
+            const Float4 magic = set(12582912.0f); // 1.5 * 2^23
+            return sub(add(v, magic), magic);
+        }
+
+        /**
+         * Calculates sine and cosine of four angles (in radians).
+         * Uses Cody-Waite range reduction to [-pi/4, pi/4] and the Cephes minimax polynomials,
+         * the absolute error is below 1e-6 for angles up to a few thousand radians.
+         */
+        inline void sinCos(Float4 angle, Float4& sinResult, Float4& cosResult)
+        {
+            // quadrant j = round(angle / (pi / 2)) and remainder r = angle - j * pi / 2
+            Float4 j = round(mul(angle, set(0.636619772f)));
+            Float4 r = sub(angle, mul(j, set(1.5703125f)));
+            r = sub(r, mul(j, set(4.83751297e-4f)));
+            r = sub(r, mul(j, set(7.54978995e-8f)));
+
+            Float4 r2 = mul(r, r);
+
+            Float4 s = set(-1.9515295891e-4f);
+            s = add(mul(s, r2), set(8.3321608736e-3f));
+            s = add(mul(s, r2), set(-1.6666654611e-1f));
+            s = add(mul(mul(s, r2), r), r);
+
+            Float4 c = set(2.443315711809948e-5f);
+            c = add(mul(c, r2), set(-1.388731625493765e-3f));
+            c = add(mul(c, r2), set(4.166664568298827e-2f));
+            c = add(sub(mul(mul(c, r2), r2), mul(r2, set(0.5f))), set(1.0f));
+
+            // q = j mod 4 (floor(j / 4) is round(j / 4 - 0.375) for integer j)
+            Float4 q = sub(j, mul(round(sub(mul(j, set(0.25f)), set(0.375f))), set(4.0f)));
+
+            Mask4 q1 = equal(q, set(1.0f));
+            Mask4 q2 = equal(q, set(2.0f));
+            Mask4 q3 = equal(q, set(3.0f));
+
+            Mask4 swap = maskOr(q1, q3);
+            Float4 sinValue = select(swap, c, s);
+            Float4 cosValue = select(swap, s, c);
+
+            const Float4 zero = set(0.0f);
+            sinResult = select(maskOr(q2, q3), sub(zero, sinValue), sinValue);
+            cosResult = select(maskOr(q1, q2), sub(zero, cosValue), cosValue);
+        }
+    } // namespace simd
+} // namespace ouzel
@@ -392,31 +392,19 @@ namespace ouzel
             bool previousScissorTestEnabled = false;
             Rectangle previousScissorTest;
 
-            std::queue<DrawCommand> drawCommands;
+            bool newFrame;
+            const FramePacket& framePacket = acquireFramePacket(newFrame);
+            const DrawCommandList& drawCommands = framePacket.drawCommands;
 
+            if (newFrame)
             {
-                std::lock_guard<std::mutex> lock(drawQueueMutex);
-                drawCommands = drawQueue;
-            }
-
-            std::queue<ResourcePtr> resources;
-
-            {
-                std::lock_guard<std::mutex> lock(updateMutex);
-                resources = std::move(updateQueue);
-                updateSet.clear();
-            }
-
-            while (!resources.empty())
-            {
-                const ResourcePtr& resource = resources.front();
-
-                if (!resource->update())
+                for (const ResourcePtr& resource : framePacket.resources)
                 {
-                    return false;
+                    if (!resource->update())
+                    {
+                        return false;
+                    }
                 }
-
-                resources.pop();
             }
 
             if (drawCommands.empty())
@@ -426,10 +414,8 @@ namespace ouzel
                     return false;
                 }
             }
-            else while (!drawCommands.empty())
+            else for (const DrawCommand& drawCommand : drawCommands)
             {
-                const DrawCommand& drawCommand = drawCommands.front();
-
                 MTLRenderPassDescriptorPtr newRenderPassDescriptor = Nil;
 
                 // render target
@@ -590,6 +576,10 @@ namespace ouzel
 
                 [currentRenderCommandEncoder setVertexBuffer:meshBufferMetal->getVertexBuffer() offset:0 atIndex:0];
 
+                // the indices can be shared with another mesh buffer
+                MeshBufferMetal* indexMeshBufferMetal = meshBufferMetal->getIndexMeshBuffer() ?
+                    static_cast<MeshBufferMetal*>(meshBufferMetal->getIndexMeshBuffer().get()) : meshBufferMetal.get();
+
                 // draw
                 MTLPrimitiveType primitiveType;
 
@@ -605,11 +595,9 @@ namespace ouzel
 
                 [currentRenderCommandEncoder drawIndexedPrimitives:primitiveType
                                                         indexCount:drawCommand.indexCount
-                                                         indexType:meshBufferMetal->getIndexFormat()
-                                                       indexBuffer:meshBufferMetal->getIndexBuffer()
-                                                 indexBufferOffset:static_cast<NSUInteger>(drawCommand.startIndex * meshBufferMetal->getIndexSize())];
-
-                drawCommands.pop();
+                                                         indexType:indexMeshBufferMetal->getIndexFormat()
+                                                       indexBuffer:indexMeshBufferMetal->getIndexBuffer()
+                                                 indexBufferOffset:static_cast<NSUInteger>(drawCommand.startIndex * indexMeshBufferMetal->getIndexSize())];
             }
 
             if (currentRenderCommandEncoder)
@@ -3,9 +3,9 @@
 
 #include "core/CompileConfig.h"
 
+#include <algorithm>
+#include <chrono>
 #include "AudioAL.h"
-#include "SoundDataAL.h"
-#include "SoundAL.h"
 #include "utils/Utils.h"
 
 namespace ouzel
@@ -69,12 +69,26 @@ namespace ouzel
         }
 
         AudioAL::AudioAL():
-            Audio(Driver::OPENAL)
+            Audio(Driver::OPENAL), running(false)
         {
         }
 
         AudioAL::~AudioAL()
         {
+            stopThread();
+
+            if (sourceId)
+            {
+                alSourceStop(sourceId);
+                alSourcei(sourceId, AL_BUFFER, 0);
+                alDeleteSources(1, &sourceId);
+            }
+
+            if (buffers[0])
+            {
+                alDeleteBuffers(BUFFER_COUNT, buffers);
+            }
+
             if (context)
             {
                 alcDestroyContext(context);
@@ -90,6 +104,32 @@ namespace ouzel
         {
             Audio::free();
 
+            stopThread();
+
+            if (sourceId)
+            {
+                alSourceStop(sourceId);
+                alSourcei(sourceId, AL_BUFFER, 0);
+                alDeleteSources(1, &sourceId);
+                sourceId = 0;
+
+                if (checkOpenALError())
+                {
+                    log("Failed to delete OpenAL source");
+                }
+            }
+
+            if (buffers[0])
+            {
+                alDeleteBuffers(BUFFER_COUNT, buffers);
+                std::fill(std::begin(buffers), std::end(buffers), 0);
+
+                if (checkOpenALError())
+                {
+                    log("Failed to delete OpenAL buffers");
+                }
+            }
+
             if (context)
             {
                 alcDestroyContext(context);
@@ -146,21 +186,109 @@ namespace ouzel
                 return false;
             }
 
+            // the mixed stream is played by one source through a queue of buffers
+            alGenSources(1, &sourceId);
+
+            if (checkOpenALError())
+            {
+                log("Failed to create OpenAL source");
+                return false;
+            }
+
+            alGenBuffers(BUFFER_COUNT, buffers);
+
+            if (checkOpenALError())
+            {
+                log("Failed to create OpenAL buffers");
+                return false;
+            }
+
+            mixBuffer.resize(BUFFER_FRAMES * 2);
+
+            for (ALuint buffer : buffers)
+            {
+                if (!fillBuffer(buffer))
+                {
+                    return false;
+                }
+            }
+
+            alSourceQueueBuffers(sourceId, BUFFER_COUNT, buffers);
+            alSourcePlay(sourceId);
+
+            if (checkOpenALError())
+            {
+                log("Failed to start OpenAL source");
+                return false;
+            }
+
+            running = true;
+            audioThread = std::thread(&AudioAL::run, this);
+
             ready = true;
             
             return true;
         }
 
-        SoundDataPtr AudioAL::createSoundData()
+        void AudioAL::stopThread()
         {
-            SoundDataPtr soundData(new SoundDataAL());
-            return soundData;
+            running = false;
+
+            if (audioThread.joinable())
+            {
+                audioThread.join();
+            }
         }
 
-        SoundPtr AudioAL::createSound()
+        void AudioAL::run()
         {
-            SoundPtr sound(new SoundAL());
-            return sound;
+            while (running)
+            {
+                ALint processed = 0;
+                alGetSourcei(sourceId, AL_BUFFERS_PROCESSED, &processed);
+
+                for (; processed > 0; --processed)
+                {
+                    ALuint buffer;
+                    alSourceUnqueueBuffers(sourceId, 1, &buffer);
+                    fillBuffer(buffer);
+                    alSourceQueueBuffers(sourceId, 1, &buffer);
+                }
+
+                ALint state;
+                alGetSourcei(sourceId, AL_SOURCE_STATE, &state);
+
+                // restart the source after an underrun
+                if (state != AL_PLAYING)
+                {
+                    alSourcePlay(sourceId);
+                }
+
+                if (checkOpenALError())
+                {
+                    log("Failed to stream OpenAL buffers");
+                }
+
+                // sleep for about a quarter of a buffer
+                std::this_thread::sleep_for(std::chrono::milliseconds(BUFFER_FRAMES * 250 / mixer.getSampleRate()));
+            }
+        }
+
+        bool AudioAL::fillBuffer(ALuint buffer)
+        {
+            mixer.process(mixBuffer.data(), BUFFER_FRAMES);
+
+            alBufferData(buffer, AL_FORMAT_STEREO16, mixBuffer.data(),
+                         static_cast<ALsizei>(mixBuffer.size() * sizeof(int16_t)),
+                         static_cast<ALsizei>(mixer.getSampleRate()));
+
+            if (checkOpenALError())
+            {
+                log("Failed to upload OpenAL buffer");
+                return false;
+            }
+
+            return true;
         }
     } // namespace audio
 } // namespace ouzel
@@ -13,6 +13,9 @@
 #include <AL/alc.h>
 #endif
 
+#include <thread>
+#include <atomic>
+#include <vector>
 #include "audio/Audio.h"
 
 namespace ouzel
@@ -31,17 +34,28 @@ namespace ouzel
 
             virtual bool init() override;
 
-            virtual SoundDataPtr createSoundData() override;
-            virtual SoundPtr createSound() override;
-
             ALCdevice* getDevice() const { return device; }
             ALCcontext* getContext() const { return context; }
 
         protected:
+            static const uint32_t BUFFER_COUNT = 3;
+            static const uint32_t BUFFER_FRAMES = 1024;
+
             AudioAL();
 
+            void stopThread();
+            void run();
+            bool fillBuffer(ALuint buffer);
+
             ALCdevice* device = nullptr;
             ALCcontext* context = nullptr;
+
+            ALuint sourceId = 0;
+            ALuint buffers[BUFFER_COUNT] = { 0 };
+            std::vector<int16_t> mixBuffer;
+
+            std::atomic<bool> running;
+            std::thread audioThread;
         };
     } // namespace audio
 } // namespace ouzel
@@ -257,31 +257,19 @@ namespace ouzel
 
             std::set<GLuint> clearedFrameBuffers;
 
-            std::queue<DrawCommand> drawCommands;
+            bool newFrame;
+            const FramePacket& framePacket = acquireFramePacket(newFrame);
+            const DrawCommandList& drawCommands = framePacket.drawCommands;
 
+            if (newFrame)
             {
-                std::lock_guard<std::mutex> lock(drawQueueMutex);
-                drawCommands = drawQueue;
-            }
-
-            std::queue<ResourcePtr> resources;
-
-            {
-                std::lock_guard<std::mutex> lock(updateMutex);
-                resources = std::move(updateQueue);
-                updateSet.clear();
-            }
-
-            while (!resources.empty())
-            {
-                const ResourcePtr& resource = resources.front();
-
-                if (!resource->update())
+                for (const ResourcePtr& resource : framePacket.resources)
                 {
-                    return false;
+                    if (!resource->update())
+                    {
+                        return false;
+                    }
                 }
-
-                resources.pop();
             }
 
             if (!update())
@@ -316,10 +304,8 @@ namespace ouzel
                     log("Failed to clear frame buffer");
                 }
             }
-            else while (!drawCommands.empty())
+            else for (const DrawCommand& drawCommand : drawCommands)
             {
-                const DrawCommand& drawCommand = drawCommands.front();
-
                 // blend state
                 std::shared_ptr<BlendStateOGL> blendStateOGL = std::static_pointer_cast<BlendStateOGL>(drawCommand.blendState);
 
@@ -531,23 +517,25 @@ namespace ouzel
                     return false;
                 }
 
-                if (!bindElementArrayBuffer(meshBufferOGL->getIndexBufferId()))
+                // the indices can be shared with another mesh buffer
+                MeshBufferOGL* indexMeshBufferOGL = meshBufferOGL->getIndexMeshBuffer() ?
+                    static_cast<MeshBufferOGL*>(meshBufferOGL->getIndexMeshBuffer().get()) : meshBufferOGL.get();
+
+                if (!bindElementArrayBuffer(indexMeshBufferOGL->getIndexBufferId()))
                 {
                     return false;
                 }
 
                 glDrawElements(mode,
                                static_cast<GLsizei>(drawCommand.indexCount),
-                               meshBufferOGL->getIndexFormat(),
-                               static_cast<const char*>(nullptr) + (drawCommand.startIndex * meshBufferOGL->getIndexSize()));
+                               indexMeshBufferOGL->getIndexFormat(),
+                               static_cast<const char*>(nullptr) + (drawCommand.startIndex * indexMeshBufferOGL->getIndexSize()));
 
                 if (checkOpenGLError())
                 {
                     log("Failed to draw elements");
                     return false;
                 }
-
-                drawCommands.pop();
             }
 
             return true;
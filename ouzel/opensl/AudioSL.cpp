@@ -2,8 +2,6 @@
 // This file is part of the Ouzel engine.
 
 #include "AudioSL.h"
-#include "SoundDataSL.h"
-#include "SoundSL.h"
 #include "utils/Utils.h"
 
 namespace ouzel
@@ -17,6 +15,11 @@ namespace ouzel
 
         AudioSL::~AudioSL()
         {
+            if (playerObject)
+            {
+                (*playerObject)->Destroy(playerObject);
+            }
+
             if (outputMixObject)
             {
                 (*outputMixObject)->Destroy(outputMixObject);
@@ -32,6 +35,14 @@ namespace ouzel
         {
             Audio::free();
 
+            if (playerObject)
+            {
+                (*playerObject)->Destroy(playerObject);
+                playerObject = nullptr;
+                player = nullptr;
+                bufferQueue = nullptr;
+            }
+
             if (outputMixObject)
             {
                 (*outputMixObject)->Destroy(outputMixObject);
@@ -89,21 +100,106 @@ namespace ouzel
                 return false;
             }
 
+            // the mixed stream is played by one player through a buffer queue
+            SLDataLocator_AndroidSimpleBufferQueue location = { SL_DATALOCATOR_ANDROIDSIMPLEBUFFERQUEUE, BUFFER_COUNT };
+
+            SLDataFormat_PCM format;
+            format.formatType = SL_DATAFORMAT_PCM;
+            format.numChannels = 2;
+            format.samplesPerSec = mixer.getSampleRate() * 1000; //mHz
+            format.bitsPerSample = SL_PCMSAMPLEFORMAT_FIXED_16;
+            format.containerSize = SL_PCMSAMPLEFORMAT_FIXED_16;
+            format.channelMask = SL_SPEAKER_FRONT_LEFT | SL_SPEAKER_FRONT_RIGHT;
+            format.endianness = SL_BYTEORDER_LITTLEENDIAN;
+
+            SLDataSource dataSource = { &location, &format };
+
+            SLDataLocator_OutputMix dataLocatorOut;
+            dataLocatorOut.locatorType = SL_DATALOCATOR_OUTPUTMIX;
+            dataLocatorOut.outputMix = outputMixObject;
+
+            SLDataSink dataSink;
+            dataSink.pLocator = &dataLocatorOut;
+            dataSink.pFormat = NULL;
+
+            const SLuint32 playerIIDCount = 2;
+            const SLInterfaceID playerIIDs[] = { SL_IID_BUFFERQUEUE, SL_IID_PLAY };
+            const SLboolean playerReqs[] = { SL_BOOLEAN_TRUE, SL_BOOLEAN_TRUE };
+
+            if ((*engine)->CreateAudioPlayer(engine, &playerObject, &dataSource, &dataSink, playerIIDCount, playerIIDs, playerReqs) != SL_RESULT_SUCCESS)
+            {
+                log("Failed to create OpenSL player object");
+                return false;
+            }
+
+            if ((*playerObject)->Realize(playerObject, SL_BOOLEAN_FALSE) != SL_RESULT_SUCCESS)
+            {
+                log("Failed to create OpenSL player object");
+                return false;
+            }
+
+            if ((*playerObject)->GetInterface(playerObject, SL_IID_PLAY, &player) != SL_RESULT_SUCCESS)
+            {
+                log("Failed to get OpenSL player");
+                return false;
+            }
+
+            if ((*playerObject)->GetInterface(playerObject, SL_IID_BUFFERQUEUE, &bufferQueue) != SL_RESULT_SUCCESS)
+            {
+                log("Failed to get OpenSL buffer queue");
+                return false;
+            }
+
+            if ((*bufferQueue)->RegisterCallback(bufferQueue, playerCallback, this) != SL_RESULT_SUCCESS)
+            {
+                log("Failed to register OpenSL buffer queue callback");
+                return false;
+            }
+
+            for (std::vector<int16_t>& buffer : buffers)
+            {
+                buffer.resize(BUFFER_FRAMES * 2);
+            }
+
+            for (uint32_t i = 0; i < BUFFER_COUNT; ++i)
+            {
+                if (!enqueueBuffer())
+                {
+                    return false;
+                }
+            }
+
+            if ((*player)->SetPlayState(player, SL_PLAYSTATE_PLAYING) != SL_RESULT_SUCCESS)
+            {
+                log("Failed to play sound");
+                return false;
+            }
+
             ready = true;
 
             return true;
         }
 
-        SoundDataPtr AudioSL::createSoundData()
+        void AudioSL::playerCallback(SLAndroidSimpleBufferQueueItf, void* context)
         {
-            SoundDataPtr soundData(new SoundDataSL());
-            return soundData;
+            AudioSL* audioSL = reinterpret_cast<AudioSL*>(context);
+            audioSL->enqueueBuffer();
         }
 
-        SoundPtr AudioSL::createSound()
+        bool AudioSL::enqueueBuffer()
         {
-            SoundPtr sound(new SoundSL());
-            return sound;
+            std::vector<int16_t>& buffer = buffers[nextBuffer];
+            nextBuffer = (nextBuffer + 1) % BUFFER_COUNT;
+
+            mixer.process(buffer.data(), BUFFER_FRAMES);
+
+            if ((*bufferQueue)->Enqueue(bufferQueue, buffer.data(), buffer.size() * sizeof(int16_t)) != SL_RESULT_SUCCESS)
+            {
+                log("Failed to enqueue OpenSL data");
+                return false;
+            }
+
+            return true;
         }
     } // namespace audio
 } // namespace ouzel
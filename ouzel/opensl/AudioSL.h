@@ -7,6 +7,7 @@
 #include <SLES/OpenSLES_Android.h>
 #include <SLES/OpenSLES_AndroidConfiguration.h>
 
+#include <vector>
 #include "audio/Audio.h"
 
 namespace ouzel
@@ -22,18 +23,29 @@ namespace ouzel
 
             virtual bool init() override;
 
-            virtual SoundDataPtr createSoundData() override;
-            virtual SoundPtr createSound() override;
-
             SLEngineItf getEngine() const { return engine; }
             SLObjectItf getOutputMix() const { return outputMixObject; }
 
         protected:
+            static const uint32_t BUFFER_COUNT = 2;
+            static const uint32_t BUFFER_FRAMES = 1024;
+
             AudioSL();
 
+            // called on the OpenSL thread, which serves as the audio thread
+            static void playerCallback(SLAndroidSimpleBufferQueueItf bufferQueue, void* context);
+            bool enqueueBuffer();
+
             SLObjectItf engineObject = nullptr;
             SLEngineItf engine = nullptr;
             SLObjectItf outputMixObject = nullptr;
+
+            SLObjectItf playerObject = nullptr;
+            SLPlayItf player = nullptr;
+            SLAndroidSimpleBufferQueueItf bufferQueue = nullptr;
+
+            std::vector<int16_t> buffers[BUFFER_COUNT];
+            uint32_t nextBuffer = 0;
         };
     } // namespace audio
 } // namespace ouzel
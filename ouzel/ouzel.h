@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "animators/AnimationSystem.h"
 #include "animators/Animator.h"
 #include "animators/Ease.h"
 #include "animators/Fade.h"
@@ -16,14 +17,19 @@
 #include "audio/Audio.h"
 #include "audio/Sound.h"
 #include "audio/SoundData.h"
+#include "audio/SoundStream.h"
+#include "audio/Mixer.h"
 #include "core/Application.h"
 #include "core/Cache.h"
 #include "core/CompileConfig.h"
 #include "core/Engine.h"
 #include "core/Settings.h"
+#include "core/TimerManager.h"
 #include "core/UpdateCallback.h"
 #include "core/Window.h"
+#include "core/WorkerPool.h"
 #include "events/EventHandler.h"
+#include "events/EventRecorder.h"
 #include "files/FileSystem.h"
 #include "graphics/BlendState.h"
 #include "graphics/Color.h"
@@ -37,6 +43,7 @@
 #include "gui/Button.h"
 #include "gui/CheckBox.h"
 #include "gui/Label.h"
+#include "gui/LatencyLabel.h"
 #include "gui/Menu.h"
 #include "gui/Widget.h"
 #include "input/Gamepad.h"
@@ -55,7 +62,9 @@
 #include "scene/Drawable.h"
 #include "scene/Layer.h"
 #include "scene/Node.h"
+#include "scene/ParticleManager.h"
 #include "scene/ParticleSystem.h"
+#include "scene/ParticleSystemPool.h"
 #include "scene/Scene.h"
 #include "scene/SceneManager.h"
 #include "scene/Sprite.h"
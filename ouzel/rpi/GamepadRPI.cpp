@@ -1,18 +0,0 @@
-// Copyright (C) 2016 Elviss Strazdins
-// This file is part of the Ouzel engine.
-
-#include "GamepadRPI.h"
-
-namespace ouzel
-{
-    namespace input
-    {
-        GamepadRPI::GamepadRPI()
-        {
-        }
-
-        GamepadRPI::~GamepadRPI()
-        {
-        }
-    } // namespace input
-} // namespace ouzel
@@ -3,8 +3,7 @@
 
 #pragma once
 
-#include <vector>
-#include "input/Input.h"
+#include "evdev/InputEvdev.h"
 
 namespace ouzel
 {
@@ -12,33 +11,14 @@ namespace ouzel
 
     namespace input
     {
-        struct InputDeviceRPI
-        {
-            enum DeviceClass
-            {
-                CLASS_KEYBOARD = 1,
-                CLASS_MOUSE = 2,
-                CLASS_TOUCHPAD = 4,
-                CLASS_GAMEPAD = 8
-            };
-
-            uint32_t deviceClass = 0;
-            int fd = 0;
-        };
-
-        class InputRPI: public Input
+        class InputRPI: public InputEvdev
         {
             friend Engine;
         public:
             virtual ~InputRPI();
 
-            virtual void update() override;
-
         protected:
             InputRPI();
-
-            int maxFd = 0;
-            std::vector<InputDeviceRPI> inputDevices;
         };
     } // namespace input
 } // namespace ouzel
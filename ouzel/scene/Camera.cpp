@@ -36,6 +36,8 @@ namespace ouzel
             }
 
             localTransformDirty = transformDirty = inverseTransformDirty = true;
+
+            invalidateDrawCommands();
         }
 
         void Camera::recalculateProjection()
@@ -97,6 +99,8 @@ namespace ouzel
             inverseProjection.invert();
 
             viewProjectionDirty = true;
+
+            invalidateDrawCommands();
         }
 
         const Matrix4& Camera::getViewProjection() const
@@ -104,6 +108,7 @@ namespace ouzel
             if (viewProjectionDirty || transformDirty)
             {
                 viewProjection = projection * getTransform();
+                viewProjectionDirty = false;
             }
 
             return viewProjection;
@@ -220,5 +225,13 @@ namespace ouzel
         {
             layer.reset();
         }
+
+        void Camera::invalidateParentDrawCommands()
+        {
+            if (LayerPtr currentLayer = layer.lock())
+            {
+                currentLayer->invalidateDrawCommands();
+            }
+        }
     } // namespace scene
 } // namespace ouzel
@@ -53,6 +53,7 @@ namespace ouzel
             virtual void removeFromLayer();
 
         protected:
+            virtual void invalidateParentDrawCommands() override;
             virtual void calculateLocalTransform() const override;
 
             float zoom = 1.0f;
@@ -66,7 +67,7 @@ namespace ouzel
             Size2 contentSize;
             Vector2 contentScale;
 
-            bool viewProjectionDirty = false;
+            mutable bool viewProjectionDirty = false;
             mutable Matrix4 viewProjection = Matrix4::IDENTITY;
 
             LayerWeakPtr layer;
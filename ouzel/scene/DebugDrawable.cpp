@@ -62,6 +62,8 @@ namespace ouzel
             boundingBox = AABB2();
 
             drawCommands.clear();
+
+            invalidateDrawCommands();
         }
 
         void DebugDrawable::point(const Vector2& position, const graphics::Color& color)
@@ -83,6 +85,8 @@ namespace ouzel
 
             drawCommands.push_back(command);
 
+            invalidateDrawCommands();
+
             boundingBox.insertPoint(position);
         }
 
@@ -106,6 +110,8 @@ namespace ouzel
 
             drawCommands.push_back(command);
 
+            invalidateDrawCommands();
+
             boundingBox.insertPoint(start);
             boundingBox.insertPoint(finish);
         }
@@ -168,6 +174,8 @@ namespace ouzel
 
             drawCommands.push_back(command);
 
+            invalidateDrawCommands();
+
             boundingBox.insertPoint(Vector2(position.x - radius, position.y - radius));
             boundingBox.insertPoint(Vector2(position.x + radius, position.y + radius));
         }
@@ -204,6 +212,8 @@ namespace ouzel
 
             drawCommands.push_back(command);
 
+            invalidateDrawCommands();
+
             boundingBox.insertPoint(Vector2(rectangle.x, rectangle.y));
             boundingBox.insertPoint(Vector2(rectangle.x + rectangle.width, rectangle.y + rectangle.height));
         }
@@ -241,6 +251,8 @@ namespace ouzel
                                          static_cast<uint32_t>(vertices.size()), false);
 
             drawCommands.push_back(command);
+
+            invalidateDrawCommands();
         }
 
     } // namespace scene
@@ -2,6 +2,7 @@
 // This file is part of the Ouzel engine.
 
 #include "Drawable.h"
+#include "Node.h"
 #include "utils/Utils.h"
 #include "math/MathUtils.h"
 
@@ -21,6 +22,39 @@ namespace ouzel
         {
         }
 
+        void Drawable::setVisible(bool newVisible)
+        {
+            visible = newVisible;
+
+            invalidateDrawCommands();
+        }
+
+        void Drawable::invalidateDrawCommands()
+        {
+            if (node)
+            {
+                node->invalidateDrawCommands();
+            }
+        }
+
+        bool Drawable::applyUpdatePolicy(float& delta)
+        {
+            if (updatePolicy == Node::UpdatePolicy::ALWAYS || !node || node->isOnScreen())
+            {
+                delta += skippedTime;
+                skippedTime = 0.0f;
+
+                return true;
+            }
+
+            if (updatePolicy == Node::UpdatePolicy::FAST_FORWARD)
+            {
+                skippedTime += delta;
+            }
+
+            return false;
+        }
+
         bool Drawable::pointOn(const Vector2& position) const
         {
             return boundingBox.containsPoint(position);
@@ -9,13 +9,18 @@
 #include "math/AABB2.h"
 #include "math/Matrix4.h"
 #include "graphics/Color.h"
+#include "scene/Node.h"
 
 namespace ouzel
 {
     namespace scene
     {
+        // Drawables of different layers are drawn concurrently on worker threads (see Layer::draw).
+        // draw may only modify the drawable itself, so a drawable must not be shared between layers,
+        // and it must add its commands through Renderer::addDrawCommand from the calling thread.
         class Drawable: public ouzel::Noncopyable
         {
+            friend Node;
         public:
             virtual ~Drawable();
 
@@ -31,11 +36,24 @@ namespace ouzel
             virtual bool shapeOverlaps(const std::vector<Vector2>& edges) const;
 
             bool isVisible() const { return visible; }
-            virtual void setVisible(bool newVisible) { visible = newVisible; }
+            virtual void setVisible(bool newVisible);
+
+            void setUpdatePolicy(Node::UpdatePolicy newUpdatePolicy) { updatePolicy = newUpdatePolicy; }
+            Node::UpdatePolicy getUpdatePolicy() const { return updatePolicy; }
 
         protected:
+            void invalidateDrawCommands();
+
+            // returns false if the update should be skipped, otherwise adds the time skipped while off screen to delta
+            bool applyUpdatePolicy(float& delta);
+
             AABB2 boundingBox;
             bool visible = true;
+
+            Node* node = nullptr;
+
+            Node::UpdatePolicy updatePolicy = Node::UpdatePolicy::ALWAYS;
+            float skippedTime = 0.0f;
         };
     } // namespace scene
 } // namespace ouzel
@@ -1,6 +1,7 @@
 // Copyright (C) 2016 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <algorithm>
 #include "Layer.h"
 #include "core/Engine.h"
 #include "Node.h"
@@ -9,12 +10,34 @@
 #include "Scene.h"
 #include "math/Matrix4.h"
 #include "Drawable.h"
+#include "core/WorkerPool.h"
+#include "utils/Utils.h"
 
 namespace ouzel
 {
     namespace scene
     {
-        Layer::Layer()
+        // minimal number of nodes in the draw queue per worker task
+        static const size_t NODES_PER_DRAW_TASK = 128;
+
+        static bool compareDrawCommands(const graphics::Renderer::DrawCommand& a, const graphics::Renderer::DrawCommand& b)
+        {
+            return a.textures == b.textures &&
+                a.shader == b.shader &&
+                a.pixelShaderConstants == b.pixelShaderConstants &&
+                a.vertexShaderConstants == b.vertexShaderConstants &&
+                a.blendState == b.blendState &&
+                a.meshBuffer == b.meshBuffer &&
+                a.indexCount == b.indexCount &&
+                a.drawMode == b.drawMode &&
+                a.startIndex == b.startIndex &&
+                a.renderTarget == b.renderTarget &&
+                a.scissorTestEnabled == b.scissorTestEnabled &&
+                a.scissorTest == b.scissorTest;
+        }
+
+        Layer::Layer():
+            drawCommandsValid(false)
         {
 
         }
@@ -26,8 +49,46 @@ namespace ouzel
 
         void Layer::draw()
         {
+            if (drawCommandCaching && drawCommandsValid)
+            {
+                ++drawCommandCacheHits;
+
+                if (verifyDrawCommandCache)
+                {
+                    graphics::Renderer::DrawCommandList cachedDrawCommands = std::move(drawCommands);
+                    generateDrawCommands();
+
+                    if (cachedDrawCommands.size() != drawCommands.size() ||
+                        !std::equal(cachedDrawCommands.begin(), cachedDrawCommands.end(), drawCommands.begin(), compareDrawCommands))
+                    {
+                        log("Cached draw commands of layer %p differ from generated draw commands", this);
+                    }
+                }
+
+                return;
+            }
+
+            // changes made while generating the commands will invalidate them again
+            drawCommandsValid = true;
+            generateDrawCommands();
+
+            if (drawCommandCaching)
+            {
+                ++drawCommandCacheMisses;
+            }
+        }
+
+        void Layer::generateDrawCommands()
+        {
+            for (const NodePtr& node : onScreenNodes)
+            {
+                node->onScreen = false;
+            }
+
+            onScreenNodes.clear();
             globalNodes.clear();
             drawQueue.clear();
+            drawCommands.clear();
 
             // render only if there is an active camera
             if (camera)
@@ -38,8 +99,9 @@ namespace ouzel
                 {
                     if (child->isVisible())
                     {
+                        child->insideBitmap = false;
                         addGlobalNode(child);
-                        child->visit(Matrix4::IDENTITY, false, std::static_pointer_cast<Layer>(shared_from_this()));
+                        child->visit(Matrix4::IDENTITY, Matrix4::IDENTITY, false, std::static_pointer_cast<Layer>(shared_from_this()));
                     }
                 }
 
@@ -52,10 +114,88 @@ namespace ouzel
                     node->process(std::static_pointer_cast<Layer>(shared_from_this()));
                 }
 
+                // a node is on screen if any node of its subtree is, so that animators of container nodes are updated
+                for (const NodePtr& node : drawQueue)
+                {
+                    NodePtr current = node;
+
+                    while (current && !current->onScreen)
+                    {
+                        current->onScreen = true;
+                        onScreenNodes.push_back(current);
+                        current = std::dynamic_pointer_cast<Node>(current->getParent());
+                    }
+                }
+
+                // view projection is cached, so calculate it before the draw queue is split between threads
+                camera->getViewProjection();
+
+                const graphics::RendererPtr& renderer = sharedEngine->getRenderer();
+                graphics::Renderer::DrawCommandList* previousDrawCommandList = renderer->getDrawCommandList();
+                renderer->setDrawCommandList(&drawCommands);
+
+                // rendering a bitmap acquires render targets, so it is not done by the draw tasks
                 for (const NodePtr& node : drawQueue)
                 {
-                    node->draw(std::static_pointer_cast<Layer>(shared_from_this()));
+                    if (node->cacheAsBitmap && node->bitmapDirty && !node->insideBitmap)
+                    {
+                        node->renderBitmap();
+                    }
                 }
+
+                LayerPtr layer = std::static_pointer_cast<Layer>(shared_from_this());
+                const WorkerPoolPtr& workerPool = sharedEngine->getWorkerPool();
+                size_t taskCount = std::min(static_cast<size_t>(workerPool->getThreadCount()), drawQueue.size() / NODES_PER_DRAW_TASK);
+
+                if (taskCount > 1)
+                {
+                    std::vector<graphics::Renderer::DrawCommandList> taskDrawCommands(taskCount);
+                    std::vector<std::function<void()>> tasks;
+                    size_t nodesPerTask = (drawQueue.size() + taskCount - 1) / taskCount;
+
+                    std::list<NodePtr>::const_iterator i = drawQueue.begin();
+
+                    for (size_t task = 0; task < taskCount; ++task)
+                    {
+                        std::list<NodePtr>::const_iterator begin = i;
+
+                        for (size_t n = 0; n < nodesPerTask && i != drawQueue.end(); ++n)
+                        {
+                            ++i;
+                        }
+
+                        std::list<NodePtr>::const_iterator end = i;
+                        graphics::Renderer::DrawCommandList* taskDrawCommandList = &taskDrawCommands[task];
+
+                        tasks.push_back([layer, begin, end, taskDrawCommandList, &renderer]() {
+                            graphics::Renderer::DrawCommandList* previousTaskDrawCommandList = renderer->getDrawCommandList();
+                            renderer->setDrawCommandList(taskDrawCommandList);
+
+                            for (std::list<NodePtr>::const_iterator node = begin; node != end; ++node)
+                            {
+                                (*node)->draw(layer);
+                            }
+
+                            renderer->setDrawCommandList(previousTaskDrawCommandList);
+                        });
+                    }
+
+                    workerPool->run(tasks);
+
+                    for (graphics::Renderer::DrawCommandList& taskDrawCommandList : taskDrawCommands)
+                    {
+                        renderer->addDrawCommands(std::move(taskDrawCommandList));
+                    }
+                }
+                else
+                {
+                    for (const NodePtr& node : drawQueue)
+                    {
+                        node->draw(layer);
+                    }
+                }
+
+                renderer->setDrawCommandList(previousDrawCommandList);
             }
         }
 
@@ -73,6 +213,23 @@ namespace ouzel
             }
         }
 
+        void Layer::invalidateDrawCommands()
+        {
+            drawCommandsValid = false;
+        }
+
+        void Layer::setDrawCommandCaching(bool newDrawCommandCaching)
+        {
+            drawCommandCaching = newDrawCommandCaching;
+            drawCommandsValid = false;
+        }
+
+        void Layer::resetDrawCommandCacheStats()
+        {
+            drawCommandCacheHits = 0;
+            drawCommandCacheMisses = 0;
+        }
+
         void Layer::addGlobalNode(const NodePtr& node)
         {
             globalNodes.push_back(node);
@@ -97,6 +254,8 @@ namespace ouzel
                 camera->addToLayer(std::static_pointer_cast<Layer>(shared_from_this()));
                 camera->recalculateProjection();
             }
+
+            invalidateDrawCommands();
         }
 
         NodePtr Layer::pickNode(const Vector2& position) const
@@ -144,17 +303,26 @@ namespace ouzel
             {
                 camera->recalculateProjection();
             }
+
+            invalidateDrawCommands();
         }
 
         bool Layer::checkVisibility(const NodePtr& node) const
         {
             if (camera)
             {
+                if (node->isCacheAsBitmap())
+                {
+                    const AABB2& boundingBox = node->getBitmapBoundingBox();
+
+                    return boundingBox.isEmpty() || camera->checkVisibility(node->getDrawTransform(), boundingBox);
+                }
+
                 for (const DrawablePtr& drawable : node->getDrawables())
                 {
                     if (drawable->isVisible() &&
                         (drawable->getBoundingBox().isEmpty() ||
-                         camera->checkVisibility(node->getTransform(), drawable->getBoundingBox())))
+                         camera->checkVisibility(node->getDrawTransform(), drawable->getBoundingBox())))
                     {
                         return true;
                     }
@@ -6,12 +6,14 @@
 #include <vector>
 #include <memory>
 #include <set>
+#include <atomic>
 #include "utils/Types.h"
 #include "scene/NodeContainer.h"
 #include "math/Size2.h"
 #include "math/Matrix4.h"
 #include "math/Vector2.h"
 #include "math/Rectangle.h"
+#include "graphics/Renderer.h"
 
 namespace ouzel
 {
@@ -31,6 +33,20 @@ namespace ouzel
 
             virtual bool addChild(const NodePtr& node) override;
 
+            virtual void invalidateDrawCommands() override;
+
+            // replays the draw commands of the previous frame until something in the layer changes
+            void setDrawCommandCaching(bool newDrawCommandCaching);
+            bool isDrawCommandCaching() const { return drawCommandCaching; }
+
+            // regenerates the draw commands on every cache hit and logs if they differ from the cached ones
+            void setVerifyDrawCommandCache(bool newVerifyDrawCommandCache) { verifyDrawCommandCache = newVerifyDrawCommandCache; }
+            bool isVerifyDrawCommandCache() const { return verifyDrawCommandCache; }
+
+            uint32_t getDrawCommandCacheHits() const { return drawCommandCacheHits; }
+            uint32_t getDrawCommandCacheMisses() const { return drawCommandCacheMisses; }
+            void resetDrawCommandCacheStats();
+
             void addGlobalNode(const NodePtr& node);
             void addToDrawQueue(const NodePtr& node);
 
@@ -49,13 +65,24 @@ namespace ouzel
             bool checkVisibility(const NodePtr& node) const;
 
         protected:
+            void generateDrawCommands();
+
             CameraPtr camera;
             std::list<NodePtr> globalNodes;
             std::list<NodePtr> drawQueue;
+            std::vector<NodePtr> onScreenNodes; // nodes of the draw queue and their ancestors
 
             int32_t order = 0;
 
             graphics::RenderTargetPtr renderTarget;
+
+            graphics::Renderer::DrawCommandList drawCommands;
+
+            bool drawCommandCaching = false;
+            bool verifyDrawCommandCache = false;
+            std::atomic<bool> drawCommandsValid;
+            uint32_t drawCommandCacheHits = 0;
+            uint32_t drawCommandCacheMisses = 0;
         };
     } // namespace scene
 } // namespace ouzel
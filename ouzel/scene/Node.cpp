@@ -1,6 +1,8 @@
 // Copyright (C) 2016 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <algorithm>
+#include <cmath>
 #include "Node.h"
 #include "core/Engine.h"
 #include "SceneManager.h"
@@ -10,6 +12,11 @@
 #include "utils/Utils.h"
 #include "math/MathUtils.h"
 #include "Drawable.h"
+#include "SpriteFrame.h"
+#include "core/Cache.h"
+#include "graphics/Renderer.h"
+#include "graphics/RenderTarget.h"
+#include "graphics/Texture.h"
 
 namespace ouzel
 {
@@ -22,10 +29,22 @@ namespace ouzel
 
         Node::~Node()
         {
+            if (bitmapRenderTarget)
+            {
+                sharedEngine->getRenderer()->releaseRenderTarget(bitmapRenderTarget);
+            }
 
+            for (const DrawablePtr& drawable : drawables)
+            {
+                if (drawable->node == this)
+                {
+                    drawable->node = nullptr;
+                }
+            }
         }
 
-        void Node::visit(const Matrix4& newTransformMatrix, bool parentTransformDirty, const LayerPtr& currentLayer)
+        void Node::visit(const Matrix4& newTransformMatrix, const Matrix4& newParentDrawTransform,
+                         bool parentTransformDirty, const LayerPtr& currentLayer)
         {
             if (parentTransformDirty)
             {
@@ -37,18 +56,33 @@ namespace ouzel
                 calculateTransform();
             }
 
+            if (sharedEngine->getFixedTimeStep() > 0.0f)
+            {
+                // the interpolated transform changes every frame, so the cached draw commands can't be replayed
+                if (calculateDrawTransform(newParentDrawTransform))
+                {
+                    invalidateParentDrawCommands();
+                }
+            }
+            else
+            {
+                drawTransform = transform;
+            }
+
             if (currentLayer)
             {
                 for (const NodePtr& child : children)
                 {
                     if (child->isVisible())
                     {
+                        child->insideBitmap = insideBitmap || cacheAsBitmap;
+
                         if (child->isGlobalOrder())
                         {
                             currentLayer->addGlobalNode(child);
                         }
 
-                        child->visit(transform, updateChildrenTransform, currentLayer);
+                        child->visit(transform, drawTransform, updateChildrenTransform, currentLayer);
                     }
                 }
             }
@@ -110,6 +144,11 @@ namespace ouzel
 
         void Node::draw(const LayerPtr& currentLayer)
         {
+            if (insideBitmap)
+            {
+                return;
+            }
+
             if (transformDirty)
             {
                 calculateTransform();
@@ -117,7 +156,32 @@ namespace ouzel
 
             if (currentLayer)
             {
-                if (currentLayer->getCamera())
+                if (cacheAsBitmap && currentLayer->getCamera())
+                {
+                    if (bitmapFrame)
+                    {
+                        Matrix4 modelViewProj = currentLayer->getCamera()->getViewProjection() * drawTransform;
+                        float colorVector[] = { color.getR(), color.getG(), color.getB(), color.getA() * opacity };
+
+                        std::vector<std::vector<float>> pixelShaderConstants(1);
+                        pixelShaderConstants[0] = { std::begin(colorVector), std::end(colorVector) };
+
+                        std::vector<std::vector<float>> vertexShaderConstants(1);
+                        vertexShaderConstants[0] = { std::begin(modelViewProj.m), std::end(modelViewProj.m) };
+
+                        sharedEngine->getRenderer()->addDrawCommand({ bitmapFrame->getTexture() },
+                                                                    sharedEngine->getCache()->getShader(graphics::SHADER_TEXTURE),
+                                                                    pixelShaderConstants,
+                                                                    vertexShaderConstants,
+                                                                    sharedEngine->getCache()->getBlendState(graphics::BLEND_ALPHA),
+                                                                    bitmapFrame->getMeshBuffer(),
+                                                                    0,
+                                                                    graphics::Renderer::DrawMode::TRIANGLE_LIST,
+                                                                    0,
+                                                                    currentLayer->getRenderTarget());
+                    }
+                }
+                else if (currentLayer->getCamera())
                 {
                     graphics::Color drawColor(color.r, color.g, color.b, static_cast<uint8_t>(color.a * opacity));
 
@@ -126,7 +190,7 @@ namespace ouzel
                         if (drawable->isVisible())
                         {
                             drawable->draw(currentLayer->getCamera()->getViewProjection(),
-                                           transform,
+                                           drawTransform,
                                            drawColor,
                                            currentLayer->getRenderTarget(),
                                            std::static_pointer_cast<Node>(shared_from_this()));
@@ -161,10 +225,176 @@ namespace ouzel
             return false;
         }
 
+        void Node::invalidateDrawCommands()
+        {
+            if (cacheAsBitmap)
+            {
+                bitmapDirty = true;
+            }
+
+            invalidateParentDrawCommands();
+        }
+
+        void Node::invalidateParentDrawCommands()
+        {
+            if (NodeContainerPtr currentParent = parent.lock())
+            {
+                currentParent->invalidateDrawCommands();
+            }
+        }
+
+        void Node::setCacheAsBitmap(bool newCacheAsBitmap)
+        {
+            if (cacheAsBitmap != newCacheAsBitmap)
+            {
+                cacheAsBitmap = newCacheAsBitmap;
+                bitmapDirty = true;
+
+                if (!cacheAsBitmap)
+                {
+                    sharedEngine->getRenderer()->releaseRenderTarget(bitmapRenderTarget);
+                    bitmapRenderTarget.reset();
+                    bitmapFrame.reset();
+                    bitmapBoundingBox.reset();
+                }
+
+                // children are drawn by the layer again
+                for (const NodePtr& child : children)
+                {
+                    child->insideBitmap = cacheAsBitmap;
+                }
+
+                invalidateParentDrawCommands();
+            }
+        }
+
+        void Node::releaseBitmaps()
+        {
+            if (cacheAsBitmap && releaseBitmapOnLowMemory)
+            {
+                setCacheAsBitmap(false);
+            }
+
+            NodeContainer::releaseBitmaps();
+        }
+
+        void Node::calculateBitmapBoundingBox(const Matrix4& contentTransform, AABB2& result) const
+        {
+            for (const DrawablePtr& drawable : drawables)
+            {
+                if (drawable->isVisible() && !drawable->getBoundingBox().isEmpty())
+                {
+                    Vector2 corners[4];
+                    drawable->getBoundingBox().getCorners(corners);
+                    contentTransform.transformPoints(corners, corners, 4);
+
+                    for (const Vector2& corner : corners)
+                    {
+                        result.insertPoint(corner);
+                    }
+                }
+            }
+
+            for (const NodePtr& child : children)
+            {
+                if (child->isVisible())
+                {
+                    child->calculateBitmapBoundingBox(contentTransform * child->getLocalTransform(), result);
+                }
+            }
+        }
+
+        void Node::renderBitmap()
+        {
+            bitmapDirty = false;
+
+            AABB2 boundingBox;
+            calculateBitmapBoundingBox(Matrix4::IDENTITY, boundingBox);
+
+            if (boundingBox.isEmpty())
+            {
+                bitmapBoundingBox.reset();
+                bitmapFrame.reset();
+                return;
+            }
+
+            const graphics::RendererPtr& renderer = sharedEngine->getRenderer();
+            Size2 bitmapSize(ceilf(boundingBox.max.x - boundingBox.min.x), ceilf(boundingBox.max.y - boundingBox.min.y));
+
+            if (!bitmapRenderTarget ||
+                bitmapRenderTarget->getTexture()->getSize().width < bitmapSize.width ||
+                bitmapRenderTarget->getTexture()->getSize().height < bitmapSize.height)
+            {
+                renderer->releaseRenderTarget(bitmapRenderTarget);
+                bitmapRenderTarget = renderer->acquireRenderTarget(bitmapSize);
+                bitmapFrame.reset();
+
+                if (!bitmapRenderTarget)
+                {
+                    log("Failed to create render target for bitmap");
+                    return;
+                }
+            }
+
+            const Size2& renderTargetSize = bitmapRenderTarget->getTexture()->getSize();
+
+            Matrix4 projection;
+            Matrix4::createOrthographicOffCenter(boundingBox.min.x, boundingBox.min.x + renderTargetSize.width,
+                                                 boundingBox.min.y, boundingBox.min.y + renderTargetSize.height,
+                                                 -1.0f, 1.0f, projection);
+
+            // the color of the node is applied when the quad is drawn
+            drawToBitmap(projection, Matrix4::IDENTITY, graphics::Color(255, 255, 255, 255), bitmapRenderTarget);
+
+            if (!bitmapFrame || bitmapBoundingBox.min != boundingBox.min || bitmapBoundingBox.max != boundingBox.max)
+            {
+                // content is in the bottom left corner of the render target
+                bitmapFrame = std::make_shared<SpriteFrame>(Rectangle(0.0f, renderTargetSize.height - bitmapSize.height, bitmapSize.width, bitmapSize.height),
+                                                            bitmapRenderTarget->getTexture(), false, bitmapSize, Vector2(),
+                                                            Vector2(-boundingBox.min.x / bitmapSize.width, -boundingBox.min.y / bitmapSize.height));
+            }
+
+            bitmapBoundingBox = boundingBox;
+        }
+
+        void Node::drawToBitmap(const Matrix4& projectionMatrix, const Matrix4& contentTransform,
+                                const graphics::Color& drawColor, const graphics::RenderTargetPtr& renderTarget)
+        {
+            for (const DrawablePtr& drawable : drawables)
+            {
+                if (drawable->isVisible())
+                {
+                    drawable->draw(projectionMatrix,
+                                   contentTransform,
+                                   drawColor,
+                                   renderTarget,
+                                   std::static_pointer_cast<Node>(shared_from_this()));
+                }
+            }
+
+            std::vector<NodePtr> sortedChildren(children.begin(), children.end());
+
+            std::stable_sort(sortedChildren.begin(), sortedChildren.end(), [](const NodePtr& a, const NodePtr& b) {
+                return a->getZ() > b->getZ();
+            });
+
+            for (const NodePtr& child : sortedChildren)
+            {
+                if (child->isVisible())
+                {
+                    child->drawToBitmap(projectionMatrix, contentTransform * child->getLocalTransform(),
+                                        graphics::Color(child->color.r, child->color.g, child->color.b, static_cast<uint8_t>(child->color.a * child->opacity)),
+                                        renderTarget);
+                }
+            }
+        }
+
         void Node::setZ(float newZ)
         {
             z = newZ;
 
+            invalidateParentDrawCommands();
+
             // Currently z does not affect transformation
             //localTransformDirty = transformDirty = inverseTransformDirty = true;
         }
@@ -172,37 +402,53 @@ namespace ouzel
         void Node::setGlobalOrder(bool newGlobalOrder)
         {
             globalOrder = newGlobalOrder;
+
+            invalidateParentDrawCommands();
         }
 
         void Node::setPosition(const Vector2& newPosition)
         {
+            savePreviousTransform();
             position = newPosition;
 
             localTransformDirty = transformDirty = inverseTransformDirty = true;
+
+            invalidateParentDrawCommands();
         }
 
         void Node::setRotation(float newRotation)
         {
+            savePreviousTransform();
             rotation = newRotation;
 
             localTransformDirty = transformDirty = inverseTransformDirty = true;
+
+            invalidateParentDrawCommands();
         }
 
         void Node::setScale(const Vector2& newScale)
         {
+            savePreviousTransform();
             scale = newScale;
 
             localTransformDirty = transformDirty = inverseTransformDirty = true;
+
+            invalidateParentDrawCommands();
         }
 
         void Node::setColor(const graphics::Color& newColor)
         {
             color = newColor;
+
+            // the bitmap of the node doesn't depend on its color
+            invalidateParentDrawCommands();
         }
 
         void Node::setOpacity(float newOpacity)
         {
             opacity = clamp(newOpacity, 0.0f, 1.0f);
+
+            invalidateParentDrawCommands();
         }
 
         void Node::setFlipX(bool newFlipX)
@@ -210,6 +456,8 @@ namespace ouzel
             flipX = newFlipX;
 
             localTransformDirty = transformDirty = inverseTransformDirty = true;
+
+            invalidateParentDrawCommands();
         }
 
         void Node::setFlipY(bool newFlipY)
@@ -217,11 +465,15 @@ namespace ouzel
             flipY = newFlipY;
 
             localTransformDirty = transformDirty = inverseTransformDirty = true;
+
+            invalidateParentDrawCommands();
         }
 
         void Node::setVisible(bool newVisible)
         {
             visible = newVisible;
+
+            invalidateParentDrawCommands();
         }
 
         bool Node::pointOn(const Vector2& worldPosition) const
@@ -243,15 +495,11 @@ namespace ouzel
         {
             Matrix4 inverse = getInverseTransform();
 
-            std::vector<Vector2> transformedEdges;
+            std::vector<Vector2> transformedEdges(edges.size());
 
-            for (const Vector2& edge : edges)
+            if (!edges.empty())
             {
-                Vector3 transformedEdge = edge;
-
-                inverse.transformPoint(transformedEdge);
-
-                transformedEdges.push_back(Vector2(transformedEdge.x, transformedEdge.y));
+                inverse.transformPoints(edges.data(), transformedEdges.data(), static_cast<uint32_t>(edges.size()));
             }
 
             for (const DrawablePtr& drawable : drawables)
@@ -265,6 +513,16 @@ namespace ouzel
             return false;
         }
 
+        const Matrix4& Node::getLocalTransform() const
+        {
+            if (localTransformDirty)
+            {
+                calculateLocalTransform();
+            }
+
+            return localTransform;
+        }
+
         const Matrix4& Node::getTransform() const
         {
             if (transformDirty)
@@ -381,9 +639,54 @@ namespace ouzel
             inverseTransformDirty = false;
         }
 
+        void Node::savePreviousTransform()
+        {
+            uint64_t updateStep = sharedEngine->getUpdateStep();
+
+            if (transformStep != updateStep)
+            {
+                previousPosition = position;
+                previousRotation = rotation;
+                previousScale = scale;
+                transformStep = updateStep;
+            }
+        }
+
+        bool Node::calculateDrawTransform(const Matrix4& parentDrawTransform)
+        {
+            uint64_t updateStep = sharedEngine->getUpdateStep();
+
+            // only nodes changed in the last step move between the steps
+            if (updateStep == 0 || transformStep != updateStep)
+            {
+                drawTransform = parentDrawTransform * localTransform;
+                return false;
+            }
+
+            float interpolation = sharedEngine->getUpdateInterpolation();
+
+            Vector2 drawPosition = previousPosition + (position - previousPosition) * interpolation;
+            float drawRotation = previousRotation + (rotation - previousRotation) * interpolation;
+            Vector2 drawScale = previousScale + (scale - previousScale) * interpolation;
+
+            Matrix4 drawLocalTransform = Matrix4::IDENTITY;
+            drawLocalTransform.translate(Vector3(drawPosition.x, drawPosition.y, 0.0f));
+            drawLocalTransform.rotateZ(TAU - drawRotation);
+            drawLocalTransform.scale(Vector3(drawScale.x * (flipX ? -1.0f : 1.0f),
+                                             drawScale.y * (flipY ? -1.0f : 1.0f),
+                                             1.0f));
+
+            drawTransform = parentDrawTransform * drawLocalTransform;
+
+            return true;
+        }
+
         void Node::addDrawable(DrawablePtr drawable)
         {
             drawables.push_back(drawable);
+            drawable->node = this;
+
+            invalidateDrawCommands();
         }
 
         void Node::removeDrawable(uint32_t index)
@@ -393,7 +696,14 @@ namespace ouzel
                 return;
             }
 
+            if (drawables[index]->node == this)
+            {
+                drawables[index]->node = nullptr;
+            }
+
             drawables.erase(drawables.begin() + index);
+
+            invalidateDrawCommands();
         }
 
         void Node::removeDrawable(DrawablePtr drawable)
@@ -402,6 +712,11 @@ namespace ouzel
             {
                 if (*i == drawable)
                 {
+                    if (drawable->node == this)
+                    {
+                        drawable->node = nullptr;
+                    }
+
                     i = drawables.erase(i);
                 }
                 else
@@ -409,11 +724,23 @@ namespace ouzel
                     ++i;
                 }
             }
+
+            invalidateDrawCommands();
         }
 
         void Node::removeAllDrawables()
         {
+            for (const DrawablePtr& drawable : drawables)
+            {
+                if (drawable->node == this)
+                {
+                    drawable->node = nullptr;
+                }
+            }
+
             drawables.clear();
+
+            invalidateDrawCommands();
         }
 
     } // namespace scene
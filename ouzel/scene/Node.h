@@ -25,10 +25,19 @@ namespace ouzel
             friend NodeContainer;
             friend Layer;
         public:
+            // how drawables and animators of the node are updated while the node is not on screen
+            enum class UpdatePolicy
+            {
+                ALWAYS,
+                VISIBLE, // skip updates
+                FAST_FORWARD // skip updates and catch up with the skipped time when the node becomes visible
+            };
+
             Node();
             virtual ~Node();
 
-            virtual void visit(const Matrix4& newParentTransform, bool parentTransformDirty, const LayerPtr& currentLayer);
+            virtual void visit(const Matrix4& newParentTransform, const Matrix4& newParentDrawTransform,
+                               bool parentTransformDirty, const LayerPtr& currentLayer);
             virtual void process(const LayerPtr& currentLayer);
             virtual void draw(const LayerPtr& currentLayer);
 
@@ -37,6 +46,21 @@ namespace ouzel
             virtual NodeContainerPtr getParent() const { return parent.lock(); }
             virtual bool removeFromParent();
 
+            virtual void invalidateDrawCommands() override;
+
+            // draws the node with its children to a render target and then draws it as a single quad until something in the subtree changes,
+            // the color and opacity of the node tint the whole quad, so they can be animated without rendering the subtree again
+            void setCacheAsBitmap(bool newCacheAsBitmap);
+            bool isCacheAsBitmap() const { return cacheAsBitmap; }
+
+            // stop caching and release the bitmap when the system is low on memory
+            void setReleaseBitmapOnLowMemory(bool newReleaseBitmapOnLowMemory) { releaseBitmapOnLowMemory = newReleaseBitmapOnLowMemory; }
+            bool isReleaseBitmapOnLowMemory() const { return releaseBitmapOnLowMemory; }
+
+            const AABB2& getBitmapBoundingBox() const { return bitmapBoundingBox; }
+
+            virtual void releaseBitmaps() override;
+
             virtual void setZ(float newZ);
             virtual float getZ() const { return z; }
 
@@ -70,14 +94,23 @@ namespace ouzel
             virtual void setVisible(bool newVisible);
             virtual bool isVisible() const { return visible; }
 
+            // true if the node or any of its descendants passed culling in the last draw of its layer
+            bool isOnScreen() const { return onScreen; }
+
             virtual bool pointOn(const Vector2& worldPosition) const;
             virtual bool shapeOverlaps(const std::vector<Vector2>& edges) const;
 
+            // the transforms are calculated and cached on demand, so these methods (and the conversions below) must not be called from worker tasks,
+            // the plain getters above can be used by the tasks while the update thread waits for them
+            const Matrix4& getLocalTransform() const;
             virtual const Matrix4& getTransform() const;
             const Matrix4& getInverseTransform() const;
 
             virtual void updateTransform(const Matrix4& newParentTransform);
 
+            // transform the node is drawn with, interpolated between the last two fixed update steps if the engine uses them
+            const Matrix4& getDrawTransform() const { return drawTransform; }
+
             Vector2 convertWorldToLocal(const Vector2& worldPosition) const;
             Vector2 convertLocalToWorld(const Vector2& localPosition) const;
 
@@ -96,11 +129,21 @@ namespace ouzel
             void removeAllDrawables();
 
         protected:
+            virtual void invalidateParentDrawCommands();
+
+            void calculateBitmapBoundingBox(const Matrix4& contentTransform, AABB2& result) const;
+            void renderBitmap(); // called by the layer before the draw queue is split between threads
+            void drawToBitmap(const Matrix4& projectionMatrix, const Matrix4& contentTransform,
+                              const graphics::Color& drawColor, const graphics::RenderTargetPtr& renderTarget);
+
             virtual void calculateLocalTransform() const;
             virtual void calculateTransform() const;
 
             virtual void calculateInverseTransform() const;
 
+            void savePreviousTransform();
+            bool calculateDrawTransform(const Matrix4& parentDrawTransform); // returns true if the transform was interpolated
+
             Matrix4 parentTransform = Matrix4::IDENTITY;
             mutable Matrix4 transform;
             mutable bool transformDirty = true;
@@ -112,6 +155,13 @@ namespace ouzel
 
             mutable bool updateChildrenTransform = true;
 
+            Matrix4 drawTransform;
+            // values before the first change in the fixed update step transformStep
+            Vector2 previousPosition;
+            float previousRotation = 0.0f;
+            Vector2 previousScale = Vector2(1.0f, 1.0f);
+            uint64_t transformStep = 0;
+
             //TODO: transform to parent and transform to parent
 
             Vector2 position;
@@ -128,11 +178,20 @@ namespace ouzel
             bool pickable = true;
             bool visible = true;
             bool receiveInput = false;
+            bool onScreen = false;
 
             NodeContainerWeakPtr parent;
 
             AnimatorPtr currentAnimator;
             std::vector<DrawablePtr> drawables;
+
+            bool cacheAsBitmap = false;
+            bool releaseBitmapOnLowMemory = true;
+            bool bitmapDirty = true;
+            bool insideBitmap = false; // drawn by an ancestor's bitmap
+            AABB2 bitmapBoundingBox;
+            graphics::RenderTargetPtr bitmapRenderTarget;
+            SpriteFramePtr bitmapFrame;
         };
     } // namespace scene
 } // namespace ouzel
@@ -29,6 +29,8 @@ namespace ouzel
                 node->parent = shared_from_this();
                 children.push_back(node);
 
+                invalidateDrawCommands();
+
                 return true;
             }
             else
@@ -46,6 +48,8 @@ namespace ouzel
                 node->parent.reset();
                 children.erase(i);
 
+                invalidateDrawCommands();
+
                 return true;
             }
             else
@@ -64,6 +68,16 @@ namespace ouzel
             }
 
             children.clear();
+
+            invalidateDrawCommands();
+        }
+
+        void NodeContainer::releaseBitmaps()
+        {
+            for (const NodePtr& node : children)
+            {
+                node->releaseBitmaps();
+            }
         }
 
         bool NodeContainer::hasChild(const NodePtr& node, bool recursive) const
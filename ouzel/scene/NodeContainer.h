@@ -27,6 +27,12 @@ namespace ouzel
             virtual bool hasChild(const NodePtr& node, bool recursive = false) const;
             virtual const std::list<NodePtr>& getChildren() const { return children; }
 
+            // called when something that affects the generated draw commands changes
+            virtual void invalidateDrawCommands() {}
+
+            // releases cached bitmaps of nodes that allow it, called when the system is low on memory
+            virtual void releaseBitmaps();
+
         protected:
             std::list<NodePtr> children;
         };
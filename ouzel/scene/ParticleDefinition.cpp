@@ -13,6 +13,8 @@ namespace ouzel
 {
     namespace scene
     {
+        const uint32_t ParticleDefinition::MAX_PARTICLES;
+
         ParticleDefinitionPtr ParticleDefinition::loadParticleDefinition(const std::string& filename)
         {
             ParticleDefinitionPtr result = std::make_shared<scene::ParticleDefinition>();
@@ -50,6 +52,12 @@ namespace ouzel
 
             if (document.HasMember("maxParticles")) result->maxParticles = document["maxParticles"].GetUint();
 
+            if (result->maxParticles > MAX_PARTICLES)
+            {
+                log("Particle count of %s limited to %u", filename.c_str(), MAX_PARTICLES);
+                result->maxParticles = MAX_PARTICLES;
+            }
+
             if (document.HasMember("duration")) result->duration = document["duration"].GetFloat();
             if (document.HasMember("particleLifespan")) result->particleLifespan = document["particleLifespan"].GetFloat();
             if (document.HasMember("particleLifespanVariance")) result->particleLifespanVariance = document["particleLifespanVariance"].GetFloat();
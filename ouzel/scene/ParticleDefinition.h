@@ -15,6 +15,9 @@ namespace ouzel
         {
             static ParticleDefinitionPtr loadParticleDefinition(const std::string& filename);
 
+            // particle meshes use 16-bit indices
+            static const uint32_t MAX_PARTICLES = 16384;
+
             enum class EmitterType
             {
                 GRAVITY,
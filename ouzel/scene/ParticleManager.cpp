@@ -0,0 +1,120 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include "ParticleManager.h"
+#include "ParticleSystem.h"
+#include "core/Engine.h"
+#include "core/WorkerPool.h"
+
+namespace ouzel
+{
+    namespace scene
+    {
+        // number of tasks per worker thread, more tasks balance uneven emitters better
+        static const uint32_t TASKS_PER_THREAD = 4;
+
+        ParticleManager::ParticleManager()
+        {
+            updateCallback.callback = std::bind(&ParticleManager::update, this, std::placeholders::_1);
+            updateCallback.name = "ParticleManager";
+        }
+
+        ParticleManager::~ParticleManager()
+        {
+            sharedEngine->unscheduleUpdate(updateCallback);
+        }
+
+        void ParticleManager::addParticleSystem(ParticleSystem* particleSystem)
+        {
+            std::vector<ParticleSystem*>::iterator i = std::find(particleSystems.begin(), particleSystems.end(), particleSystem);
+
+            if (i == particleSystems.end())
+            {
+                if (particleSystems.empty())
+                {
+                    sharedEngine->scheduleUpdate(updateCallback);
+                }
+
+                particleSystems.push_back(particleSystem);
+            }
+        }
+
+        void ParticleManager::removeParticleSystem(ParticleSystem* particleSystem)
+        {
+            std::vector<ParticleSystem*>::iterator i = std::find(particleSystems.begin(), particleSystems.end(), particleSystem);
+
+            if (i != particleSystems.end())
+            {
+                // the list is compacted after the update
+                if (updating)
+                {
+                    *i = nullptr;
+                }
+                else
+                {
+                    particleSystems.erase(i);
+
+                    if (particleSystems.empty())
+                    {
+                        sharedEngine->unscheduleUpdate(updateCallback);
+                    }
+                }
+            }
+        }
+
+        void ParticleManager::update(float delta)
+        {
+            updating = true;
+
+            // systems added by finish handlers are updated in the next frame
+            size_t count = particleSystems.size();
+
+            const WorkerPoolPtr& workerPool = sharedEngine->getWorkerPool();
+            size_t taskCount = std::min(count, static_cast<size_t>(workerPool->getThreadCount() * TASKS_PER_THREAD));
+
+            // node transforms are calculated lazily, so they are resolved here and not by the tasks
+            for (size_t i = 0; i < count; ++i)
+            {
+                particleSystems[i]->updateParentTransform();
+            }
+
+            tasks.clear();
+
+            for (size_t task = 0; task < taskCount; ++task)
+            {
+                size_t first = count * task / taskCount;
+                size_t last = count * (task + 1) / taskCount;
+
+                tasks.push_back([this, first, last, delta]() {
+                    for (size_t i = first; i < last; ++i)
+                    {
+                        particleSystems[i]->updateParticles(delta);
+                    }
+                });
+            }
+
+            workerPool->run(tasks);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                // the system can be destroyed by a finish handler of another system
+                if (ParticleSystem* particleSystem = particleSystems[i])
+                {
+                    particleSystem->finishUpdate();
+                }
+            }
+
+            updating = false;
+
+            particleSystems.erase(std::remove_if(particleSystems.begin(), particleSystems.end(), [](ParticleSystem* particleSystem) {
+                return !particleSystem || !particleSystem->isActive();
+            }), particleSystems.end());
+
+            if (particleSystems.empty())
+            {
+                sharedEngine->unscheduleUpdate(updateCallback);
+            }
+        }
+    } // namespace scene
+} // namespace ouzel
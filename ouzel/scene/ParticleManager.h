@@ -0,0 +1,47 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <vector>
+#include <functional>
+#include "utils/Noncopyable.h"
+#include "core/UpdateCallback.h"
+
+namespace ouzel
+{
+    class Engine;
+
+    namespace scene
+    {
+        class ParticleSystem;
+
+        /**
+         * Updates all active particle systems in parallel on the worker pool.
+         * The transforms of the parent nodes are resolved on the update thread before the tasks start,
+         * finish handlers and removal of finished systems happen afterwards on the update thread.
+         */
+        class ParticleManager: public Noncopyable
+        {
+            friend Engine;
+        public:
+            virtual ~ParticleManager();
+
+            void addParticleSystem(ParticleSystem* particleSystem);
+            void removeParticleSystem(ParticleSystem* particleSystem);
+
+            uint32_t getParticleSystemCount() const { return static_cast<uint32_t>(particleSystems.size()); }
+
+        protected:
+            ParticleManager();
+
+            void update(float delta);
+
+            std::vector<ParticleSystem*> particleSystems;
+            std::vector<std::function<void()>> tasks;
+            bool updating = false;
+
+            UpdateCallback updateCallback;
+        };
+    } // namespace scene
+} // namespace ouzel
@@ -2,10 +2,14 @@
 // This file is part of the Ouzel engine.
 
 #include <cstdlib>
+#include <algorithm>
+#include <map>
+#include <mutex>
 #include "core/CompileConfig.h"
 #include "ParticleSystem.h"
 #include "core/Engine.h"
 #include "SceneManager.h"
+#include "ParticleManager.h"
 #include "files/FileSystem.h"
 #include "core/Cache.h"
 #include "Layer.h"
@@ -13,17 +17,232 @@
 #include "graphics/MeshBuffer.h"
 #include "utils/Utils.h"
 #include "math/MathUtils.h"
+#include "math/SIMD.h"
 
 namespace ouzel
 {
     namespace scene
     {
-        ParticleSystem::ParticleSystem()
+        // the time skipped while fast forwarding is simulated in steps of this length
+        static const float FAST_FORWARD_STEP = 1.0f / 30.0f;
+
+        // upper bound of random values used to emit one particle
+        static const uint32_t RANDOM_VALUES_PER_PARTICLE = 19;
+
+        ParticleData::ParticleData()
+        {
+            std::fill(std::begin(attributes), std::end(attributes), nullptr);
+        }
+
+        void ParticleData::resize(uint32_t newCapacity)
+        {
+            // round up to the SIMD width
+            newCapacity = (newCapacity + 3) & ~3u;
+
+            if (newCapacity == capacity)
+            {
+                return;
+            }
+
+            // three extra floats to align the first array to 16 bytes
+            std::vector<float> newStorage(newCapacity * ATTRIBUTE_COUNT + 3, 0.0f);
+            float* base = newStorage.data();
+            base += (4 - (reinterpret_cast<uintptr_t>(base) / sizeof(float)) % 4) % 4;
+
+            for (uint32_t attribute = 0; attribute < ATTRIBUTE_COUNT; ++attribute)
+            {
+                float* newAttribute = base + attribute * newCapacity;
+
+                if (attributes[attribute])
+                {
+                    std::copy(attributes[attribute], attributes[attribute] + std::min(capacity, newCapacity), newAttribute);
+                }
+
+                attributes[attribute] = newAttribute;
+            }
+
+            storage.swap(newStorage);
+            capacity = newCapacity;
+        }
+
+        void ParticleData::move(uint32_t from, uint32_t to)
+        {
+            for (float* attribute : attributes)
+            {
+                attribute[to] = attribute[from];
+            }
+        }
+
+        static void updateGravityParticles(ParticleData& particles, uint32_t count, float delta, const Vector2& gravity, float yCoordFlipped)
+        {
+            float* positionX = particles.get(ParticleData::POSITION_X);
+            float* positionY = particles.get(ParticleData::POSITION_Y);
+            float* directionX = particles.get(ParticleData::DIRECTION_X);
+            float* directionY = particles.get(ParticleData::DIRECTION_Y);
+            const float* radialAcceleration = particles.get(ParticleData::RADIAL_ACCELERATION);
+            const float* tangentialAcceleration = particles.get(ParticleData::TANGENTIAL_ACCELERATION);
+
+            const simd::Float4 zero = simd::set(0.0f);
+            const simd::Float4 one = simd::set(1.0f);
+            const simd::Float4 tolerance = simd::set(TOLERANCE * TOLERANCE);
+            const simd::Float4 gravityX = simd::set(gravity.x);
+            const simd::Float4 gravityY = simd::set(gravity.y);
+            const simd::Float4 deltaV = simd::set(delta);
+            const simd::Float4 positionDelta = simd::set(delta * yCoordFlipped);
+
+            for (uint32_t i = 0; i < count; i += 4)
+            {
+                simd::Float4 x = simd::load(positionX + i);
+                simd::Float4 y = simd::load(positionY + i);
+
+                // radial direction, it is only used if one of the coordinates is zero (matches the scalar implementation)
+                simd::Float4 lengthSquared = simd::add(simd::mul(x, x), simd::mul(y, y));
+                simd::Mask4 normalize = simd::maskOr(simd::equal(x, zero), simd::equal(y, zero));
+                simd::Mask4 longEnough = simd::maskAnd(normalize, simd::less(tolerance, lengthSquared));
+                simd::Float4 scale = simd::select(longEnough, simd::reciprocalSqrt(lengthSquared), one);
+                simd::Float4 radialX = simd::select(normalize, simd::mul(x, scale), zero);
+                simd::Float4 radialY = simd::select(normalize, simd::mul(y, scale), zero);
+
+                simd::Float4 radial = simd::load(radialAcceleration + i);
+                simd::Float4 tangential = simd::load(tangentialAcceleration + i);
+
+                // (gravity + radial + tangential) * delta
+                simd::Float4 accelerationX = simd::add(simd::sub(simd::mul(radialX, radial), simd::mul(radialY, tangential)), gravityX);
+                simd::Float4 accelerationY = simd::add(simd::add(simd::mul(radialY, radial), simd::mul(radialX, tangential)), gravityY);
+
+                simd::Float4 dirX = simd::add(simd::load(directionX + i), simd::mul(accelerationX, deltaV));
+                simd::Float4 dirY = simd::add(simd::load(directionY + i), simd::mul(accelerationY, deltaV));
+
+                simd::store(directionX + i, dirX);
+                simd::store(directionY + i, dirY);
+                simd::store(positionX + i, simd::add(x, simd::mul(dirX, positionDelta)));
+                simd::store(positionY + i, simd::add(y, simd::mul(dirY, positionDelta)));
+            }
+        }
+
+        static void updateRadiusParticles(ParticleData& particles, uint32_t count, float delta, float yCoordFlipped)
+        {
+            float* positionX = particles.get(ParticleData::POSITION_X);
+            float* positionY = particles.get(ParticleData::POSITION_Y);
+            float* angle = particles.get(ParticleData::ANGLE);
+            float* radius = particles.get(ParticleData::RADIUS);
+            const float* degreesPerSecond = particles.get(ParticleData::DEGREES_PER_SECOND);
+            const float* deltaRadius = particles.get(ParticleData::DELTA_RADIUS);
+
+            const simd::Float4 zero = simd::set(0.0f);
+            const simd::Float4 deltaV = simd::set(delta);
+            const simd::Float4 flip = simd::set(yCoordFlipped);
+
+            for (uint32_t i = 0; i < count; i += 4)
+            {
+                simd::Float4 a = simd::add(simd::load(angle + i), simd::mul(simd::load(degreesPerSecond + i), deltaV));
+                simd::Float4 r = simd::add(simd::load(radius + i), simd::mul(simd::load(deltaRadius + i), deltaV));
+
+                simd::Float4 sinA;
+                simd::Float4 cosA;
+                simd::sinCos(a, sinA, cosA);
+
+                simd::store(angle + i, a);
+                simd::store(radius + i, r);
+                simd::store(positionX + i, simd::sub(zero, simd::mul(cosA, r)));
+                simd::store(positionY + i, simd::sub(zero, simd::mul(simd::mul(sinA, r), flip)));
+            }
+        }
+
+        static void updateParticleAttributes(ParticleData& particles, uint32_t count, float delta)
+        {
+            static const ParticleData::Attribute linear[][2] = {
+                { ParticleData::COLOR_RED, ParticleData::DELTA_COLOR_RED },
+                { ParticleData::COLOR_GREEN, ParticleData::DELTA_COLOR_GREEN },
+                { ParticleData::COLOR_BLUE, ParticleData::DELTA_COLOR_BLUE },
+                { ParticleData::COLOR_ALPHA, ParticleData::DELTA_COLOR_ALPHA },
+                { ParticleData::ROTATION, ParticleData::DELTA_ROTATION }
+            };
+
+            const simd::Float4 zero = simd::set(0.0f);
+            const simd::Float4 deltaV = simd::set(delta);
+
+            for (const auto& attribute : linear)
+            {
+                float* value = particles.get(attribute[0]);
+                const float* valueDelta = particles.get(attribute[1]);
+
+                for (uint32_t i = 0; i < count; i += 4)
+                {
+                    simd::store(value + i, simd::add(simd::load(value + i), simd::mul(simd::load(valueDelta + i), deltaV)));
+                }
+            }
+
+            float* size = particles.get(ParticleData::SIZE);
+            const float* deltaSize = particles.get(ParticleData::DELTA_SIZE);
+
+            for (uint32_t i = 0; i < count; i += 4)
+            {
+                simd::store(size + i, simd::max(zero, simd::add(simd::load(size + i), simd::mul(simd::load(deltaSize + i), deltaV))));
+            }
+        }
+
+        static void calculateParticleBounds(const ParticleData& particles, uint32_t count, const Matrix4& transform, AABB2& result)
+        {
+            const float* positionX = particles.get(ParticleData::POSITION_X);
+            const float* positionY = particles.get(ParticleData::POSITION_Y);
+
+            const simd::Float4 m0 = simd::set(transform.m[0]);
+            const simd::Float4 m1 = simd::set(transform.m[1]);
+            const simd::Float4 m4 = simd::set(transform.m[4]);
+            const simd::Float4 m5 = simd::set(transform.m[5]);
+            const simd::Float4 m12 = simd::set(transform.m[12]);
+            const simd::Float4 m13 = simd::set(transform.m[13]);
+
+            simd::Float4 minX = simd::set(result.min.x);
+            simd::Float4 minY = simd::set(result.min.y);
+            simd::Float4 maxX = simd::set(result.max.x);
+            simd::Float4 maxY = simd::set(result.max.y);
+
+            // the padding after the last particle holds stale data, so only full groups of four are vectorized
+            uint32_t vectorCount = count & ~3u;
+
+            for (uint32_t i = 0; i < vectorCount; i += 4)
+            {
+                simd::Float4 x = simd::load(positionX + i);
+                simd::Float4 y = simd::load(positionY + i);
+
+                simd::Float4 tx = simd::add(simd::add(simd::mul(x, m0), simd::mul(y, m4)), m12);
+                simd::Float4 ty = simd::add(simd::add(simd::mul(x, m1), simd::mul(y, m5)), m13);
+
+                minX = simd::min(minX, tx);
+                minY = simd::min(minY, ty);
+                maxX = simd::max(maxX, tx);
+                maxY = simd::max(maxY, ty);
+            }
+
+            alignas(16) float bounds[4][4];
+            simd::store(bounds[0], minX);
+            simd::store(bounds[1], minY);
+            simd::store(bounds[2], maxX);
+            simd::store(bounds[3], maxY);
+
+            for (uint32_t lane = 0; lane < 4; ++lane)
+            {
+                result.min.x = std::min(result.min.x, bounds[0][lane]);
+                result.min.y = std::min(result.min.y, bounds[1][lane]);
+                result.max.x = std::max(result.max.x, bounds[2][lane]);
+                result.max.y = std::max(result.max.y, bounds[3][lane]);
+            }
+
+            for (uint32_t i = vectorCount; i < count; ++i)
+            {
+                Vector2 position(positionX[i], positionY[i]);
+                transform.transformPoints(&position, &position, 1);
+                result.insertPoint(position);
+            }
+        }
+
+        ParticleSystem::ParticleSystem():
+            randomGenerator(Random::getThreadInstance().next64())
         {
             shader = sharedEngine->getCache()->getShader(graphics::SHADER_TEXTURE);
             blendState = sharedEngine->getCache()->getBlendState(graphics::BLEND_ALPHA);
-
-            updateCallback.callback = std::bind(&ParticleSystem::update, this, std::placeholders::_1);
         }
 
         ParticleSystem::ParticleSystem(const std::string& filename):
@@ -32,9 +251,18 @@ namespace ouzel
             initFromFile(filename);
         }
 
+        ParticleSystem::ParticleSystem(const ParticleDefinitionPtr& newParticleDefinition):
+            ParticleSystem()
+        {
+            if (initFromDefinition(newParticleDefinition))
+            {
+                resume();
+            }
+        }
+
         ParticleSystem::~ParticleSystem()
         {
-            sharedEngine->unscheduleUpdate(updateCallback);
+            sharedEngine->getParticleManager()->removeParticleSystem(this);
         }
 
         void ParticleSystem::draw(const Matrix4& projectionMatrix,
@@ -89,25 +317,104 @@ namespace ouzel
 
         void ParticleSystem::update(float delta)
         {
-            if (running && particleDefinition.emissionRate > 0.0f)
+            updateParentTransform();
+            updateParticles(delta);
+            finishUpdate();
+        }
+
+        void ParticleSystem::updateParentTransform()
+        {
+            if (NodePtr parent = parentNode.lock())
+            {
+                hasParent = true;
+                parentPosition = parent->getPosition();
+                parentWorldPosition = parent->convertLocalToWorld(Vector2::ZERO);
+                parentInverseTransform = parent->getInverseTransform();
+            }
+            else
+            {
+                hasParent = false;
+            }
+        }
+
+        void ParticleSystem::updateParticles(float delta)
+        {
+            // only set while the node is off screen with the FAST_FORWARD policy
+            float skipped = skippedTime;
+
+            if (!particleDefinition || !applyUpdatePolicy(delta))
+            {
+                return;
+            }
+
+            if (skipped <= 0.0f)
+            {
+                simulate(delta);
+            }
+            else
+            {
+                float maxLifespan = particleDefinition->particleLifespan + particleDefinition->particleLifespanVariance;
+
+                // all the current particles and the ones emitted before the last lifespan would have already died
+                if (delta > maxLifespan + FAST_FORWARD_STEP)
+                {
+                    particleCount = 0;
+                    emitCounter = 0.0f;
+                    elapsed += delta - maxLifespan;
+                    delta = maxLifespan;
+                }
+
+                while (delta > 0.0f)
+                {
+                    float step = std::min(delta, FAST_FORWARD_STEP);
+                    simulate(step);
+                    delta -= step;
+                }
+            }
+
+            // generate the vertices during the (parallel) update, so that draw only has to issue the draw command
+            if (needsMeshUpdate && updateParticleMesh())
+            {
+                needsMeshUpdate = false;
+            }
+        }
+
+        void ParticleSystem::finishUpdate()
+        {
+            if (drawCommandsChanged)
+            {
+                drawCommandsChanged = false;
+                invalidateDrawCommands();
+            }
+
+            if (finishPending)
+            {
+                finishPending = false;
+                if (finishHandler) finishHandler();
+            }
+        }
+
+        void ParticleSystem::simulate(float delta)
+        {
+            if (running && particleDefinition->emissionRate > 0.0f)
             {
-                float rate = 1.0f / particleDefinition.emissionRate;
+                float rate = 1.0f / particleDefinition->emissionRate;
 
-                if (particleCount < particleDefinition.maxParticles)
+                if (particleCount < maxParticles)
                 {
                     emitCounter += delta;
                     if (emitCounter < 0.f)
                         emitCounter = 0.f;
                 }
 
-                uint32_t emitCount = static_cast<uint32_t>(std::min(static_cast<float>(particleDefinition.maxParticles - particleCount), emitCounter / rate));
+                uint32_t emitCount = static_cast<uint32_t>(std::min(static_cast<float>(maxParticles - particleCount), emitCounter / rate));
                 emitParticles(emitCount);
                 emitCounter -= rate * emitCount;
 
                 elapsed += delta;
                 if (elapsed < 0.f)
                     elapsed = 0.f;
-                if (particleDefinition.duration >= 0.0f && particleDefinition.duration < elapsed)
+                if (particleDefinition->duration >= 0.0f && particleDefinition->duration < elapsed)
                 {
                     finished = true;
                     stop();
@@ -115,112 +422,57 @@ namespace ouzel
             }
             else if (active && !particleCount)
             {
+                // the particle manager removes inactive systems after the update
                 active = false;
-                sharedEngine->unscheduleUpdate(updateCallback);
-                if (finishHandler) finishHandler();
+                drawCommandsChanged = true;
+                finishPending = true;
             }
 
             if (active)
             {
+                float* life = particles.get(ParticleData::LIFE);
+
                 for (uint32_t counter = particleCount; counter > 0; --counter)
                 {
-                    size_t i = counter - 1;
+                    uint32_t i = counter - 1;
 
-                    particles[i].life -= delta;
+                    life[i] -= delta;
 
-                    if (particles[i].life >= 0.0f)
+                    if (life[i] < 0.0f)
                     {
-                        if (particleDefinition.emitterType == ParticleDefinition::EmitterType::GRAVITY)
-                        {
-                            Vector2 tmp, radial, tangential;
-
-                            // radial acceleration
-                            if (particles[i].position.x == 0.0f || particles[i].position.y == 0.0f)
-                            {
-                                radial = particles[i].position;
-                                radial.normalize();
-                            }
-                            tangential = radial;
-                            radial.x *= particles[i].radialAcceleration;
-                            radial.y *= particles[i].radialAcceleration;
-
-                            // tangential acceleration
-                            std::swap(tangential.x, tangential.y);
-                            tangential.x *= - particles[i].tangentialAcceleration;
-                            tangential.y *= particles[i].tangentialAcceleration;
-
-                            // (gravity + radial + tangential) * delta
-                            tmp.x = radial.x + tangential.x + particleDefinition.gravity.x;
-                            tmp.y = radial.y + tangential.y + particleDefinition.gravity.y;
-                            tmp.x *= delta;
-                            tmp.y *= delta;
-
-                            particles[i].direction.x += tmp.x;
-                            particles[i].direction.y += tmp.y;
-
-                            // this is cocos2d-x v3.0
-                            // if (configName.length()>0 && yCoordFlipped != -1)
-
-                            // this is cocos2d-x v3.0
-                            tmp.x = particles[i].direction.x * delta * particleDefinition.yCoordFlipped;
-                            tmp.y = particles[i].direction.y * delta * particleDefinition.yCoordFlipped;
-                            particles[i].position.x += tmp.x;
-                            particles[i].position.y += tmp.y;
-                        }
-                        else
-                        {
-                            particles[i].angle += particles[i].degreesPerSecond * delta;
-                            particles[i].radius += particles[i].deltaRadius * delta;
-                            particles[i].position.x = -cosf(particles[i].angle) * particles[i].radius;
-                            particles[i].position.y = -sinf(particles[i].angle) * particles[i].radius * particleDefinition.yCoordFlipped;
-                        }
-
-                        //color r,g,b,a
-                        particles[i].colorRed += particles[i].deltaColorRed * delta;
-                        particles[i].colorGreen += particles[i].deltaColorGreen * delta;
-                        particles[i].colorBlue += particles[i].deltaColorBlue * delta;
-                        particles[i].colorAlpha += particles[i].deltaColorAlpha * delta;
-
-                        //size
-                        particles[i].size += (particles[i].deltaSize * delta);
-                        particles[i].size = std::max(0.0f, particles[i].size);
-
-                        //angle
-                        particles[i].rotation += particles[i].deltaRotation * delta;
-                    }
-                    else
-                    {
-                        particles[i] = particles[particleCount - 1];
+                        particles.move(particleCount - 1, i);
                         particleCount--;
                     }
                 }
 
+                if (particleDefinition->emitterType == ParticleDefinition::EmitterType::GRAVITY)
+                {
+                    updateGravityParticles(particles, particleCount, delta, particleDefinition->gravity, particleDefinition->yCoordFlipped);
+                }
+                else
+                {
+                    updateRadiusParticles(particles, particleCount, delta, particleDefinition->yCoordFlipped);
+                }
+
+                updateParticleAttributes(particles, particleCount, delta);
+
                 // Update bounding box
                 boundingBox.reset();
 
                 if (positionType == ParticleDefinition::PositionType::FREE || positionType == ParticleDefinition::PositionType::RELATIVE)
                 {
-                    if (NodePtr parent = parentNode.lock())
+                    if (hasParent)
                     {
-                        const Matrix4& inverseTransform = parent->getInverseTransform();
-
-                        for (uint32_t i = 0; i < particleCount; i++)
-                        {
-                            Vector3 position = particles[i].position;
-                            inverseTransform.transformPoint(position);
-                            boundingBox.insertPoint(Vector2(position.x, position.y));
-                        }
+                        calculateParticleBounds(particles, particleCount, parentInverseTransform, boundingBox);
                     }
                 }
-                else if (particleDefinition.positionType == ParticleDefinition::PositionType::GROUPED)
+                else if (particleDefinition->positionType == ParticleDefinition::PositionType::GROUPED)
                 {
-                    for (uint32_t i = 0; i < particleCount; i++)
-                    {
-                        boundingBox.insertPoint(particles[i].position);
-                    }
+                    calculateParticleBounds(particles, particleCount, Matrix4::IDENTITY, boundingBox);
                 }
 
                 needsMeshUpdate = true;
+                drawCommandsChanged = true;
             }
         }
 
@@ -228,24 +480,43 @@ namespace ouzel
         {
             ParticleDefinitionPtr newParticleDefinition = sharedEngine->getCache()->getParticleDefinition(filename);
 
+            if (!newParticleDefinition || !initFromDefinition(newParticleDefinition))
+            {
+                return false;
+            }
+
+            resume();
+
+            return true;
+        }
+
+        bool ParticleSystem::initFromDefinition(const ParticleDefinitionPtr& newParticleDefinition)
+        {
             if (!newParticleDefinition)
             {
                 return false;
             }
 
-            particleDefinition = *newParticleDefinition;
-            positionType = particleDefinition.positionType;
-            texture = sharedEngine->getCache()->getTexture(particleDefinition.textureFilename);
+            particleDefinition = newParticleDefinition;
+            positionType = particleDefinition->positionType;
+
+            // definitions created in code are not limited by the loader
+            maxParticles = std::min(particleDefinition->maxParticles, ParticleDefinition::MAX_PARTICLES);
+
+            if (maxParticles < particleDefinition->maxParticles)
+            {
+                log("Particle count limited to %u", ParticleDefinition::MAX_PARTICLES);
+            }
+            texture = sharedEngine->getCache()->getTexture(particleDefinition->textureFilename);
 
             if (!texture)
             {
                 return false;
             }
 
-            createParticleMesh();
-            resume();
+            particleCount = 0;
 
-            return true;
+            return createParticleMesh();
         }
 
         void ParticleSystem::resume()
@@ -258,7 +529,7 @@ namespace ouzel
                 if (!active)
                 {
                     active = true;
-                    sharedEngine->scheduleUpdate(updateCallback);
+                    sharedEngine->getParticleManager()->addParticleSystem(this);
                 }
             }
         }
@@ -268,194 +539,350 @@ namespace ouzel
             running = false;
         }
 
+        void ParticleSystem::deactivate()
+        {
+            running = false;
+
+            if (active)
+            {
+                active = false;
+                sharedEngine->getParticleManager()->removeParticleSystem(this);
+            }
+        }
+
+        void ParticleSystem::setRandomSeed(uint64_t seed)
+        {
+            randomSeed = seed;
+            hasRandomSeed = true;
+            randomGenerator.seed(randomSeed);
+        }
+
         void ParticleSystem::reset()
         {
+            if (hasRandomSeed)
+            {
+                randomGenerator.seed(randomSeed);
+            }
+
             emitCounter = 0.0f;
             elapsed = 0.0f;
             particleCount = 0;
             finished = false;
+
+            invalidateDrawCommands();
         }
 
-        bool ParticleSystem::createParticleMesh()
+        static graphics::MeshBufferPtr getParticleIndexBuffer(uint32_t maxParticles)
         {
-            indices.reserve(particleDefinition.maxParticles * 6);
-            vertices.reserve(particleDefinition.maxParticles * 4);
+            // one index buffer per power of two of the particle count, shared by all particle systems
+            static std::mutex indexBufferMutex;
+            static std::map<uint32_t, std::weak_ptr<graphics::MeshBuffer>> indexBuffers;
+
+            uint32_t bucket = 64;
+
+            while (bucket < maxParticles)
+            {
+                bucket *= 2;
+            }
+
+            bucket = std::min(bucket, ParticleDefinition::MAX_PARTICLES);
+
+            std::lock_guard<std::mutex> lock(indexBufferMutex);
+
+            graphics::MeshBufferPtr indexBuffer = indexBuffers[bucket].lock();
 
-            for (uint16_t i = 0; i < particleDefinition.maxParticles; ++i)
+            if (!indexBuffer)
             {
-                indices.push_back(i * 4 + 0);
-                indices.push_back(i * 4 + 1);
-                indices.push_back(i * 4 + 2);
-                indices.push_back(i * 4 + 1);
-                indices.push_back(i * 4 + 3);
-                indices.push_back(i * 4 + 2);
+                std::vector<uint16_t> indices;
+                indices.reserve(bucket * 6);
+
+                for (uint32_t i = 0; i < bucket; ++i)
+                {
+                    indices.push_back(static_cast<uint16_t>(i * 4 + 0));
+                    indices.push_back(static_cast<uint16_t>(i * 4 + 1));
+                    indices.push_back(static_cast<uint16_t>(i * 4 + 2));
+                    indices.push_back(static_cast<uint16_t>(i * 4 + 1));
+                    indices.push_back(static_cast<uint16_t>(i * 4 + 3));
+                    indices.push_back(static_cast<uint16_t>(i * 4 + 2));
+                }
 
-                vertices.push_back(graphics::VertexPCT(Vector3(-1.0f, -1.0f, 0.0f), graphics::Color(255, 255, 255, 255), Vector2(0.0f, 1.0f)));
-                vertices.push_back(graphics::VertexPCT(Vector3(1.0f, -1.0f, 0.0f), graphics::Color(255, 255, 255, 255), Vector2(1.0f, 1.0f)));
-                vertices.push_back(graphics::VertexPCT(Vector3(-1.0f, 1.0f, 0.0f),  graphics::Color(255, 255, 255, 255), Vector2(0.0f, 0.0f)));
-                vertices.push_back(graphics::VertexPCT(Vector3(1.0f, 1.0f, 0.0f),  graphics::Color(255, 255, 255, 255), Vector2(1.0f, 0.0f)));
+                indexBuffer = sharedEngine->getRenderer()->createMeshBuffer();
+
+                if (!indexBuffer->initFromBuffer(indices.data(), sizeof(uint16_t),
+                                                 static_cast<uint32_t>(indices.size()), false,
+                                                 nullptr, graphics::VertexPCT::ATTRIBUTES,
+                                                 0, false))
+                {
+                    return nullptr;
+                }
+
+                indexBuffers[bucket] = indexBuffer;
+            }
+
+            return indexBuffer;
+        }
+
+        bool ParticleSystem::createParticleMesh()
+        {
+            graphics::MeshBufferPtr indexBuffer = getParticleIndexBuffer(maxParticles);
+
+            if (!indexBuffer)
+            {
+                return false;
             }
 
+            // particle and vertex storage grows on demand in emitParticles
+            particles.resize(0);
+            vertices.clear();
+
             mesh = sharedEngine->getRenderer()->createMeshBuffer();
 
-            mesh->initFromBuffer(indices.data(), sizeof(uint16_t),
-                                 static_cast<uint32_t>(indices.size()), false,
-                                 vertices.data(), graphics::VertexPCT::ATTRIBUTES,
-                                 static_cast<uint32_t>(vertices.size()), true);
+            return mesh->initFromBuffer(indexBuffer, nullptr, graphics::VertexPCT::ATTRIBUTES, 0, true);
+        }
 
-            particles.resize(particleDefinition.maxParticles);
+        void ParticleSystem::reserveParticles(uint32_t count)
+        {
+            uint32_t capacity = particles.getCapacity();
 
-            return true;
+            if (count > capacity)
+            {
+                particles.resize(std::min(maxParticles, std::max(count, capacity * 2)));
+
+                size_t oldSize = vertices.size();
+                vertices.resize(particles.getCapacity() * 4);
+
+                for (size_t i = oldSize; i < vertices.size(); i += 4)
+                {
+                    vertices[i + 0].texCoord = Vector2(0.0f, 1.0f);
+                    vertices[i + 1].texCoord = Vector2(1.0f, 1.0f);
+                    vertices[i + 2].texCoord = Vector2(0.0f, 0.0f);
+                    vertices[i + 3].texCoord = Vector2(1.0f, 0.0f);
+                }
+            }
         }
 
         bool ParticleSystem::updateParticleMesh()
         {
-            if (NodePtr parent = parentNode.lock())
+            if (hasParent)
             {
-                for (uint32_t counter = particleCount; counter > 0; --counter)
+                Vector2 offset;
+
+                if (positionType == ParticleDefinition::PositionType::RELATIVE)
                 {
-                    size_t i = counter - 1;
+                    offset = parentPosition;
+                }
 
-                    Vector2 position;
+                const float* positionX = particles.get(ParticleData::POSITION_X);
+                const float* positionY = particles.get(ParticleData::POSITION_Y);
+                const float* size = particles.get(ParticleData::SIZE);
+                const float* rotation = particles.get(ParticleData::ROTATION);
+                const float* colors[] = {
+                    particles.get(ParticleData::COLOR_RED),
+                    particles.get(ParticleData::COLOR_GREEN),
+                    particles.get(ParticleData::COLOR_BLUE),
+                    particles.get(ParticleData::COLOR_ALPHA)
+                };
+
+                const simd::Float4 zero = simd::set(0.0f);
+                const simd::Float4 half = simd::set(0.5f);
+                const simd::Float4 colorMax = simd::set(255.0f);
+                const simd::Float4 toRadians = simd::set(-degToRad(1.0f));
+                const simd::Float4 offsetX = simd::set(offset.x);
+                const simd::Float4 offsetY = simd::set(offset.y);
+
+                alignas(16) float x[4];
+                alignas(16) float y[4];
+                alignas(16) float u[4];
+                alignas(16) float w[4];
+                alignas(16) float color[4][4];
+
+                for (uint32_t first = 0; first < particleCount; first += 4)
+                {
+                    // the quad corners are (w, -u), (u, w), (-u, -w) and (-w, u) relative to the particle position
+                    simd::Float4 sinR;
+                    simd::Float4 cosR;
+                    simd::sinCos(simd::mul(simd::load(rotation + first), toRadians), sinR, cosR);
 
-                    if (positionType == ParticleDefinition::PositionType::FREE)
+                    simd::Float4 halfSize = simd::mul(simd::load(size + first), half);
+                    simd::Float4 hc = simd::mul(halfSize, cosR);
+                    simd::Float4 hs = simd::mul(halfSize, sinR);
+
+                    simd::store(u, simd::add(hc, hs));
+                    simd::store(w, simd::sub(hs, hc));
+
+                    // grouped particles are drawn at the origin of the node, their positions only affect the bounding box
+                    if (positionType == ParticleDefinition::PositionType::GROUPED)
                     {
-                        position = particles[i].position;
+                        simd::store(x, zero);
+                        simd::store(y, zero);
                     }
-                    else if (positionType == ParticleDefinition::PositionType::RELATIVE)
+                    else
                     {
-                        position = parent->getPosition() + particles[i].position;
+                        simd::store(x, simd::add(simd::load(positionX + first), offsetX));
+                        simd::store(y, simd::add(simd::load(positionY + first), offsetY));
                     }
 
-                    float size_2 = particles[i].size / 2.0f;
-                    Vector2 v1(-size_2, -size_2);
-                    Vector2 v2(size_2, size_2);
+                    for (uint32_t channel = 0; channel < 4; ++channel)
+                    {
+                        simd::Float4 value = simd::mul(simd::load(colors[channel] + first), colorMax);
+                        simd::store(color[channel], simd::min(colorMax, simd::max(zero, value)));
+                    }
 
-                    float r = -degToRad(particles[i].rotation);
-                    float cr = cosf(r);
-                    float sr = sinf(r);
+                    uint32_t laneCount = std::min(4u, particleCount - first);
 
-                    Vector2 a(v1.x * cr - v1.y * sr, v1.x * sr + v1.y * cr);
-                    Vector2 b(v2.x * cr - v1.y * sr, v2.x * sr + v1.y * cr);
-                    Vector2 c(v2.x * cr - v2.y * sr, v2.x * sr + v2.y * cr);
-                    Vector2 d(v1.x * cr - v2.y * sr, v1.x * sr + v2.y * cr);
+                    for (uint32_t lane = 0; lane < laneCount; ++lane)
+                    {
+                        graphics::Color vertexColor(static_cast<uint8_t>(color[0][lane]),
+                                                    static_cast<uint8_t>(color[1][lane]),
+                                                    static_cast<uint8_t>(color[2][lane]),
+                                                    static_cast<uint8_t>(color[3][lane]));
 
-                    graphics::Color color(static_cast<uint8_t>(particles[i].colorRed * 255),
-                                       static_cast<uint8_t>(particles[i].colorGreen * 255),
-                                       static_cast<uint8_t>(particles[i].colorBlue * 255),
-                                       static_cast<uint8_t>(particles[i].colorAlpha * 255));
+                        graphics::VertexPCT* vertex = &vertices[(first + lane) * 4];
 
-                    vertices[i * 4 + 0].position = a + position;
-                    vertices[i * 4 + 0].color = color;
+                        vertex[0].position = Vector3(x[lane] + w[lane], y[lane] - u[lane], 0.0f);
+                        vertex[0].color = vertexColor;
 
-                    vertices[i * 4 + 1].position = b + position;
-                    vertices[i * 4 + 1].color = color;
+                        vertex[1].position = Vector3(x[lane] + u[lane], y[lane] + w[lane], 0.0f);
+                        vertex[1].color = vertexColor;
 
-                    vertices[i * 4 + 2].position = d + position;
-                    vertices[i * 4 + 2].color = color;
+                        vertex[2].position = Vector3(x[lane] - u[lane], y[lane] - w[lane], 0.0f);
+                        vertex[2].color = vertexColor;
 
-                    vertices[i * 4 + 3].position = c + position;
-                    vertices[i * 4 + 3].color = color;
+                        vertex[3].position = Vector3(x[lane] - w[lane], y[lane] + u[lane], 0.0f);
+                        vertex[3].color = vertexColor;
+                    }
                 }
 
-                if (!mesh->uploadVertices(vertices.data(), static_cast<uint32_t>(vertices.size())))
+                if (!mesh->uploadVertices(vertices.data(), particleCount * 4))
                 {
                     return false;
                 }
+
+                return true;
             }
 
-            return true;
+            return false;
         }
 
         void ParticleSystem::emitParticles(uint32_t count)
         {
-            if (particleCount + count > particleDefinition.maxParticles)
+            if (particleCount + count > maxParticles)
             {
-                count = particleDefinition.maxParticles - particleCount;
+                count = maxParticles - particleCount;
             }
 
             if (count)
             {
-                NodePtr parent = parentNode.lock();
+                reserveParticles(particleCount + count);
+
+                randomValues.resize(count * RANDOM_VALUES_PER_PARTICLE);
+                randomGenerator.fillSigned(randomValues.data(), static_cast<uint32_t>(randomValues.size()));
+                std::vector<float>::const_iterator randomValue = randomValues.begin();
 
-                if (parent)
+                if (hasParent)
                 {
                     Vector2 position;
 
                     if (positionType == ParticleDefinition::PositionType::FREE)
                     {
-                        position = parent->convertLocalToWorld(Vector2::ZERO);
+                        position = parentWorldPosition;
                     }
                     else if (positionType == ParticleDefinition::PositionType::RELATIVE)
                     {
-                        position = parent->convertLocalToWorld(Vector2::ZERO) - parent->getPosition();
+                        position = parentWorldPosition - parentPosition;
                     }
 
+                    float* life = particles.get(ParticleData::LIFE);
+                    float* positionX = particles.get(ParticleData::POSITION_X);
+                    float* positionY = particles.get(ParticleData::POSITION_Y);
+                    float* colorRed = particles.get(ParticleData::COLOR_RED);
+                    float* colorGreen = particles.get(ParticleData::COLOR_GREEN);
+                    float* colorBlue = particles.get(ParticleData::COLOR_BLUE);
+                    float* colorAlpha = particles.get(ParticleData::COLOR_ALPHA);
+                    float* deltaColorRed = particles.get(ParticleData::DELTA_COLOR_RED);
+                    float* deltaColorGreen = particles.get(ParticleData::DELTA_COLOR_GREEN);
+                    float* deltaColorBlue = particles.get(ParticleData::DELTA_COLOR_BLUE);
+                    float* deltaColorAlpha = particles.get(ParticleData::DELTA_COLOR_ALPHA);
+                    float* size = particles.get(ParticleData::SIZE);
+                    float* deltaSize = particles.get(ParticleData::DELTA_SIZE);
+                    float* rotation = particles.get(ParticleData::ROTATION);
+                    float* deltaRotation = particles.get(ParticleData::DELTA_ROTATION);
+                    float* radialAcceleration = particles.get(ParticleData::RADIAL_ACCELERATION);
+                    float* tangentialAcceleration = particles.get(ParticleData::TANGENTIAL_ACCELERATION);
+                    float* directionX = particles.get(ParticleData::DIRECTION_X);
+                    float* directionY = particles.get(ParticleData::DIRECTION_Y);
+                    float* angle = particles.get(ParticleData::ANGLE);
+                    float* radius = particles.get(ParticleData::RADIUS);
+                    float* degreesPerSecond = particles.get(ParticleData::DEGREES_PER_SECOND);
+                    float* deltaRadius = particles.get(ParticleData::DELTA_RADIUS);
+
                     for (uint32_t i = particleCount; i < particleCount + count; ++i)
                     {
-                        if (particleDefinition.emitterType == ParticleDefinition::EmitterType::GRAVITY)
+                        if (particleDefinition->emitterType == ParticleDefinition::EmitterType::GRAVITY)
                         {
-                            particles[i].life = fmaxf(particleDefinition.particleLifespan + particleDefinition.particleLifespanVariance * randomf(-1.0f, 1.0f), 0.0f);
+                            life[i] = fmaxf(particleDefinition->particleLifespan + particleDefinition->particleLifespanVariance * *randomValue++, 0.0f);
 
-                            particles[i].position = particleDefinition.sourcePosition + position + Vector2(particleDefinition.sourcePositionVariance.x * randomf(-1.0f, 1.0f),
-                                                                                                             particleDefinition.sourcePositionVariance.y * randomf(-1.0f, 1.0f));
+                            positionX[i] = particleDefinition->sourcePosition.x + position.x + particleDefinition->sourcePositionVariance.x * *randomValue++;
+                            positionY[i] = particleDefinition->sourcePosition.y + position.y + particleDefinition->sourcePositionVariance.y * *randomValue++;
 
-                            particles[i].size = fmaxf(particleDefinition.startParticleSize + particleDefinition.startParticleSizeVariance * randomf(-1.0f, 1.0f), 0.0f);
+                            size[i] = fmaxf(particleDefinition->startParticleSize + particleDefinition->startParticleSizeVariance * *randomValue++, 0.0f);
 
-                            float finishSize = fmaxf(particleDefinition.finishParticleSize + particleDefinition.finishParticleSizeVariance * randomf(-1.0f, 1.0f), 0.0f);
-                            particles[i].deltaSize = (finishSize - particles[i].size) / particles[i].life;
+                            float finishSize = fmaxf(particleDefinition->finishParticleSize + particleDefinition->finishParticleSizeVariance * *randomValue++, 0.0f);
+                            deltaSize[i] = (finishSize - size[i]) / life[i];
 
-                            particles[i].colorRed = clamp(particleDefinition.startColorRed + particleDefinition.startColorRedVariance * randomf(-1.0f, 1.0f), 0.0f, 1.0f);
-                            particles[i].colorGreen = clamp(particleDefinition.startColorGreen + particleDefinition.startColorGreenVariance * randomf(-1.0f, 1.0f), 0.0f, 1.0f);
-                            particles[i].colorBlue = clamp(particleDefinition.startColorBlue + particleDefinition.startColorBlueVariance * randomf(-1.0f, 1.0f), 0.0f, 1.0f);
-                            particles[i].colorAlpha = clamp(particleDefinition.startColorAlpha + particleDefinition.startColorAlphaVariance * randomf(-1.0f, 1.0f), 0.0f, 1.0f);
+                            colorRed[i] = clamp(particleDefinition->startColorRed + particleDefinition->startColorRedVariance * *randomValue++, 0.0f, 1.0f);
+                            colorGreen[i] = clamp(particleDefinition->startColorGreen + particleDefinition->startColorGreenVariance * *randomValue++, 0.0f, 1.0f);
+                            colorBlue[i] = clamp(particleDefinition->startColorBlue + particleDefinition->startColorBlueVariance * *randomValue++, 0.0f, 1.0f);
+                            colorAlpha[i] = clamp(particleDefinition->startColorAlpha + particleDefinition->startColorAlphaVariance * *randomValue++, 0.0f, 1.0f);
 
-                            float finishColorRed = clamp(particleDefinition.finishColorRed + particleDefinition.finishColorRedVariance * randomf(-1.0f, 1.0f), 0.0f, 1.0f);
-                            float finishColorGreen = clamp(particleDefinition.finishColorGreen + particleDefinition.finishColorGreenVariance * randomf(-1.0f, 1.0f), 0.0f, 1.0f);
-                            float finishColorBlue = clamp(particleDefinition.finishColorBlue + particleDefinition.finishColorBlueVariance * randomf(-1.0f, 1.0f), 0.0f, 1.0f);
-                            float finishColorAlpha = clamp(particleDefinition.finishColorAlpha + particleDefinition.finishColorAlphaVariance * randomf(-1.0f, 1.0f), 0.0f, 1.0f);
+                            float finishColorRed = clamp(particleDefinition->finishColorRed + particleDefinition->finishColorRedVariance * *randomValue++, 0.0f, 1.0f);
+                            float finishColorGreen = clamp(particleDefinition->finishColorGreen + particleDefinition->finishColorGreenVariance * *randomValue++, 0.0f, 1.0f);
+                            float finishColorBlue = clamp(particleDefinition->finishColorBlue + particleDefinition->finishColorBlueVariance * *randomValue++, 0.0f, 1.0f);
+                            float finishColorAlpha = clamp(particleDefinition->finishColorAlpha + particleDefinition->finishColorAlphaVariance * *randomValue++, 0.0f, 1.0f);
 
-                            particles[i].deltaColorRed = (finishColorRed - particles[i].colorRed) / particles[i].life;
-                            particles[i].deltaColorGreen = (finishColorGreen - particles[i].colorGreen) / particles[i].life;
-                            particles[i].deltaColorBlue = (finishColorBlue - particles[i].colorBlue) / particles[i].life;
-                            particles[i].deltaColorAlpha = (finishColorAlpha - particles[i].colorAlpha) / particles[i].life;
+                            deltaColorRed[i] = (finishColorRed - colorRed[i]) / life[i];
+                            deltaColorGreen[i] = (finishColorGreen - colorGreen[i]) / life[i];
+                            deltaColorBlue[i] = (finishColorBlue - colorBlue[i]) / life[i];
+                            deltaColorAlpha[i] = (finishColorAlpha - colorAlpha[i]) / life[i];
 
                             //_particles[i].finishColor = finishColor;
 
-                            particles[i].rotation = particleDefinition.startRotation + particleDefinition.startRotationVariance * randomf(-1.0f, 1.0f);
+                            rotation[i] = particleDefinition->startRotation + particleDefinition->startRotationVariance * *randomValue++;
 
-                            float finishRotation = particleDefinition.finishRotation + particleDefinition.finishRotationVariance * randomf(-1.0f, 1.0f);
-                            particles[i].deltaRotation = (finishRotation - particles[i].rotation) / particles[i].life;
+                            float finishRotation = particleDefinition->finishRotation + particleDefinition->finishRotationVariance * *randomValue++;
+                            deltaRotation[i] = (finishRotation - rotation[i]) / life[i];
 
-                            particles[i].radialAcceleration = particleDefinition.radialAcceleration + particleDefinition.radialAcceleration * randomf(-1.0f, 1.0f);
-                            particles[i].tangentialAcceleration = particleDefinition.tangentialAcceleration + particleDefinition.tangentialAcceleration * randomf(-1.0f, 1.0f);
+                            radialAcceleration[i] = particleDefinition->radialAcceleration + particleDefinition->radialAcceleration * *randomValue++;
+                            tangentialAcceleration[i] = particleDefinition->tangentialAcceleration + particleDefinition->tangentialAcceleration * *randomValue++;
 
-                            if (particleDefinition.rotationIsDir)
+                            if (particleDefinition->rotationIsDir)
                             {
-                                float a = degToRad(particleDefinition.angle + particleDefinition.angleVariance * randomf(-1.0f, 1.0f));
+                                float a = degToRad(particleDefinition->angle + particleDefinition->angleVariance * *randomValue++);
                                 Vector2 v(cosf(a), sinf(a));
-                                float s = particleDefinition.speed + particleDefinition.speedVariance * randomf(-1.0f, 1.0f);
+                                float s = particleDefinition->speed + particleDefinition->speedVariance * *randomValue++;
                                 Vector2 dir = v * s;
-                                particles[i].direction = dir;
-                                particles[i].rotation = -radToDeg(dir.getAngle());
+                                directionX[i] = dir.x;
+                                directionY[i] = dir.y;
+                                rotation[i] = -radToDeg(dir.getAngle());
                             }
                             else
                             {
-                                float a = degToRad(particleDefinition.angle + particleDefinition.angleVariance * randomf(-1.0f, 1.0f));
+                                float a = degToRad(particleDefinition->angle + particleDefinition->angleVariance * *randomValue++);
                                 Vector2 v(cosf(a), sinf(a));
-                                float s = particleDefinition.speed + particleDefinition.speedVariance * randomf(-1.0f, 1.0f);
+                                float s = particleDefinition->speed + particleDefinition->speedVariance * *randomValue++;
                                 Vector2 dir = v * s;
-                                particles[i].direction = dir;
+                                directionX[i] = dir.x;
+                                directionY[i] = dir.y;
                             }
                         }
                         else
                         {
-                            particles[i].radius = particleDefinition.maxRadius + particleDefinition.maxRadiusVariance * randomf(-1.0f, 1.0f);
-                            particles[i].angle = degToRad(particleDefinition.angle + particleDefinition.angleVariance * randomf(-1.0f, 1.0f));
-                            particles[i].degreesPerSecond = degToRad(particleDefinition.rotatePerSecond + particleDefinition.rotatePerSecondVariance * randomf(-1.0f, 1.0f));
+                            radius[i] = particleDefinition->maxRadius + particleDefinition->maxRadiusVariance * *randomValue++;
+                            angle[i] = degToRad(particleDefinition->angle + particleDefinition->angleVariance * *randomValue++);
+                            degreesPerSecond[i] = degToRad(particleDefinition->rotatePerSecond + particleDefinition->rotatePerSecondVariance * *randomValue++);
 
-                            float endRadius = particleDefinition.minRadius + particleDefinition.minRadiusVariance * randomf(-1.0f, 1.0f);
-                            particles[i].deltaRadius = (endRadius - particles[i].radius) / particles[i].life;
+                            float endRadius = particleDefinition->minRadius + particleDefinition->minRadiusVariance * *randomValue++;
+                            deltaRadius[i] = (endRadius - radius[i]) / life[i];
                         }
                     }
 
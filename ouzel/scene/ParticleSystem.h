@@ -9,57 +9,81 @@
 #include <functional>
 #include "scene/Drawable.h"
 #include "utils/Types.h"
+#include "utils/Noncopyable.h"
+#include "utils/Random.h"
 #include "scene/ParticleDefinition.h"
 #include "math/Vector2.h"
+#include "math/Matrix4.h"
 #include "graphics/Color.h"
 #include "graphics/Vertex.h"
-#include "core/UpdateCallback.h"
 
 namespace ouzel
 {
     namespace scene
     {
         class SceneManager;
-
-        struct Particle
+        class ParticleManager;
+        class ParticleSystemPool;
+
+        /**
+         * Particle attributes stored as separate arrays (structure of arrays) for vectorized updates.
+         * Every array is 16-byte aligned and padded to a multiple of four elements.
+         */
+        class ParticleData: public Noncopyable
         {
-            float life = 0.0f;
-
-            Vector2 position;
-
-            float colorRed = 0.0f;
-            float colorGreen = 0.0f;
-            float colorBlue = 0.0f;
-            float colorAlpha = 0.0f;
-
-            float deltaColorRed = 0.0f;
-            float deltaColorGreen = 0.0f;
-            float deltaColorBlue = 0.0f;
-            float deltaColorAlpha = 0.0f;
-
-            float angle = 0.0f;
-            float speed = 0.0f;
-
-            float size = 0.0f;
-            float deltaSize = 0.0f;
-
-            float rotation = 0.0f;
-            float deltaRotation = 0.0f;
-
-            float radialAcceleration = 0.0f;
-            float tangentialAcceleration = 0.0f;
+        public:
+            enum Attribute
+            {
+                LIFE,
+                POSITION_X,
+                POSITION_Y,
+                COLOR_RED,
+                COLOR_GREEN,
+                COLOR_BLUE,
+                COLOR_ALPHA,
+                DELTA_COLOR_RED,
+                DELTA_COLOR_GREEN,
+                DELTA_COLOR_BLUE,
+                DELTA_COLOR_ALPHA,
+                SIZE,
+                DELTA_SIZE,
+                ROTATION,
+                DELTA_ROTATION,
+                RADIAL_ACCELERATION,
+                TANGENTIAL_ACCELERATION,
+                DIRECTION_X,
+                DIRECTION_Y,
+                ANGLE,
+                RADIUS,
+                DEGREES_PER_SECOND,
+                DELTA_RADIUS,
+                ATTRIBUTE_COUNT
+            };
+
+            ParticleData();
+
+            void resize(uint32_t newCapacity);
+            uint32_t getCapacity() const { return capacity; }
+
+            float* get(Attribute attribute) { return attributes[attribute]; }
+            const float* get(Attribute attribute) const { return attributes[attribute]; }
+
+            void move(uint32_t from, uint32_t to);
 
-            Vector2 direction;
-            float radius = 0.0f;
-            float degreesPerSecond = 0.0f;
-            float deltaRadius = 0.0f;
+        protected:
+            std::vector<float> storage;
+            float* attributes[ATTRIBUTE_COUNT];
+            uint32_t capacity = 0;
         };
 
         class ParticleSystem: public Drawable
         {
+            friend ParticleManager;
+            friend ParticleSystemPool;
         public:
             ParticleSystem();
             ParticleSystem(const std::string& filename);
+            ParticleSystem(const ParticleDefinitionPtr& newParticleDefinition);
             virtual ~ParticleSystem();
 
             virtual void draw(const Matrix4& projectionMatrix,
@@ -70,6 +94,9 @@ namespace ouzel
             virtual void update(float delta);
 
             virtual bool initFromFile(const std::string& filename);
+            virtual bool initFromDefinition(const ParticleDefinitionPtr& newParticleDefinition);
+
+            const ParticleDefinitionPtr& getParticleDefinition() const { return particleDefinition; }
 
             void resume();
             void stop();
@@ -78,31 +105,44 @@ namespace ouzel
             bool isRunning() const { return running; }
             bool isActive() const { return active; }
 
+            uint32_t getParticleCount() const { return particleCount; }
+
             void setPositionType(ParticleDefinition::PositionType newPositionType) { positionType = newPositionType; }
             ParticleDefinition::PositionType getPositionType() const { return positionType; }
 
             void setFinishHandler(const std::function<void()>& handler) { finishHandler = handler; }
 
+            // makes the emission deterministic, the generator is reseeded on every reset
+            void setRandomSeed(uint64_t seed);
+
         protected:
             bool createParticleMesh();
+            void reserveParticles(uint32_t count);
             bool updateParticleMesh();
 
+            // called on the update thread, the particle update must not access the parent node
+            void updateParentTransform();
+            void updateParticles(float delta); // called by worker tasks
+            void simulate(float delta);
+            void finishUpdate();
+            void deactivate(); // stops the system and removes it from the particle manager
             void emitParticles(uint32_t count);
 
-            ParticleDefinition particleDefinition;
+            // shared by all systems created from the same definition, must not be modified
+            ParticleDefinitionPtr particleDefinition;
             ParticleDefinition::PositionType positionType;
 
             graphics::ShaderPtr shader;
             graphics::BlendStatePtr blendState;
             graphics::TexturePtr texture;
 
-            std::vector<Particle> particles;
+            ParticleData particles;
 
             graphics::MeshBufferPtr mesh;
 
-            std::vector<uint16_t> indices;
             std::vector<graphics::VertexPCT> vertices;
 
+            uint32_t maxParticles = 0;
             uint32_t particleCount = 0;
 
             float emitCounter = 0.0f;
@@ -113,11 +153,22 @@ namespace ouzel
 
             bool needsMeshUpdate = false;
 
-            UpdateCallback updateCallback;
+            // set during the parallel update and handled in finishUpdate on the update thread
+            bool drawCommandsChanged = false;
+            bool finishPending = false;
 
             NodeWeakPtr parentNode;
+            bool hasParent = false;
+            Vector2 parentPosition;
+            Vector2 parentWorldPosition;
+            Matrix4 parentInverseTransform;
 
             std::function<void()> finishHandler;
+
+            Random randomGenerator;
+            uint64_t randomSeed = 0;
+            bool hasRandomSeed = false;
+            std::vector<float> randomValues;
         };
     } // namespace scene
 } // namespace ouzel
@@ -0,0 +1,100 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <algorithm>
+#include "ParticleSystemPool.h"
+#include "ParticleSystem.h"
+#include "core/Engine.h"
+#include "core/Cache.h"
+#include "utils/Utils.h"
+
+namespace ouzel
+{
+    namespace scene
+    {
+        ParticleSystemPool::ParticleSystemPool(const std::string& filename):
+            particleDefinition(sharedEngine->getCache()->getParticleDefinition(filename))
+        {
+            if (!particleDefinition)
+            {
+                log("Failed to load particle definition %s", filename.c_str());
+            }
+        }
+
+        ParticleSystemPool::ParticleSystemPool(const ParticleDefinitionPtr& newParticleDefinition):
+            particleDefinition(newParticleDefinition)
+        {
+        }
+
+        void ParticleSystemPool::prewarm(uint32_t count)
+        {
+            while (particleSystems.size() < count)
+            {
+                if (!create())
+                {
+                    break;
+                }
+            }
+        }
+
+        ParticleSystemPtr ParticleSystemPool::get()
+        {
+            ParticleSystemPtr result;
+
+            for (const ParticleSystemPtr& particleSystem : particleSystems)
+            {
+                // only referenced by the pool
+                if (particleSystem.use_count() == 1)
+                {
+                    result = particleSystem;
+                    break;
+                }
+            }
+
+            if (result)
+            {
+                result->reset();
+                result->setPositionType(particleDefinition->positionType);
+                result->setFinishHandler(std::function<void()>());
+            }
+            else
+            {
+                result = create();
+            }
+
+            if (!result)
+            {
+                return nullptr;
+            }
+
+            result->resume();
+
+            // the returned pointer owns a reference of the pooled one, when the last copy of it is released
+            // the particle system is deactivated, so that the particle manager does not update it while it waits in the pool
+            return ParticleSystemPtr(result.get(), [result](ParticleSystem* particleSystem) {
+                particleSystem->deactivate();
+            });
+        }
+
+        void ParticleSystemPool::trim()
+        {
+            particleSystems.erase(std::remove_if(particleSystems.begin(), particleSystems.end(), [](const ParticleSystemPtr& particleSystem) {
+                return particleSystem.use_count() == 1;
+            }), particleSystems.end());
+        }
+
+        ParticleSystemPtr ParticleSystemPool::create()
+        {
+            ParticleSystemPtr particleSystem = std::make_shared<ParticleSystem>();
+
+            if (!particleSystem->initFromDefinition(particleDefinition))
+            {
+                return nullptr;
+            }
+
+            particleSystems.push_back(particleSystem);
+
+            return particleSystem;
+        }
+    } // namespace scene
+} // namespace ouzel
@@ -0,0 +1,45 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "utils/Types.h"
+#include "utils/Noncopyable.h"
+
+namespace ouzel
+{
+    namespace scene
+    {
+        /**
+         * Recycles particle systems of one definition.
+         * A particle system returns to the pool when nothing else references it anymore
+         * (e.g. after it was removed from its node), it is stopped and removed from the particle manager then.
+         */
+        class ParticleSystemPool: public Noncopyable
+        {
+        public:
+            ParticleSystemPool(const std::string& filename);
+            ParticleSystemPool(const ParticleDefinitionPtr& newParticleDefinition);
+
+            // creates particle systems until the pool holds at least count of them
+            void prewarm(uint32_t count);
+
+            // returns a running particle system, either a recycled or a new one
+            ParticleSystemPtr get();
+
+            // releases the particle systems that are not in use
+            void trim();
+
+            uint32_t getSize() const { return static_cast<uint32_t>(particleSystems.size()); }
+            const ParticleDefinitionPtr& getParticleDefinition() const { return particleDefinition; }
+
+        protected:
+            ParticleSystemPtr create();
+
+            ParticleDefinitionPtr particleDefinition;
+            std::vector<ParticleSystemPtr> particleSystems;
+        };
+    } // namespace scene
+} // namespace ouzel
@@ -6,6 +6,7 @@
 #include "Layer.h"
 #include "Camera.h"
 #include "core/Engine.h"
+#include "core/WorkerPool.h"
 
 namespace ouzel
 {
@@ -27,9 +28,27 @@ namespace ouzel
                 return a->getOrder() > b->getOrder();
             });
 
-            for (LayerPtr layer : layers)
+            // layers record their draw commands in parallel, they are added to the renderer in layer order
+            std::vector<std::function<void()>> tasks;
+
+            for (const LayerPtr& layer : layers)
             {
-                layer->draw();
+                tasks.push_back([layer]() { layer->draw(); });
+            }
+
+            sharedEngine->getWorkerPool()->run(tasks);
+
+            for (const LayerPtr& layer : layers)
+            {
+                if (layer->drawCommandCaching)
+                {
+                    // keep the commands for the next frames
+                    sharedEngine->getRenderer()->addDrawCommands(layer->drawCommands);
+                }
+                else
+                {
+                    sharedEngine->getRenderer()->addDrawCommands(std::move(layer->drawCommands));
+                }
             }
         }
 
@@ -79,6 +98,14 @@ namespace ouzel
             }
         }
 
+        void Scene::releaseBitmaps()
+        {
+            for (const LayerPtr& layer : layers)
+            {
+                layer->releaseBitmaps();
+            }
+        }
+
         NodePtr Scene::pickNode(const Vector2& position) const
         {
             for (std::list<LayerPtr>::const_reverse_iterator i = layers.rbegin(); i != layers.rend(); ++i)
@@ -31,6 +31,7 @@ namespace ouzel
             const std::list<LayerPtr>& getLayers() const { return layers; }
 
             virtual void recalculateProjection();
+            virtual void releaseBitmaps();
 
             NodePtr pickNode(const Vector2& position) const;
             std::set<NodePtr> pickNodes(const std::vector<Vector2>& edges) const;
@@ -4,6 +4,7 @@
 #include "SceneManager.h"
 #include "Scene.h"
 #include "core/Engine.h"
+#include "core/Cache.h"
 #include "Node.h"
 
 namespace ouzel
@@ -12,10 +13,11 @@ namespace ouzel
     {
         SceneManager::SceneManager()
         {
-            sharedEngine->getEventDispatcher()->addEventHandler(eventHandler);
             eventHandler.windowHandler = std::bind(&SceneManager::handleWindow, this, std::placeholders::_1, std::placeholders::_2);
+            eventHandler.systemHandler = std::bind(&SceneManager::handleSystem, this, std::placeholders::_1, std::placeholders::_2);
             eventHandler.mouseHandler = std::bind(&SceneManager::handleMouse, this, std::placeholders::_1, std::placeholders::_2);
             eventHandler.touchHandler = std::bind(&SceneManager::handleTouch, this, std::placeholders::_1, std::placeholders::_2);
+            sharedEngine->getEventDispatcher()->addEventHandler(eventHandler);
         }
 
         SceneManager::~SceneManager()
@@ -63,6 +65,22 @@ namespace ouzel
             return true;
         }
 
+        bool SceneManager::handleSystem(Event::Type type, const SystemEvent&)
+        {
+            if (type == Event::Type::LOW_MEMORY)
+            {
+                if (scene)
+                {
+                    scene->releaseBitmaps();
+                }
+
+                sharedEngine->getRenderer()->releaseUnusedRenderTargets();
+                sharedEngine->getCache()->releaseUnusedSoundData();
+            }
+
+            return true;
+        }
+
         bool SceneManager::handleMouse(Event::Type type, const MouseEvent& event)
         {
             if (scene)
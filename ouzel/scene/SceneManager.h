@@ -34,6 +34,7 @@ namespace ouzel
         protected:
             SceneManager();
             bool handleWindow(Event::Type type, const WindowEvent& event);
+            bool handleSystem(Event::Type type, const SystemEvent& event);
             bool handleMouse(Event::Type type, const MouseEvent& event);
             bool handleTouch(Event::Type type, const TouchEvent& event);
 
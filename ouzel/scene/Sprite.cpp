@@ -4,6 +4,7 @@
 #include <rapidjson/rapidjson.h>
 #include <rapidjson/filereadstream.h>
 #include <rapidjson/document.h>
+#include <cmath>
 #include "Sprite.h"
 #include "core/CompileConfig.h"
 #include "core/Engine.h"
@@ -24,6 +25,7 @@ namespace ouzel
         Sprite::Sprite()
         {
             updateCallback.callback = std::bind(&Sprite::update, this, std::placeholders::_1);
+            updateCallback.name = "Sprite";
         }
 
         Sprite::Sprite(const std::vector<SpriteFramePtr>& spriteFrames):
@@ -50,6 +52,8 @@ namespace ouzel
 
             frames = spriteFrames;
 
+            invalidateDrawCommands();
+
             for (const SpriteFramePtr& frame : frames)
             {
                 boundingBox.insertPoint(frame->getRectangle().bottomLeft());
@@ -91,6 +95,8 @@ namespace ouzel
 
             frames = sharedEngine->getCache()->getSpriteFrames(filename, mipmaps);
 
+            invalidateDrawCommands();
+
             for (const SpriteFramePtr& frame : frames)
             {
                 boundingBox.insertPoint(frame->getRectangle().bottomLeft());
@@ -126,10 +132,22 @@ namespace ouzel
 
         void Sprite::update(float delta)
         {
+            if (!applyUpdatePolicy(delta))
+            {
+                return;
+            }
+
             if (playing)
             {
+                uint32_t previousFrame = currentFrame;
                 timeSinceLastFrame += delta;
 
+                // skip whole loops after fast forwarding
+                if (repeat && !frames.empty())
+                {
+                    timeSinceLastFrame = fmodf(timeSinceLastFrame, fabsf(frameInterval) * static_cast<float>(frames.size()));
+                }
+
                 while (timeSinceLastFrame > fabsf(frameInterval))
                 {
                     timeSinceLastFrame -= fabsf(frameInterval);
@@ -171,6 +189,11 @@ namespace ouzel
                         }
                     }
                 }
+
+                if (currentFrame != previousFrame)
+                {
+                    invalidateDrawCommands();
+                }
             }
         }
 
@@ -209,6 +232,8 @@ namespace ouzel
         void Sprite::setShader(const graphics::ShaderPtr& newShader)
         {
             shader = newShader;
+
+            invalidateDrawCommands();
         }
 
         void Sprite::play(bool pRepeat, float newFrameInterval)
@@ -244,6 +269,8 @@ namespace ouzel
                 }
 
                 sharedEngine->scheduleUpdate(updateCallback);
+
+                invalidateDrawCommands();
             }
         }
 
@@ -266,6 +293,8 @@ namespace ouzel
             playing = false;
             currentFrame = 0;
             timeSinceLastFrame = 0.0f;
+
+            invalidateDrawCommands();
         }
 
         void Sprite::setCurrentFrame(uint32_t frame)
@@ -276,6 +305,8 @@ namespace ouzel
             {
                 currentFrame = static_cast<int32_t>(frames.size() - 1);
             }
+
+            invalidateDrawCommands();
         }
     } // namespace scene
 } // namespace ouzel
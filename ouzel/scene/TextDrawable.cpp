@@ -84,6 +84,7 @@ namespace ouzel
             if (text.empty())
             {
                 meshBuffer.reset();
+                invalidateDrawCommands();
             }
             else
             {
@@ -116,6 +117,8 @@ namespace ouzel
             {
                 boundingBox.insertPoint(Vector2(vertex.position.x, vertex.position.y));
             }
+
+            invalidateDrawCommands();
         }
     } // namespace scene
 } // namespace ouzel
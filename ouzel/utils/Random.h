@@ -0,0 +1,119 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+namespace ouzel
+{
+    /**
+     * Small and fast pseudo random number generator (xoshiro128**).
+     * Not thread-safe, use one instance per thread (see getThreadInstance) or per object.
+     */
+    class Random
+    {
+    public:
+        Random()
+        {
+            std::random_device device;
+            seed((static_cast<uint64_t>(device()) << 32) | device());
+        }
+
+        explicit Random(uint64_t newSeed)
+        {
+            seed(newSeed);
+        }
+
+        // the generator of the calling thread, seeded from std::random_device
+        static Random& getThreadInstance()
+        {
+            static thread_local Random instance;
+            return instance;
+        }
+
+        void seed(uint64_t newSeed)
+        {
+            // expand the seed with splitmix64, so that similar seeds give unrelated sequences
+            for (uint32_t i = 0; i < 4; i += 2)
+            {
+                newSeed += 0x9E3779B97F4A7C15ULL;
+                uint64_t z = newSeed;
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                z = z ^ (z >> 31);
+
+                state[i] = static_cast<uint32_t>(z);
+                state[i + 1] = static_cast<uint32_t>(z >> 32);
+            }
+        }
+
+        uint32_t next()
+        {
+            uint32_t result = rotateLeft(state[1] * 5, 7) * 9;
+            uint32_t t = state[1] << 9;
+
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+
+            state[2] ^= t;
+            state[3] = rotateLeft(state[3], 11);
+
+            return result;
+        }
+
+        uint64_t next64()
+        {
+            uint64_t high = next();
+            return (high << 32) | next();
+        }
+
+        // uniform integer in [min, max]
+        uint32_t nextUInt(uint32_t min, uint32_t max)
+        {
+            uint64_t range = static_cast<uint64_t>(max) - min + 1;
+            return min + static_cast<uint32_t>((next() * range) >> 32);
+        }
+
+        // uniform float in [0, 1)
+        float nextFloat()
+        {
+            return bitsToFloat((next() >> 9) | 0x3F800000) - 1.0f;
+        }
+
+        // uniform float in [min, max)
+        float nextFloat(float min, float max)
+        {
+            return min + nextFloat() * (max - min);
+        }
+
+        // fills result with uniform floats in [-1, 1)
+        void fillSigned(float* result, uint32_t count)
+        {
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                // [2, 4) - 3
+                result[i] = bitsToFloat((next() >> 9) | 0x40000000) - 3.0f;
+            }
+        }
+
+    protected:
+        static uint32_t rotateLeft(uint32_t x, int k)
+        {
+            return (x << k) | (x >> (32 - k));
+        }
+
+        static float bitsToFloat(uint32_t bits)
+        {
+            float result;
+            memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+        uint32_t state[4];
+    };
+}
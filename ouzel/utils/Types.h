@@ -23,6 +23,15 @@ namespace ouzel
     class Language;
     typedef std::shared_ptr<Language> LanguagePtr;
 
+    class WorkerPool;
+    typedef std::shared_ptr<WorkerPool> WorkerPoolPtr;
+
+    class TimerManager;
+    typedef std::shared_ptr<TimerManager> TimerManagerPtr;
+
+    class EventRecorder;
+    typedef std::shared_ptr<EventRecorder> EventRecorderPtr;
+
     namespace audio
     {
         class Audio;
@@ -33,6 +42,9 @@ namespace ouzel
 
         class SoundData;
         typedef std::shared_ptr<SoundData> SoundDataPtr;
+
+        class SoundStream;
+        typedef std::shared_ptr<SoundStream> SoundStreamPtr;
     }
 
     namespace graphics
@@ -114,6 +126,12 @@ namespace ouzel
         class ParticleSystem;
         typedef std::shared_ptr<ParticleSystem> ParticleSystemPtr;
 
+        class ParticleManager;
+        typedef std::shared_ptr<ParticleManager> ParticleManagerPtr;
+
+        class AnimationSystem;
+        typedef std::shared_ptr<AnimationSystem> AnimationSystemPtr;
+
         class DebugDrawable;
         typedef std::shared_ptr<DebugDrawable> DebugDrawablePtr;
 
@@ -136,6 +154,9 @@ namespace ouzel
         class Label;
         typedef std::shared_ptr<Label> LabelPtr;
 
+        class LatencyLabel;
+        typedef std::shared_ptr<LatencyLabel> LatencyLabelPtr;
+
         class Button;
         typedef std::shared_ptr<Button> ButtonPtr;
 
@@ -2,7 +2,6 @@
 // This file is part of the Ouzel engine.
 
 #include <cstdarg>
-#include <random>
 #include <chrono>
 #include "core/CompileConfig.h"
 
@@ -21,6 +20,7 @@
 #endif
 
 #include "Utils.h"
+#include "Random.h"
 
 namespace ouzel
 {
@@ -61,19 +61,13 @@ namespace ouzel
         return static_cast<uint64_t>(micros.count());
     }
 
-    static std::mt19937 engine(std::random_device{}());
-
     uint32_t random(uint32_t min, uint32_t max)
     {
-        return std::uniform_int_distribution<uint32_t>{min, max}(engine);
+        return Random::getThreadInstance().nextUInt(min, max);
     }
 
     float randomf(float min, float max)
     {
-        float diff = max - min;
-
-        float rand = static_cast<float>(engine()) / engine.max();
-
-        return rand * diff + min;
+        return Random::getThreadInstance().nextFloat(min, max);
     }
 }
@@ -1,9 +1,8 @@
 // Copyright (C) 2016 Elviss Strazdins
 // This file is part of the Ouzel engine.
 
+#include <chrono>
 #include "AudioXA2.h"
-#include "SoundDataXA2.h"
-#include "SoundXA2.h"
 #include "utils/Utils.h"
 
 namespace ouzel
@@ -11,12 +10,15 @@ namespace ouzel
     namespace audio
     {
         AudioXA2::AudioXA2():
-            Audio(Driver::XAUDIO2)
+            Audio(Driver::XAUDIO2), running(false)
         {
         }
 
         AudioXA2::~AudioXA2()
         {
+            stopThread();
+
+            if (sourceVoice) sourceVoice->DestroyVoice();
             if (masteringVoice) masteringVoice->DestroyVoice();
             if (xAudio) xAudio->Release();
         }
@@ -25,6 +27,14 @@ namespace ouzel
         {
             Audio::free();
 
+            stopThread();
+
+            if (sourceVoice)
+            {
+                sourceVoice->DestroyVoice();
+                sourceVoice = nullptr;
+            }
+
             if (masteringVoice)
             {
                 masteringVoice->DestroyVoice();
@@ -59,21 +69,101 @@ namespace ouzel
                 return false;
             }
 
+            // the mixed stream is played by one source voice
+            WAVEFORMATEX waveFormat;
+            waveFormat.wFormatTag = WAVE_FORMAT_IEEE_FLOAT;
+            waveFormat.nChannels = 2;
+            waveFormat.nSamplesPerSec = mixer.getSampleRate();
+            waveFormat.wBitsPerSample = sizeof(float) * 8;
+            waveFormat.nBlockAlign = waveFormat.nChannels * sizeof(float);
+            waveFormat.nAvgBytesPerSec = waveFormat.nSamplesPerSec * waveFormat.nBlockAlign;
+            waveFormat.cbSize = 0;
+
+            if (FAILED(xAudio->CreateSourceVoice(&sourceVoice, &waveFormat)))
+            {
+                log("Failed to create source voice");
+                return false;
+            }
+
+            for (std::vector<float>& buffer : buffers)
+            {
+                buffer.resize(BUFFER_FRAMES * 2);
+            }
+
+            for (uint32_t i = 0; i < BUFFER_COUNT; ++i)
+            {
+                if (!submitBuffer())
+                {
+                    return false;
+                }
+            }
+
+            if (FAILED(sourceVoice->Start()))
+            {
+                log("Failed to start consuming sound data");
+                return false;
+            }
+
+            running = true;
+            audioThread = std::thread(&AudioXA2::run, this);
+
             ready = true;
 
             return true;
         }
 
-        SoundDataPtr AudioXA2::createSoundData()
+        void AudioXA2::stopThread()
         {
-            SoundDataPtr soundData(new SoundDataXA2());
-            return soundData;
+            running = false;
+
+            if (audioThread.joinable())
+            {
+                audioThread.join();
+            }
         }
 
-        SoundPtr AudioXA2::createSound()
+        void AudioXA2::run()
         {
-            SoundPtr sound(new SoundXA2());
-            return sound;
+            while (running)
+            {
+                XAUDIO2_VOICE_STATE state;
+                sourceVoice->GetState(&state);
+
+                for (UINT32 queued = state.BuffersQueued; queued < BUFFER_COUNT; ++queued)
+                {
+                    submitBuffer();
+                }
+
+                // sleep for about a quarter of a buffer
+                std::this_thread::sleep_for(std::chrono::milliseconds(BUFFER_FRAMES * 250 / mixer.getSampleRate()));
+            }
+        }
+
+        bool AudioXA2::submitBuffer()
+        {
+            std::vector<float>& buffer = buffers[nextBuffer];
+            nextBuffer = (nextBuffer + 1) % BUFFER_COUNT;
+
+            mixer.process(buffer.data(), BUFFER_FRAMES);
+
+            XAUDIO2_BUFFER bufferData;
+            bufferData.Flags = 0;
+            bufferData.AudioBytes = static_cast<UINT32>(buffer.size() * sizeof(float));
+            bufferData.pAudioData = reinterpret_cast<const BYTE*>(buffer.data());
+            bufferData.PlayBegin = 0;
+            bufferData.PlayLength = 0;
+            bufferData.LoopBegin = 0;
+            bufferData.LoopLength = 0;
+            bufferData.LoopCount = 0;
+            bufferData.pContext = nullptr;
+
+            if (FAILED(sourceVoice->SubmitSourceBuffer(&bufferData)))
+            {
+                log("Failed to upload sound data");
+                return false;
+            }
+
+            return true;
         }
     } // namespace audio
 } // namespace ouzel
@@ -6,6 +6,9 @@
 #define NOMINMAX
 #include <xaudio2.h>
 
+#include <thread>
+#include <atomic>
+#include <vector>
 #include "audio/Audio.h"
 
 namespace ouzel
@@ -21,16 +24,27 @@ namespace ouzel
 
             virtual bool init() override;
 
-            virtual SoundDataPtr createSoundData() override;
-            virtual SoundPtr createSound() override;
-
             IXAudio2* getXAudio() const { return xAudio; }
 
         protected:
+            static const uint32_t BUFFER_COUNT = 3;
+            static const uint32_t BUFFER_FRAMES = 1024;
+
             AudioXA2();
 
+            void stopThread();
+            void run();
+            bool submitBuffer();
+
             IXAudio2* xAudio = nullptr;
             IXAudio2MasteringVoice* masteringVoice = nullptr;
+            IXAudio2SourceVoice* sourceVoice = nullptr;
+
+            std::vector<float> buffers[BUFFER_COUNT];
+            uint32_t nextBuffer = 0;
+
+            std::atomic<bool> running;
+            std::thread audioThread;
         };
     } // namespace audio
 } // namespace ouzel
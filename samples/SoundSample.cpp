@@ -25,17 +25,13 @@ SoundSample::SoundSample(Samples& pSamples):
     ambientButton->setPosition(Vector2(0.0f, -40.0f));
     layer->addChild(ambientButton);
 
-    audio::SoundDataPtr jumpData = sharedEngine->getAudio()->createSoundData();
-    jumpData->initFromFile("jump.wav");
-
     jumpSound = sharedEngine->getAudio()->createSound();
-    jumpSound->init(jumpData);
-
-    audio::SoundDataPtr ambientData = sharedEngine->getAudio()->createSoundData();
-    ambientData->initFromFile("ambient.wav");
+    jumpSound->init(sharedEngine->getCache()->getSoundData("jump.wav"));
 
     ambientSound = sharedEngine->getAudio()->createSound();
-    ambientSound->init(ambientData);
+    audio::SoundStreamPtr ambientStream = sharedEngine->getAudio()->createSoundStream();
+    ambientStream->initFromFile("ambient.wav");
+    ambientSound->init(ambientStream);
 
     scene::LayerPtr guiLayer = make_shared<scene::Layer>();
     guiLayer->setCamera(make_shared<scene::Camera>());
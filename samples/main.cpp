@@ -49,12 +49,55 @@ void ouzelMain(const std::vector<std::string>& args)
                 {
                     settings.driver = ouzel::graphics::Renderer::Driver::METAL;
                 }
+                else if (*nextArg == "empty")
+                {
+                    settings.driver = ouzel::graphics::Renderer::Driver::NONE;
+                }
             }
             else
             {
                 ouzel::log("No renderer specified");
             }
         }
+        else if (*arg == "-record")
+        {
+            auto nextArg = ++arg;
+
+            if (nextArg != args.end())
+            {
+                settings.recordFile = *nextArg;
+            }
+            else
+            {
+                ouzel::log("No record file specified");
+            }
+        }
+        else if (*arg == "-replay")
+        {
+            auto nextArg = ++arg;
+
+            if (nextArg != args.end())
+            {
+                settings.replayFile = *nextArg;
+            }
+            else
+            {
+                ouzel::log("No replay file specified");
+            }
+        }
+        else if (*arg == "-report")
+        {
+            auto nextArg = ++arg;
+
+            if (nextArg != args.end())
+            {
+                settings.reportFile = *nextArg;
+            }
+            else
+            {
+                ouzel::log("No report file specified");
+            }
+        }
         else
         {
             ouzel::log("Invalid argument \"%s\"", arg->c_str());
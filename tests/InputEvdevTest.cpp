@@ -0,0 +1,233 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <unistd.h>
+#include <gtest/gtest.h>
+#include "ouzel.h"
+#include "evdev/InputEvdev.h"
+// after the engine headers, its key code macros collide with the names of KeyboardKey and Event::Type
+#include <linux/input.h>
+#undef KEY_DOWN
+#undef KEY_UP
+
+using namespace ouzel;
+
+class TestInputEvdev: public input::InputEvdev
+{
+public:
+    TestInputEvdev(): input::InputEvdev(input::InputDeviceEvdev::CLASS_KEYBOARD |
+                                        input::InputDeviceEvdev::CLASS_MOUSE |
+                                        input::InputDeviceEvdev::CLASS_TOUCHPAD, false)
+    {
+    }
+
+    // a pipe can't set the clock of its timestamps, pretend it is monotonic like a real device
+    void setMonotonicClock()
+    {
+        std::lock_guard<std::mutex> lock(devicesMutex);
+
+        for (const auto& i : inputDevices)
+        {
+            i.second->monotonicClock = true;
+        }
+    }
+};
+
+// feeds input_event records through a pipe, which the evdev reader handles like a device node
+class InputEvdevTest: public testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        Settings settings;
+        settings.driver = graphics::Renderer::Driver::NONE;
+        engine.init(settings, []() {});
+
+        eventHandler.keyboardHandler = [this](Event::Type type, const KeyboardEvent& event) {
+            Event result;
+            result.type = type;
+            result.keyboardEvent = event;
+            events.push_back(result);
+            return true;
+        };
+
+        eventHandler.mouseHandler = [this](Event::Type type, const MouseEvent& event) {
+            Event result;
+            result.type = type;
+            result.mouseEvent = event;
+            events.push_back(result);
+            return true;
+        };
+
+        eventHandler.touchHandler = [this](Event::Type type, const TouchEvent& event) {
+            Event result;
+            result.type = type;
+            result.touchEvent = event;
+            events.push_back(result);
+            return true;
+        };
+
+        engine.getEventDispatcher()->addEventHandler(eventHandler);
+
+        inputEvdev.reset(new TestInputEvdev());
+        inputEvdev->update(); // starts the input thread
+        deviceCount = inputEvdev->getDeviceCount();
+    }
+
+    virtual void TearDown() override
+    {
+        if (writeFd != -1) close(writeFd);
+        inputEvdev.reset();
+        engine.getEventDispatcher()->removeEventHandler(eventHandler);
+    }
+
+    bool openDevice(uint32_t deviceClass)
+    {
+        int fds[2];
+        if (pipe(fds) == -1) return false;
+
+        writeFd = fds[1];
+        return inputEvdev->addDevice(fds[0], deviceClass, "pipe");
+    }
+
+    void write(uint16_t type, uint16_t code, int32_t value, uint64_t timestamp = 0)
+    {
+        input_event event;
+        memset(&event, 0, sizeof(event));
+        event.time.tv_sec = static_cast<time_t>(timestamp / 1000000);
+        event.time.tv_usec = static_cast<suseconds_t>(timestamp % 1000000);
+        event.type = type;
+        event.code = code;
+        event.value = value;
+
+        ASSERT_EQ(::write(writeFd, &event, sizeof(event)), static_cast<ssize_t>(sizeof(event)));
+    }
+
+    void sync()
+    {
+        write(EV_SYN, SYN_REPORT, 0);
+    }
+
+    // dispatches the events queued by the input thread until the expected number has arrived or the time is out
+    bool waitForEvents(size_t count)
+    {
+        for (int i = 0; i < 1000 && events.size() < count; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            engine.getEventDispatcher()->update();
+        }
+
+        return events.size() == count;
+    }
+
+    Engine engine;
+    EventHandler eventHandler;
+    std::vector<Event> events;
+    std::unique_ptr<TestInputEvdev> inputEvdev;
+    uint32_t deviceCount = 0;
+    int writeFd = -1;
+};
+
+TEST_F(InputEvdevTest, KeyWithModifier)
+{
+    ASSERT_TRUE(openDevice(input::InputDeviceEvdev::CLASS_KEYBOARD));
+
+    write(EV_KEY, KEY_LEFTSHIFT, 1);
+    sync();
+    write(EV_KEY, KEY_SPACE, 1);
+    sync();
+    write(EV_KEY, KEY_SPACE, 0);
+    write(EV_KEY, KEY_LEFTSHIFT, 0);
+    sync();
+
+    ASSERT_TRUE(waitForEvents(4));
+
+    EXPECT_EQ(events[0].type, Event::Type::KEY_DOWN);
+    EXPECT_EQ(events[0].keyboardEvent.key, input::KeyboardKey::LSHIFT);
+    EXPECT_EQ(events[1].type, Event::Type::KEY_DOWN);
+    EXPECT_EQ(events[1].keyboardEvent.key, input::KeyboardKey::SPACE);
+    EXPECT_EQ(events[1].keyboardEvent.modifiers, static_cast<uint32_t>(SHIFT_DOWN));
+    EXPECT_EQ(events[2].type, Event::Type::KEY_UP);
+    EXPECT_EQ(events[2].keyboardEvent.key, input::KeyboardKey::SPACE);
+    EXPECT_EQ(events[2].keyboardEvent.modifiers, static_cast<uint32_t>(SHIFT_DOWN));
+    EXPECT_EQ(events[3].type, Event::Type::KEY_UP);
+    EXPECT_EQ(events[3].keyboardEvent.modifiers, 0u);
+}
+
+TEST_F(InputEvdevTest, KernelTimestamp)
+{
+    ASSERT_TRUE(openDevice(input::InputDeviceEvdev::CLASS_KEYBOARD));
+    inputEvdev->setMonotonicClock();
+
+    write(EV_KEY, KEY_SPACE, 1, 123000456);
+    write(EV_SYN, SYN_REPORT, 0, 123000456);
+
+    ASSERT_TRUE(waitForEvents(1));
+
+    // the last update delivered the event
+    const std::vector<uint64_t>& inputTimestamps = engine.getEventDispatcher()->getInputTimestamps();
+    ASSERT_EQ(inputTimestamps.size(), 1u);
+    EXPECT_EQ(inputTimestamps[0], 123000456u);
+}
+
+TEST_F(InputEvdevTest, MouseButton)
+{
+    ASSERT_TRUE(openDevice(input::InputDeviceEvdev::CLASS_MOUSE));
+
+    write(EV_KEY, BTN_LEFT, 1);
+    sync();
+    write(EV_KEY, BTN_LEFT, 0);
+    sync();
+    write(EV_REL, REL_WHEEL, 1);
+    sync();
+
+    ASSERT_TRUE(waitForEvents(3));
+
+    EXPECT_EQ(events[0].type, Event::Type::MOUSE_DOWN);
+    EXPECT_EQ(events[0].mouseEvent.button, input::MouseButton::LEFT);
+    EXPECT_EQ(events[1].type, Event::Type::MOUSE_UP);
+    EXPECT_EQ(events[1].mouseEvent.button, input::MouseButton::LEFT);
+    EXPECT_EQ(events[2].type, Event::Type::MOUSE_SCROLL);
+    EXPECT_EQ(events[2].mouseEvent.scroll.y, 1.0f);
+}
+
+TEST_F(InputEvdevTest, SingleTouch)
+{
+    ASSERT_TRUE(openDevice(input::InputDeviceEvdev::CLASS_TOUCHPAD));
+
+    write(EV_KEY, BTN_TOUCH, 1);
+    write(EV_ABS, ABS_X, 10);
+    write(EV_ABS, ABS_Y, 10);
+    sync();
+    write(EV_ABS, ABS_X, 20);
+    sync();
+    write(EV_KEY, BTN_TOUCH, 0);
+    sync();
+
+    ASSERT_TRUE(waitForEvents(3));
+
+    EXPECT_EQ(events[0].type, Event::Type::TOUCH_BEGIN);
+    EXPECT_EQ(events[1].type, Event::Type::TOUCH_MOVE);
+    EXPECT_EQ(events[2].type, Event::Type::TOUCH_END);
+    EXPECT_EQ(events[0].touchEvent.touchId, events[2].touchEvent.touchId);
+}
+
+TEST_F(InputEvdevTest, RemoveOnEndOfFile)
+{
+    ASSERT_TRUE(openDevice(input::InputDeviceEvdev::CLASS_KEYBOARD));
+    EXPECT_EQ(inputEvdev->getDeviceCount(), deviceCount + 1);
+
+    close(writeFd);
+    writeFd = -1;
+
+    for (int i = 0; i < 1000 && inputEvdev->getDeviceCount() != deviceCount; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_EQ(inputEvdev->getDeviceCount(), deviceCount);
+}
@@ -0,0 +1,282 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include "math/MathUtils.h"
+#include "math/Matrix4.h"
+#include "math/Vector2.h"
+#include "math/Vector3.h"
+
+using namespace ouzel;
+
+// scalar implementations the SIMD paths of Matrix4 are compared with
+static bool scalarInvert(const Matrix4& matrix, Matrix4& dst)
+{
+    const float* m = matrix.m;
+
+    float a0 = m[0] * m[5] - m[1] * m[4];
+    float a1 = m[0] * m[6] - m[2] * m[4];
+    float a2 = m[0] * m[7] - m[3] * m[4];
+    float a3 = m[1] * m[6] - m[2] * m[5];
+    float a4 = m[1] * m[7] - m[3] * m[5];
+    float a5 = m[2] * m[7] - m[3] * m[6];
+    float b0 = m[8] * m[13] - m[9] * m[12];
+    float b1 = m[8] * m[14] - m[10] * m[12];
+    float b2 = m[8] * m[15] - m[11] * m[12];
+    float b3 = m[9] * m[14] - m[10] * m[13];
+    float b4 = m[9] * m[15] - m[11] * m[13];
+    float b5 = m[10] * m[15] - m[11] * m[14];
+
+    float det = a0 * b5 - a1 * b4 + a2 * b3 + a3 * b2 - a4 * b1 + a5 * b0;
+
+    if (fabs(det) <= TOLERANCE)
+    {
+        return false;
+    }
+
+    float inverse[16] = {
+        m[5] * b5 - m[6] * b4 + m[7] * b3,
+        -m[1] * b5 + m[2] * b4 - m[3] * b3,
+        m[13] * a5 - m[14] * a4 + m[15] * a3,
+        -m[9] * a5 + m[10] * a4 - m[11] * a3,
+
+        -m[4] * b5 + m[6] * b2 - m[7] * b1,
+        m[0] * b5 - m[2] * b2 + m[3] * b1,
+        -m[12] * a5 + m[14] * a2 - m[15] * a1,
+        m[8] * a5 - m[10] * a2 + m[11] * a1,
+
+        m[4] * b4 - m[5] * b2 + m[7] * b0,
+        -m[0] * b4 + m[1] * b2 - m[3] * b0,
+        m[12] * a4 - m[13] * a2 + m[15] * a0,
+        -m[8] * a4 + m[9] * a2 - m[11] * a0,
+
+        -m[4] * b3 + m[5] * b1 - m[6] * b0,
+        m[0] * b3 - m[1] * b1 + m[2] * b0,
+        -m[12] * a3 + m[13] * a1 - m[14] * a0,
+        m[8] * a3 - m[9] * a1 + m[10] * a0
+    };
+
+    for (int i = 0; i < 16; ++i)
+    {
+        dst.m[i] = inverse[i] / det;
+    }
+
+    return true;
+}
+
+static float maxAbs(const Matrix4& matrix)
+{
+    float result = 0.0f;
+
+    for (float value : matrix.m)
+    {
+        result = std::max(result, fabsf(value));
+    }
+
+    return result;
+}
+
+static Matrix4 randomMatrix(std::mt19937& generator, float range)
+{
+    std::uniform_real_distribution<float> distribution(-range, range);
+    Matrix4 result;
+
+    for (float& value : result.m)
+    {
+        value = distribution(generator);
+    }
+
+    return result;
+}
+
+// both inverses are compared with a tolerance relative to the condition of the matrix
+static void expectInverseMatchesScalar(const Matrix4& matrix)
+{
+    Matrix4 expected;
+    ASSERT_TRUE(scalarInvert(matrix, expected));
+
+    Matrix4 result;
+    ASSERT_TRUE(matrix.invert(result));
+
+    float inverseNorm = maxAbs(expected);
+    float tolerance = 1e-5f * maxAbs(matrix) * inverseNorm * inverseNorm + 1e-6f;
+
+    for (int i = 0; i < 16; ++i)
+    {
+        EXPECT_NEAR(result.m[i], expected.m[i], tolerance) << "element " << i;
+    }
+}
+
+TEST(Matrix4Test, InvertRandom)
+{
+    std::mt19937 generator(1);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        Matrix4 matrix = randomMatrix(generator, 10.0f);
+        expectInverseMatchesScalar(matrix);
+    }
+}
+
+TEST(Matrix4Test, InvertAffine)
+{
+    std::mt19937 generator(2);
+    std::uniform_real_distribution<float> distribution(-1000.0f, 1000.0f);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        Matrix4 rotation;
+        Matrix4::createRotationZ(distribution(generator), rotation);
+
+        Matrix4 scale;
+        Matrix4::createScale(distribution(generator) / 100.0f + 11.0f, distribution(generator) / 100.0f - 11.0f, 1.0f, scale);
+
+        Matrix4 translation;
+        Matrix4::createTranslation(distribution(generator), distribution(generator), 0.0f, translation);
+
+        expectInverseMatchesScalar(translation * rotation * scale);
+    }
+}
+
+TEST(Matrix4Test, InvertNearSingular)
+{
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<float> angle(-3.14f, 3.14f);
+
+    for (float smallest : { 1e-2f, 1e-3f, 1e-4f })
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            // rotations keep the other singular values at 1, so the condition number is 1 / smallest
+            Matrix4 rotation1;
+            Matrix4::createRotation(Vector3(angle(generator), angle(generator), angle(generator)), angle(generator), rotation1);
+            Matrix4 rotation2;
+            Matrix4::createRotation(Vector3(angle(generator), angle(generator), angle(generator)), angle(generator), rotation2);
+
+            Matrix4 scale;
+            Matrix4::createScale(1.0f, 1.0f, smallest, scale);
+
+            expectInverseMatchesScalar(rotation1 * scale * rotation2);
+        }
+    }
+}
+
+TEST(Matrix4Test, InvertSingular)
+{
+    std::mt19937 generator(4);
+    std::uniform_int_distribution<int> distribution(-8, 8);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        // small integers keep the determinant exact, so both paths have to see it as zero
+        Matrix4 matrix;
+
+        for (float& value : matrix.m)
+        {
+            value = static_cast<float>(distribution(generator));
+        }
+
+        int column = i % 4;
+        int other = (column + 1 + i / 4 % 3) % 4;
+
+        for (int row = 0; row < 4; ++row)
+        {
+            matrix.m[other * 4 + row] = matrix.m[column * 4 + row];
+        }
+
+        Matrix4 scalarResult;
+        Matrix4 result;
+        EXPECT_FALSE(scalarInvert(matrix, scalarResult));
+        EXPECT_FALSE(matrix.invert(result));
+    }
+}
+
+TEST(Matrix4Test, InvertInPlace)
+{
+    Matrix4 matrix;
+    Matrix4::createRotationZ(0.5f, matrix);
+    matrix.m[12] = 3.0f;
+    matrix.m[13] = -2.0f;
+
+    Matrix4 expected;
+    ASSERT_TRUE(scalarInvert(matrix, expected));
+    ASSERT_TRUE(matrix.invert());
+
+    for (int i = 0; i < 16; ++i)
+    {
+        EXPECT_NEAR(matrix.m[i], expected.m[i], 1e-5f);
+    }
+}
+
+TEST(Matrix4Test, TransformPoints)
+{
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+
+    // odd counts cover the remainder of unrolled or vectorized loops
+    for (uint32_t count : { 0u, 1u, 3u, 4u, 7u, 1000u })
+    {
+        Matrix4 matrix = randomMatrix(generator, 10.0f);
+        const float* m = matrix.m;
+
+        std::vector<Vector2> points2(count);
+        std::vector<Vector3> points3(count);
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            points2[i] = Vector2(distribution(generator), distribution(generator));
+            points3[i] = Vector3(distribution(generator), distribution(generator), distribution(generator));
+        }
+
+        std::vector<Vector2> result2(count);
+        std::vector<Vector3> result3(count);
+        std::vector<Vector3> vectorResult3(count);
+
+        matrix.transformPoints(points2.data(), result2.data(), count);
+        matrix.transformPoints(points3.data(), result3.data(), count);
+        matrix.transformVectors(points3.data(), vectorResult3.data(), count);
+
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const Vector2& p2 = points2[i];
+            EXPECT_NEAR(result2[i].x, p2.x * m[0] + p2.y * m[4] + m[12], 1e-3f);
+            EXPECT_NEAR(result2[i].y, p2.x * m[1] + p2.y * m[5] + m[13], 1e-3f);
+
+            const Vector3& p3 = points3[i];
+            EXPECT_NEAR(result3[i].x, p3.x * m[0] + p3.y * m[4] + p3.z * m[8] + m[12], 1e-3f);
+            EXPECT_NEAR(result3[i].y, p3.x * m[1] + p3.y * m[5] + p3.z * m[9] + m[13], 1e-3f);
+            EXPECT_NEAR(result3[i].z, p3.x * m[2] + p3.y * m[6] + p3.z * m[10] + m[14], 1e-3f);
+
+            EXPECT_NEAR(vectorResult3[i].x, p3.x * m[0] + p3.y * m[4] + p3.z * m[8], 1e-3f);
+            EXPECT_NEAR(vectorResult3[i].y, p3.x * m[1] + p3.y * m[5] + p3.z * m[9], 1e-3f);
+            EXPECT_NEAR(vectorResult3[i].z, p3.x * m[2] + p3.y * m[6] + p3.z * m[10], 1e-3f);
+        }
+    }
+}
+
+TEST(Matrix4Test, TransformPointsInPlace)
+{
+    Matrix4 matrix;
+    Matrix4::createTranslation(1.0f, 2.0f, 3.0f, matrix);
+
+    Vector3 points[] = { Vector3(1.0f, 1.0f, 1.0f), Vector3(-1.0f, 0.0f, 2.0f) };
+    matrix.transformPoints(points, points, 2);
+
+    EXPECT_FLOAT_EQ(points[0].x, 2.0f);
+    EXPECT_FLOAT_EQ(points[0].y, 3.0f);
+    EXPECT_FLOAT_EQ(points[0].z, 4.0f);
+    EXPECT_FLOAT_EQ(points[1].x, 0.0f);
+    EXPECT_FLOAT_EQ(points[1].y, 2.0f);
+    EXPECT_FLOAT_EQ(points[1].z, 5.0f);
+
+    Vector3 vectors[] = { Vector3(1.0f, 1.0f, 1.0f) };
+    matrix.transformVectors(vectors, vectors, 1);
+
+    EXPECT_FLOAT_EQ(vectors[0].x, 1.0f);
+    EXPECT_FLOAT_EQ(vectors[0].y, 1.0f);
+    EXPECT_FLOAT_EQ(vectors[0].z, 1.0f);
+}
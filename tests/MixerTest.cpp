@@ -0,0 +1,122 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <cmath>
+#include <cstdio>
+#include <chrono>
+#include <fstream>
+#include <thread>
+#include <gtest/gtest.h>
+#include "ouzel.h"
+
+using namespace ouzel;
+
+// exposes the decoder state, so that the test doesn't mix before the whole file is in the ring buffer
+class DecodedSoundStream: public audio::SoundStream
+{
+public:
+    bool isDecoded() const { return endOfStream; }
+};
+
+class MixerTest: public testing::Test
+{
+protected:
+    static const uint32_t FRAME_COUNT = 8000;
+
+    virtual void SetUp() override
+    {
+        Settings settings;
+        settings.driver = graphics::Renderer::Driver::NONE;
+        engine.init(settings, []() {});
+
+        // 16-bit stereo WAV with a different sine on each channel
+        std::vector<uint8_t> wave;
+        appendTag(wave, "RIFF");
+        append32(wave, 36 + FRAME_COUNT * 4);
+        appendTag(wave, "WAVE");
+        appendTag(wave, "fmt ");
+        append32(wave, 16);
+        append16(wave, 1); // PCM
+        append16(wave, 2);
+        append32(wave, 44100);
+        append32(wave, 44100 * 4);
+        append16(wave, 4);
+        append16(wave, 16);
+        appendTag(wave, "data");
+        append32(wave, FRAME_COUNT * 4);
+
+        for (uint32_t i = 0; i < FRAME_COUNT; ++i)
+        {
+            append16(wave, static_cast<uint16_t>(static_cast<int16_t>(10000.0f * sinf(i * 0.05f))));
+            append16(wave, static_cast<uint16_t>(static_cast<int16_t>(10000.0f * sinf(i * 0.03f))));
+        }
+
+        filename = engine.getFileSystem()->getTempDirectory() + FileSystem::DIRECTORY_SEPARATOR + "MixerTest.wav";
+        std::ofstream file(filename, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(wave.data()), static_cast<std::streamsize>(wave.size()));
+        file.close();
+
+        soundData = engine.getAudio()->createSoundData();
+        ASSERT_TRUE(soundData->initFromBuffer(wave));
+    }
+
+    virtual void TearDown() override
+    {
+        std::remove(filename.c_str());
+    }
+
+    static void appendTag(std::vector<uint8_t>& data, const char* tag)
+    {
+        data.insert(data.end(), tag, tag + 4);
+    }
+
+    static void append16(std::vector<uint8_t>& data, uint16_t value)
+    {
+        data.push_back(static_cast<uint8_t>(value));
+        data.push_back(static_cast<uint8_t>(value >> 8));
+    }
+
+    static void append32(std::vector<uint8_t>& data, uint32_t value)
+    {
+        append16(data, static_cast<uint16_t>(value));
+        append16(data, static_cast<uint16_t>(value >> 16));
+    }
+
+    Engine engine;
+    std::string filename;
+    audio::SoundDataPtr soundData;
+};
+
+TEST_F(MixerTest, StreamMatchesSoundData)
+{
+    std::shared_ptr<DecodedSoundStream> soundStream = std::make_shared<DecodedSoundStream>();
+    ASSERT_TRUE(soundStream->initFromFile(filename));
+
+    // the whole file fits in the ring buffer
+    for (uint32_t i = 0; i < 1000 && !soundStream->isDecoded(); ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_TRUE(soundStream->isDecoded());
+
+    // a pitch that doesn't divide the block into whole frames
+    const float pitch = 0.77f;
+    const uint32_t frames = 20 * audio::Mixer::BLOCK_SIZE;
+
+    audio::Mixer dataMixer(44100, 1);
+    audio::Mixer streamMixer(44100, 1);
+    dataMixer.play(soundData, false, 1.0f, pitch);
+    streamMixer.play(soundStream, 1.0f, pitch);
+
+    std::vector<float> dataOutput(frames * 2);
+    std::vector<float> streamOutput(frames * 2);
+    dataMixer.process(dataOutput.data(), frames);
+    streamMixer.process(streamOutput.data(), frames);
+
+    for (uint32_t i = 0; i < frames * 2; ++i)
+    {
+        ASSERT_NEAR(streamOutput[i], dataOutput[i], 1e-4f) << "sample " << i;
+    }
+
+    soundStream->free();
+}
@@ -0,0 +1,93 @@
+// Copyright (C) 2016 Elviss Strazdins
+// This file is part of the Ouzel engine.
+
+#include <gtest/gtest.h>
+#include "ouzel.h"
+
+using namespace ouzel;
+
+class ParticleSystemPoolTest: public testing::Test
+{
+protected:
+    virtual void SetUp() override
+    {
+        Settings settings;
+        settings.driver = graphics::Renderer::Driver::NONE;
+        engine.init(settings, []() {});
+
+        // the empty renderer doesn't load shaders or textures
+        engine.getCache()->setShader(graphics::SHADER_TEXTURE, engine.getRenderer()->createShader());
+        engine.getCache()->setTexture("particle.png", engine.getRenderer()->createTexture());
+
+        particleDefinition = std::make_shared<scene::ParticleDefinition>();
+        particleDefinition->textureFilename = "particle.png";
+    }
+
+    Engine engine;
+    scene::ParticleDefinitionPtr particleDefinition;
+};
+
+TEST_F(ParticleSystemPoolTest, ReleaseStopsSystem)
+{
+    scene::ParticleSystemPool pool(particleDefinition);
+
+    scene::ParticleSystemPtr particleSystem = pool.get();
+    ASSERT_TRUE(particleSystem);
+    EXPECT_TRUE(particleSystem->isRunning());
+
+    // the pool keeps the released system alive
+    scene::ParticleSystem* released = particleSystem.get();
+    particleSystem.reset();
+
+    EXPECT_EQ(pool.getSize(), 1u);
+    EXPECT_FALSE(released->isRunning());
+}
+
+TEST_F(ParticleSystemPoolTest, Recycle)
+{
+    scene::ParticleSystemPool pool(particleDefinition);
+
+    scene::ParticleSystemPtr first = pool.get();
+    scene::ParticleSystemPtr second = pool.get();
+    ASSERT_TRUE(first && second);
+    EXPECT_NE(first.get(), second.get());
+    EXPECT_EQ(pool.getSize(), 2u);
+
+    scene::ParticleSystem* released = first.get();
+    first.reset();
+
+    scene::ParticleSystemPtr recycled = pool.get();
+    EXPECT_EQ(recycled.get(), released);
+    EXPECT_TRUE(recycled->isRunning());
+    EXPECT_EQ(pool.getSize(), 2u);
+
+    recycled.reset();
+    second.reset();
+    pool.trim();
+    EXPECT_EQ(pool.getSize(), 0u);
+}
+
+TEST_F(ParticleSystemPoolTest, MaxParticlesLimit)
+{
+    const uint32_t maxParticles = scene::ParticleDefinition::MAX_PARTICLES;
+    particleDefinition->maxParticles = maxParticles + 1;
+    particleDefinition->particleLifespan = 10.0f;
+    particleDefinition->emissionRate = static_cast<float>(particleDefinition->maxParticles);
+
+    scene::ParticleSystemPtr particleSystem = std::make_shared<scene::ParticleSystem>(particleDefinition);
+    ASSERT_TRUE(particleSystem->isRunning());
+
+    // the particles are emitted at the node the system was drawn with
+    scene::LayerPtr layer = std::make_shared<scene::Layer>();
+    layer->setCamera(std::make_shared<scene::Camera>());
+    scene::NodePtr node = std::make_shared<scene::Node>();
+    node->addDrawable(particleSystem);
+    layer->addChild(node);
+    layer->draw();
+
+    particleSystem->update(2.0f);
+    EXPECT_EQ(particleSystem->getParticleCount(), maxParticles);
+
+    particleSystem->update(1.0f);
+    EXPECT_EQ(particleSystem->getParticleCount(), maxParticles);
+}